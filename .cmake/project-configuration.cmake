@@ -55,4 +55,9 @@ endif()
 if(TDSLITE_PROJECT_DEBUG_PRINT_ENABLED)
     message(STATUS "> [OPT] tdslite debug print enabled")
     add_compile_definitions(TDSL_DEBUG_PRINT_ENABLED=1)
-endif()
\ No newline at end of file
+endif()
+
+if(TDSLITE_PROJECT_ALLOCATION_STATS_ENABLED)
+    message(STATUS "> [OPT] tdslite allocation statistics enabled")
+    add_compile_definitions(TDSL_ALLOCATION_STATS_ENABLED=1)
+endif()
@@ -38,6 +38,7 @@ namespace tdsl { namespace net {
      * - read() function that can be called with `unsigned char* buf, unsigned long amount`
      *   * Transfers 'exactly' amount bytes to the 'buf'. 'buf' is guaranteed to have 'amount'
      *     bytes of space.
+     * - available() function that returns the amount of bytes ready to be read
      * - `stop()` function
      *
      * Also, the implementation depends on following global free functions as well:
@@ -121,6 +122,9 @@ namespace tdsl { namespace net {
                 return tdsl::unexpected(-99); // FIXME: proper error code
             }
 
+            // The delay before the next retry, without the jitter
+            tdsl::uint32_t backoff_ms = k_initial_retry_delay_ms;
+
             // Retry up to MAX_CONNECT_ATTEMPTS times.
             while (retries--) {
                 TDSL_DEBUG_PRINTLN("... attempting to connect to %s:%d, %d retries remaining ...",
@@ -135,7 +139,12 @@ namespace tdsl { namespace net {
                 }
 
                 TDSL_DEBUG_PRINTLN("... connection attempt failed (%d) ...", cr);
-                delay(this->conn_retry_delay_ms);
+                if (retries) {
+                    delay(jittered(backoff_ms));
+                    if (backoff_ms < this->conn_retry_delay_ms) {
+                        backoff_ms = backoff_ms * 2;
+                    }
+                }
             }
 
             // Reset the network buffer so it's ready to
@@ -163,7 +172,11 @@ namespace tdsl { namespace net {
          * (scatter-gather I/O)
          */
         TDSL_SYMBOL_VISIBLE void do_send(byte_view header, byte_view message) noexcept {
-            client.write(header.data(), header.size_bytes());
+            // The header is empty when the network layer has placed
+            // it in front of the message already
+            if (header.size_bytes()) {
+                client.write(header.data(), header.size_bytes());
+            }
             client.write(message.data(), message.size_bytes());
             client.flush();
         }
@@ -262,7 +275,7 @@ namespace tdsl { namespace net {
 
         TDSL_SYMBOL_VISIBLE auto do_recv(tdsl::uint32_t transfer_exactly) noexcept
             -> network_io_result {
-            auto writer          = this->network_buffer.get_writer();
+            auto writer          = this->network_buffer.get_writer(transfer_exactly);
             const auto rem_space = writer->remaining_bytes();
 
             if (transfer_exactly > rem_space) {
@@ -282,15 +295,131 @@ namespace tdsl { namespace net {
             return result;
         }
 
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read whatever is available in the client into @p dst_buf
+         *
+         * Waits until at least one byte is available.
+         *
+         * @param [in] dst_buf Destination buffer
+         *
+         * @return Amount of bytes read on success, negative error code otherwise
+         */
+        TDSL_SYMBOL_VISIBLE auto do_recv_some(byte_span dst_buf) noexcept -> network_io_result {
+            enum class errc : int
+            {
+                disconnected = -1,
+                timeout      = -2,
+            };
+
+            const tdsl::uint32_t poll_interval = 300,
+                                 timeout       = recv_timeout_ms ? recv_timeout_ms : 30000;
+
+            // When we should give up on trying to receive
+            const tdsl::uint32_t wait_till     = millis() + timeout;
+
+            for (;;) {
+                const auto available = client.available();
+                if (available > 0) {
+                    const auto amount =
+                        static_cast<tdsl::size_t>(available) < dst_buf.size_bytes()
+                            ? static_cast<tdsl::size_t>(available)
+                            : dst_buf.size_bytes();
+                    const auto read_amount = client.read(dst_buf.data(), amount);
+                    if (read_amount == 0) {
+                        TDSL_DEBUG_PRINTLN(
+                            "tdsl_netimpl_arduino::do_recv_some(...) -> ret 0, disconnected");
+                        do_disconnect();
+                        return tdsl::unexpected(static_cast<int>(errc::disconnected));
+                    }
+                    else if (read_amount > 0) {
+                        TDSL_TRACE_PRINTLN("tdsl_netimpl_arduino::do_recv_some(...) -> "
+                                           "received %d bytes",
+                                           read_amount);
+                        return static_cast<tdsl::size_t>(read_amount);
+                    }
+                }
+
+                const tdsl::uint32_t now = millis();
+                if (now >= wait_till) {
+                    TDSL_DEBUG_PRINTLN(
+                        "tdsl_netimpl_arduino::do_recv_some(...) -> error, time out!");
+                    this->on_recv_timeout();
+                    return tdsl::unexpected(static_cast<int>(errc::timeout));
+                }
+                // Do not oversleep short receive timeouts
+                delay((wait_till - now) < poll_interval ? (wait_till - now) : poll_interval);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Bound the time do_recv_some() waits for data to @p timeout_ms
+         * milliseconds (0 = the default, 30 seconds)
+         *
+         * @param [in] timeout_ms Receive timeout
+         */
+        TDSL_SYMBOL_VISIBLE void do_set_recv_timeout(tdsl::uint32_t timeout_ms) noexcept {
+            recv_timeout_ms = timeout_ms;
+        }
+
     private:
         // --------------------------------------------------------------------------------
 
+        /**
+         * The delay before the first retry (milliseconds). The delay is
+         * doubled after each failed attempt, up to conn_retry_delay_ms.
+         */
+        static constexpr tdsl::uint32_t k_initial_retry_delay_ms = {100};
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Cap @p backoff_ms to conn_retry_delay_ms and pick a random delay in
+         * [backoff_ms / 2, backoff_ms] range, so the devices that lost the
+         * connection at the same time do not retry in lockstep.
+         *
+         * @param [in] backoff_ms The backoff delay
+         */
+        inline TDSL_NODISCARD auto jittered(tdsl::uint32_t backoff_ms) noexcept
+            -> tdsl::uint32_t {
+            if (backoff_ms > this->conn_retry_delay_ms) {
+                backoff_ms = this->conn_retry_delay_ms;
+            }
+
+            if (jitter_state == 0) {
+                // The boot time varies between the devices
+                jitter_state = static_cast<tdsl::uint32_t>(millis()) ^ 0x9E3779B9;
+            }
+            // xorshift32
+            jitter_state ^= jitter_state << 13;
+            jitter_state ^= jitter_state >> 17;
+            jitter_state ^= jitter_state << 5;
+
+            const tdsl::uint32_t half = backoff_ms / 2;
+            return half + (jitter_state % (backoff_ms - half + 1));
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * The client instance. Any client type compatible with
          * arduino's EthernetClient interface will work with this
          * class.
          */
         EthernetClientType client;
+
+        /**
+         * The state of the retry delay jitter generator
+         */
+        tdsl::uint32_t jitter_state = {0};
+
+        /**
+         * Receive timeout override (0 = none)
+         */
+        tdsl::uint32_t recv_timeout_ms = {0};
     };
 }} // namespace tdsl::net
 
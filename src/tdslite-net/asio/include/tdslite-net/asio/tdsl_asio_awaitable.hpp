@@ -0,0 +1,185 @@
+/**
+ * ____________________________________________________
+ * C++20 coroutine adapters for the asynchronous
+ * tdsl_driver operations
+ *
+ * @file   tdsl_asio_awaitable.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_ASIO_AWAITABLE_HPP
+#define TDSL_NET_ASIO_AWAITABLE_HPP
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define TDSL_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef TDSL_HAS_COROUTINES
+
+#include <tdslite/detail/tdsl_driver.hpp>
+#include <tdslite-net/asio/tdsl_netimpl_asio_async.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace tdsl { namespace net {
+
+    /**
+     * Result of an awaited driver operation
+     *
+     * @tparam T Operation result type
+     */
+    template <typename T>
+    struct tdsl_async_result {
+        // 0 on success, the network implementation's error code otherwise
+        tdsl::int32_t error;
+        // The operation result (valid only if error is 0)
+        T result;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Awaitable that starts an asynchronous operation when awaited,
+     * and resumes the awaiting coroutine from the completion handler.
+     *
+     * The operation may complete before the initiating function returns
+     * (e.g. on parameter validation failure), in which case the coroutine
+     * is not suspended at all.
+     *
+     * @tparam Result Type of the value the completion is invoked with
+     * @tparam Initiator Callable with void(Completion) signature, that
+     *         starts the operation and arranges Completion to be invoked
+     *         with the Result.
+     */
+    template <typename Result, typename Initiator>
+    struct tdsl_awaitable {
+
+        explicit tdsl_awaitable(Initiator i) : initiate(std::move(i)) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            initiate([this](Result r) {
+                result.emplace(std::move(r));
+                if (state.exchange(e_state::completed) == e_state::suspended) {
+                    handle.resume();
+                }
+            });
+            // Do not suspend if the operation completed already
+            return not(state.exchange(e_state::suspended) == e_state::completed);
+        }
+
+        Result await_resume() {
+            return std::move(*result);
+        }
+
+    private:
+        enum class e_state
+        {
+            initiating,
+            suspended,
+            completed
+        };
+
+        Initiator initiate;
+        std::coroutine_handle<> handle = {};
+        std::atomic<e_state> state     = {e_state::initiating};
+        std::optional<Result> result   = {};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    template <typename Result, typename Initiator>
+    inline auto make_tdsl_awaitable(Initiator && initiator)
+        -> tdsl_awaitable<Result, std::decay_t<Initiator>> {
+        return tdsl_awaitable<Result, std::decay_t<Initiator>>{std::forward<Initiator>(initiator)};
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * co_await'able version of tdsl_driver::async_connect
+     *
+     * The parameters are consumed when the awaitable is co_await'ed, so
+     * @p params must be alive until then.
+     *
+     * @return e_driver_error_code
+     */
+    template <typename Driver, typename Params>
+    inline auto co_connect(Driver & driver, const Params & params) {
+        using result_type = typename Driver::e_driver_error_code;
+        return make_tdsl_awaitable<result_type>([&driver, &params](auto complete) {
+            driver.async_connect(params, [complete](result_type r) { complete(r); });
+        });
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * co_await'able version of tdsl_driver::async_execute_query
+     *
+     * The rows are delivered to @p row_callback while the coroutine
+     * is suspended.
+     *
+     * @return tdsl_async_result<sql_command_query_result>
+     */
+    template <typename Driver, typename T>
+    inline auto co_execute_query(Driver & driver, T command,
+                                 typename Driver::sql_command_row_callback row_callback,
+                                 void * uptr = nullptr) {
+        using query_result_type = typename Driver::sql_command_query_result;
+        using result_type       = tdsl_async_result<query_result_type>;
+        return make_tdsl_awaitable<result_type>(
+            [&driver, command, row_callback, uptr](auto complete) {
+                driver.async_execute_query(
+                    command, row_callback, uptr,
+                    [complete](tdsl::int32_t ec, const query_result_type & r) {
+                        complete(result_type{ec, r});
+                    });
+            });
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * co_await'able version of tdsl_driver::async_execute_rpc
+     *
+     * The rows are delivered to @p row_callback while the coroutine
+     * is suspended. @p params must be alive until the awaitable is co_await'ed.
+     *
+     * @return tdsl_async_result<sql_command_rpc_result>
+     */
+    template <typename Driver, typename T>
+    inline auto co_execute_rpc(Driver & driver, T command,
+                               tdsl::span<tdsl::detail::sql_parameter_binding> params,
+                               typename Driver::sql_command_rpc_mode mode,
+                               typename Driver::sql_command_row_callback row_callback,
+                               void * uptr = nullptr) {
+        using rpc_result_type = typename Driver::sql_command_rpc_result;
+        using result_type     = tdsl_async_result<rpc_result_type>;
+        return make_tdsl_awaitable<result_type>(
+            [&driver, command, params, mode, row_callback, uptr](auto complete) {
+                driver.async_execute_rpc(command, params, mode, row_callback, uptr,
+                                         [complete](tdsl::int32_t ec, rpc_result_type r) {
+                                             complete(result_type{ec, std::move(r)});
+                                         });
+            });
+    }
+
+}} // namespace tdsl::net
+
+#endif
+
+#endif
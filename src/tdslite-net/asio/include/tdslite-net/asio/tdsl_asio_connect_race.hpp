@@ -0,0 +1,222 @@
+/**
+ * ____________________________________________________
+ * Connection racing ("happy eyeballs") helpers of the
+ * boost::asio network implementation
+ *
+ * @file   tdsl_asio_connect_race.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_ASIO_CONNECT_RACE_HPP
+#define TDSL_NET_ASIO_CONNECT_RACE_HPP
+
+#include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_debug_print.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wnull-dereference"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#pragma GCC diagnostic pop
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace tdsl { namespace net { namespace detail {
+
+    /**
+     * Reorder @p endpoints so the address families alternate, starting with
+     * the family of the first endpoint (RFC 8305, section 4). The order of the
+     * endpoints within the same family is preserved.
+     */
+    inline void
+    interleave_address_families(std::vector<boost::asio::ip::tcp::endpoint> & endpoints) {
+        if (endpoints.empty()) {
+            return;
+        }
+        const bool first_v6 = endpoints.front().address().is_v6();
+        std::vector<boost::asio::ip::tcp::endpoint> primary, secondary;
+        for (const auto & ep : endpoints) {
+            (ep.address().is_v6() == first_v6 ? primary : secondary).push_back(ep);
+        }
+        endpoints.clear();
+        for (std::size_t i = 0; i < primary.size() || i < secondary.size(); i++) {
+            if (i < primary.size()) {
+                endpoints.push_back(primary [i]);
+            }
+            if (i < secondary.size()) {
+                endpoints.push_back(secondary [i]);
+            }
+        }
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Races connection attempts to a list of endpoints ("happy eyeballs")
+     *
+     * The attempts are started in order, each one @p attempt_delay after the
+     * previous one, or right after the previous one fails, whichever happens
+     * first. The first attempt that succeeds wins and the others are
+     * cancelled. This way, an unresponsive endpoint delays the connection
+     * by the attempt delay, instead of the connect timeout of the OS.
+     */
+    struct connect_race {
+        using io_context_t = boost::asio::io_context;
+        using timer_t      = boost::asio::steady_timer;
+        using endpoint_t   = boost::asio::ip::tcp::endpoint;
+        using tcp_socket_t = boost::asio::ip::tcp::socket;
+
+        connect_race(io_context_t & ctx, const std::vector<endpoint_t> & endpoints,
+                     std::chrono::milliseconds attempt_delay,
+                     std::chrono::milliseconds attempt_timeout) :
+            ctx(ctx), endpoints(endpoints), attempt_delay(attempt_delay),
+            attempt_timeout(attempt_timeout), stagger(ctx) {}
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Run the race to completion
+         *
+         * The race is abandoned if the io_context is stopped meanwhile.
+         *
+         * @returns The connected socket, nullptr if all attempts are failed
+         */
+        auto run() -> std::shared_ptr<tcp_socket_t> {
+            // A stopped io_context runs nothing until restarted
+            ctx.restart();
+            start_next();
+            // Drain all handlers, including the cancelled ones, since they refer to `this`.
+            while (outstanding) {
+                if (0 == ctx.run_one()) {
+                    TDSL_DEBUG_PRINT("connect_race::run() -> io_context is stopped, abandoning\n");
+                    abandon();
+                    ctx.restart();
+                }
+            }
+            if (abandoned || winner < 0) {
+                return nullptr;
+            }
+            return std::move(attempts [static_cast<std::size_t>(winner)].sock);
+        }
+
+    private:
+        struct attempt {
+            std::shared_ptr<tcp_socket_t> sock;
+            std::unique_ptr<timer_t> deadline;
+        };
+
+        // --------------------------------------------------------------------------------
+
+        void start_next() {
+            if (attempts.size() == endpoints.size()) {
+                return;
+            }
+
+            const std::size_t i = attempts.size();
+            attempts.push_back(attempt{std::make_shared<tcp_socket_t>(ctx), nullptr});
+            TDSL_DEBUG_PRINT("connect_race::start_next() -> attempting to connect %s:%u\n",
+                             endpoints [i].address().to_string().c_str(), endpoints [i].port());
+
+            outstanding++;
+            attempts [i].sock->async_connect(endpoints [i],
+                                             [this, i](const boost::system::error_code & ec) {
+                                                 outstanding--;
+                                                 on_attempt_done(i, ec);
+                                             });
+
+            if (attempt_timeout.count()) {
+                attempts [i].deadline.reset(new timer_t{ctx, attempt_timeout});
+                outstanding++;
+                attempts [i].deadline->async_wait([this, i](const boost::system::error_code & ec) {
+                    outstanding--;
+                    if (not ec) {
+                        // Timed out, the connect handler receives `operation_aborted`
+                        boost::system::error_code ignored;
+                        attempts [i].sock->close(ignored);
+                    }
+                });
+            }
+
+            if (attempts.size() < endpoints.size()) {
+                stagger.expires_after(attempt_delay);
+                outstanding++;
+                stagger.async_wait([this](const boost::system::error_code & ec) {
+                    outstanding--;
+                    if (not ec && winner < 0 && not abandoned) {
+                        start_next();
+                    }
+                });
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        void on_attempt_done(std::size_t i, const boost::system::error_code & ec) {
+            if (attempts [i].deadline) {
+                attempts [i].deadline->cancel();
+            }
+
+            if (winner >= 0 || abandoned) {
+                return;
+            }
+
+            boost::system::error_code ignored;
+            if (not ec) {
+                TDSL_DEBUG_PRINT("connect_race::on_attempt_done(...) -> connected to %s:%u\n",
+                                 endpoints [i].address().to_string().c_str(),
+                                 endpoints [i].port());
+                winner = static_cast<int>(i);
+                stagger.cancel();
+                for (std::size_t j = 0; j < attempts.size(); j++) {
+                    if (not(j == i)) {
+                        attempts [j].sock->close(ignored);
+                    }
+                }
+                return;
+            }
+
+            attempts [i].sock->close(ignored);
+            // Do not wait for the attempt delay to start the next one
+            stagger.cancel();
+            start_next();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Cancel every pending operation, so their handlers
+         * complete as soon as the io_context runs again
+         */
+        void abandon() {
+            abandoned = {true};
+            stagger.cancel();
+            boost::system::error_code ignored;
+            for (auto & a : attempts) {
+                a.sock->close(ignored);
+                if (a.deadline) {
+                    a.deadline->cancel();
+                }
+            }
+        }
+
+        io_context_t & ctx;
+        const std::vector<endpoint_t> & endpoints;
+        const std::chrono::milliseconds attempt_delay;
+        const std::chrono::milliseconds attempt_timeout;
+        timer_t stagger;
+        std::vector<attempt> attempts;
+        tdsl::size_t outstanding = {0};
+        int winner               = {-1};
+        bool abandoned           = {false};
+    };
+
+}}} // namespace tdsl::net::detail
+
+#endif
@@ -65,6 +65,41 @@ namespace tdsl { namespace net {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Set the timeout (milliseconds) of each connection attempt made by
+         * @ref do_connect. Zero leaves it to the OS. (default: 0)
+         *
+         * @param [in] timeout_ms Connect timeout per endpoint
+         */
+        TDSL_SYMBOL_VISIBLE void set_connect_timeout(tdsl::uint32_t timeout_ms) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Set the delay (milliseconds) between the starts of the connection
+         * attempts to the resolved endpoints. @ref do_connect starts the next
+         * attempt when the delay elapses or the current attempt fails, without
+         * abandoning the attempts in progress. The first connected endpoint is
+         * used. (default: 250)
+         *
+         * @param [in] delay_ms Connection attempt delay
+         */
+        TDSL_SYMBOL_VISIBLE void set_connection_attempt_delay(tdsl::uint32_t delay_ms) noexcept;
+
+        /**
+         * Set how long (milliseconds) the resolved endpoints of a host are
+         * reused by the subsequent @ref do_connect calls to the same host and
+         * port. Zero disables the cache. (default: 30000)
+         *
+         * When none of the cached endpoints accepts the connection, the
+         * host is resolved again.
+         *
+         * @param [in] ttl_ms Time-to-live of the cached endpoints
+         */
+        TDSL_SYMBOL_VISIBLE void set_resolve_cache_ttl(tdsl::uint32_t ttl_ms) noexcept;
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Disconnect the socket from the connected endpoint and destroy
          * the socket.
@@ -89,6 +124,18 @@ namespace tdsl { namespace net {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Send byte_views in @p bufs sequentially to the connected endpoint
+         * with a single write (scatter-gather I/O)
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -1 when the send is cancelled
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept;
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Read exactly @p exact_amount bytes from socket
          * into network buffer.
@@ -109,6 +156,27 @@ namespace tdsl { namespace net {
         TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_amount,
                                                       byte_span dst_buf);
 
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read whatever is available in the socket into @p dst_buf
+         *
+         * Blocks until at least one byte is available.
+         *
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv_some(byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Bound the time @ref do_recv_some waits for data to @p timeout_ms
+         * milliseconds. Zero waits indefinitely. (default: 0)
+         *
+         * @param [in] timeout_ms Receive timeout
+         */
+        TDSL_SYMBOL_VISIBLE void do_set_recv_timeout(tdsl::uint32_t timeout_ms) noexcept;
+
     private:
         // Underlying buffer
         static constexpr tdsl::uint32_t k_buffer_size = {16384};
@@ -118,6 +186,19 @@ namespace tdsl { namespace net {
         std::shared_ptr<void> io_context_work_guard{nullptr};
         std::shared_ptr<void> socket_handle{nullptr};
         std::shared_ptr<void> resolver{nullptr};
+        std::shared_ptr<void> resolve_cache{nullptr};
+
+        // Time-to-live of the resolve cache entry (milliseconds)
+        tdsl::uint32_t resolve_cache_ttl_ms{30000};
+
+        // Connect timeout of each endpoint (milliseconds, 0: OS default)
+        tdsl::uint32_t connect_timeout_ms{0};
+
+        // Delay between the starts of the connection attempts (milliseconds)
+        tdsl::uint32_t connection_attempt_delay_ms{250};
+
+        // Receive timeout of do_recv_some (milliseconds, 0: none)
+        tdsl::uint32_t recv_timeout_ms{0};
     };
 
 }} // namespace tdsl::net
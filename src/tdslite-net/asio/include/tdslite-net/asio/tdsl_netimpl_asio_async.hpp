@@ -0,0 +1,238 @@
+/**
+ * ____________________________________________________
+ * Asynchronous network implementation for tdslite
+ * using boost::asio.
+ *
+ * @file   tdsl_netimpl_asio_async.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_NETIMPL_ASIO_ASYNC_HPP
+#define TDSL_NET_NETIMPL_ASIO_ASYNC_HPP
+
+#include <tdslite-net/base/network_io_base.hpp>
+
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_expected.hpp>
+#include <tdslite/util/tdsl_buffer_object.hpp>
+
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace boost { namespace asio {
+    class io_context;
+}} // namespace boost::asio
+
+namespace tdsl { namespace net {
+
+    /**
+     * Asynchronous ASIO networking code for tdslite
+     *
+     * The implementation does not own an io_context. All asynchronous
+     * operations are performed on the io_context supplied by the caller,
+     * and the completion handlers are invoked from the thread(s) running it.
+     * This allows any number of connections to be served by a single thread.
+     *
+     * The synchronous contract functions (do_connect, do_send, ...) are
+     * implemented as well, so the blocking API of tdsl_driver remains usable.
+     *
+     * At most one asynchronous operation can be in flight at a time, and
+     * the object must outlive it.
+     */
+    struct tdsl_netimpl_asio_async : public network_io_base<tdsl_netimpl_asio_async> {
+
+        using network_io_base<tdsl_netimpl_asio_async>::network_io_result;
+
+        /**
+         * Completion handler type for the asynchronous operations.
+         *
+         * The argument is 0 on success, and the operation specific
+         * (negative) error code on failure.
+         */
+        using completion_handler_t = std::function<void(tdsl::int32_t)>;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Construct a new asynchronous asio network implementation
+         *
+         * @param [in] ctx The io_context to perform the I/O on. Must outlive the object.
+         */
+        TDSL_SYMBOL_VISIBLE explicit tdsl_netimpl_asio_async(boost::asio::io_context & ctx);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * D-tor
+         */
+        TDSL_SYMBOL_VISIBLE ~tdsl_netimpl_asio_async();
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to the target endpoint @p target : @p port (blocking)
+         *
+         * @param [in] target Hostname or IP
+         * @param [in] port Port number
+         *
+         * @returns true_type when connected
+         * @returns -1 when socket associated with network implementation is alive, call @ref
+         * do_disconnect first
+         * @returns -2 when resolve of @p target fails
+         * @returns -3 when connection to all of the resolved endpoints fails
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::expected<tdsl::traits::true_type, int>
+        do_connect(tdsl::char_view target, tdsl::uint16_t port);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Disconnect the socket from the connected endpoint and destroy
+         * the socket. Pending asynchronous operations are cancelled.
+         *
+         * @returns 0 if socket is disconnected and the class is ready for re-use
+         * @returns -1 if socket is not alive
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_disconnect() noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views @p header and @p message sequentially to the
+         * connected endpoint (blocking)
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -1 when the send is cancelled
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_send(byte_view header, byte_view message) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views in @p bufs sequentially to the connected endpoint
+         * with a single write (blocking)
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -1 when the send is cancelled
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_exactly bytes from socket
+         * into network buffer (blocking)
+         *
+         * @param [in] transfer_exactly Exact amount of bytes to read
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_exactly) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_amount bytes from socket
+         * into @p dst_buf (blocking)
+         *
+         * @param [in] transfer_amount Exact amount of bytes to read
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_amount,
+                                                      byte_span dst_buf);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read whatever is available in the socket into @p dst_buf (blocking)
+         *
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv_some(byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to the target endpoint @p target : @p port asynchronously
+         *
+         * The @p handler is invoked with:
+         *  0 when connected
+         * -1 when socket associated with network implementation is alive
+         * -2 when resolve of @p target fails
+         * -3 when connection to all of the resolved endpoints fails
+         *
+         * @param [in] target Hostname or IP (copied, need not outlive the call)
+         * @param [in] port Port number
+         * @param [in] handler Completion handler
+         */
+        TDSL_SYMBOL_VISIBLE void async_connect(tdsl::char_view target, tdsl::uint16_t port,
+                                               completion_handler_t handler);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send the message in the network buffer asynchronously, as
+         * one or more TDS packets of type @p mtype.
+         *
+         * The network buffer must not be modified until the @p handler
+         * is invoked with:
+         *  0 when the whole message is sent
+         * -1 when the send is cancelled
+         * -2 when the socket is disconnected due to a send error
+         *
+         * @param [in] mtype Message type
+         * @param [in] handler Completion handler
+         */
+        TDSL_SYMBOL_VISIBLE void async_send_tds_pdu(tdsl::detail::e_tds_message_type mtype,
+                                                    completion_handler_t handler);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Receive one, complete TDS PDU asynchronously
+         *
+         * The PDU is delivered to the packet data callback as the data
+         * arrives, from the io_context's thread. The @p handler is invoked with:
+         *  0 when the whole message is received
+         * -1 when the socket is disconnected due to a receive error
+         * -2 when the message is malformed
+         *
+         * @param [in] handler Completion handler
+         */
+        TDSL_SYMBOL_VISIBLE void async_receive_tds_pdu(completion_handler_t handler);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Drop the data in the network buffer, e.g. a prepared
+         * message that could not be sent.
+         */
+        TDSL_SYMBOL_VISIBLE void discard_network_buffer() noexcept;
+
+    private:
+        void async_send_next_batch(completion_handler_t handler);
+        void async_receive_next(completion_handler_t handler);
+        void on_receive_data(tdsl::size_t amount, const completion_handler_t & handler);
+
+        // Underlying buffer
+        static constexpr tdsl::uint32_t k_buffer_size = {16384};
+        std::vector<tdsl::uint8_t> underlying_buffer{std::vector<tdsl::uint8_t>(k_buffer_size)};
+        // The caller supplied io_context
+        boost::asio::io_context & io_context;
+        // Batch state of the asynchronous send in progress
+        tds_tx_batch tx_batch = {};
+        // Type-erased smart pointers to asio-specific stuff
+        std::shared_ptr<void> tx_buffers{nullptr};
+        std::shared_ptr<void> socket_handle{nullptr};
+        std::shared_ptr<void> resolver{nullptr};
+    };
+
+}} // namespace tdsl::net
+
+#endif
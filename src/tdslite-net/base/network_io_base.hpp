@@ -48,6 +48,8 @@ namespace tdsl {
         template <typename Implementation>
         struct network_io_base : private network_io_contract<Implementation> {
         private:
+            using contract_type = network_io_contract<Implementation>;
+
             inline Implementation & impl() noexcept {
                 return static_cast<Implementation &>(*this);
             }
@@ -77,6 +79,22 @@ namespace tdsl {
             using connection_state_callback_ctx =
                 callback<void, void (*)(/*user_ptr*/ void *, e_conection_state)>;
 
+            /**
+             * The outcome of the last receive
+             */
+            enum class e_receive_status : tdsl::int8_t
+            {
+                // The message is received completely
+                complete  = 0,
+                // The receive timeout elapsed, the receive can be resumed
+                timed_out = 1,
+                // The receive failed (e.g. disconnected)
+                failed    = -1
+            };
+
+            // Maximum amount of buffers passed to a single do_sendv() call
+            static constexpr tdsl::size_t k_max_sendv_buffers = 32;
+
             network_io_base() noexcept {
                 if (tds_packet_size <= 512) {
                     TDSL_ASSERT(0);
@@ -95,204 +113,44 @@ namespace tdsl {
                                                                    progmem_string_view> = true>
             TDSL_NODISCARD inline tdsl::expected<tdsl::traits::true_type, int>
             connect(T host, tdsl::uint16_t port) noexcept {
+                // Nothing of an interrupted receive of the previous
+                // connection is going to arrive on the new one.
+                abandon_receive();
                 return static_cast<Implementation &>(*this).do_connect(host, port);
             }
 
             /**
              * Receive one, complete TDS PDU.
+             *
+             * The PDU is delivered to the packet data callback in chunks, as
+             * the data arrives. The memory requirement is bounded by the size
+             * of the network buffer, so the TDS packets (and the messages) can
+             * be larger than the network buffer itself, as long as each token
+             * the parser needs in one piece (e.g. a ROW) fits into it.
+             *
+             * If the implementation provides do_recv_some(), the PDU is received
+             * in batched mode. Otherwise, exact reads are used.
              */
             tdsl::uint32_t do_receive_tds_pdu() noexcept {
                 TDSL_ASSERT_MSG(not(network_buffer.get_underlying_view().data() == nullptr),
                                 "The network implementation MUST initialize network_buffer prior "
                                 "any network I/O!");
-
-                /**
-                 * TDS packet data can span multiple TDS messages.
-                 * In such scenarios, each TDS message will have its
-                 * EOM flag set to false except the last TDS message
-                 * for the packet data.
-                 */
-                bool eom_flag                              = {false};
-
-                /**
-                 * The amount of successfully read TDS messages.
-                 * (for diagnostic purposes only)
-                 */
-                tdsl::uint32_t processed_tds_message_count = 0;
-
-                /**
-                 * The main TDS message receive loop.
-                 *
-                 * The loop is mildly stream-based, meaning it will not
-                 * wait for a whole TDS packet data to arrive before
-                 * delivering the data down to parsing, but it waits until
-                 * we have a complete TDS message before doing so.
-                 *
-                 * The downstream parsing code immediately parses the
-                 * tokens and fires the callback functions, which allows
-                 * us to discard the processed data from receive buffer
-                 * (e.g. a processed ROW token's data)
-                 */
-                do {
-                    // We're using a stack buffer to read TDS header
-                    // because we only need it to determine the amount of
-                    // bytes to expect in the message and whether the received
-                    // message is the final one. The downstream parser does
-                    // not need these information. Therefore, we only read
-                    // packet data into internal packet buffer of network
-                    // stack, which allows us to handle fragmented packets
-                    // more easily (no header data to remove from buffer)
-                    tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)] = {0};
-                    byte_span tds_hbuf_s{tds_hbuf};
-
-                    // We demand exactly `k_tds_hdr_len` bytes,even if the network
-                    // receive buffer has more available. This is done preventing
-                    // fragmented reads. When we read the header first, we know
-                    // exactly how many bytes we will need to read the whole message
-                    // so the second read call becomes a `read_exactly` call too,
-                    // which allows us to avoid dealing with fragmentation at TCP
-                    // level.
-                    impl().do_recv(tds_hbuf_s.size_bytes(), tds_hbuf_s);
-                    auto thdr_rdr = binary_reader<tdsl::endian::big>{tds_hbuf};
-
-                    // Type defines the type of message. Type is a 1-byte unsigned char.
-                    const tdsl::detail::e_tds_message_type message_type =
-                        static_cast<tdsl::detail::e_tds_message_type>(
-                            thdr_rdr.read<tdsl::uint8_t>());
-
-                    // Status is a bit field used to indicate the message state. Status is a 1-byte
-                    // unsigned char.
-                    const auto status = thdr_rdr.read_raw<tdsl::detail::tds_message_status>();
-                    // Length is the size of the packet including the 8 bytes in the packet header.
-                    // It is the number of bytes from the start of this header to the start of the
-                    // next packet header. Length is a 2-byte, unsigned short and is represented
-                    // in network byte order (big-endian). The Length value MUST be greater than
-                    // or equal to 512 bytes and smaller than or equal to 32,767 bytes. The default
-                    // value is 4,096 bytes. Starting with TDS 7.3, the Length MUST be the
-                    // negotiated packet size when sending a packet from client to server, unless it
-                    // is the last packet of a request (that is, the EOM bit in Status is ON) or the
-                    // client has not logged in.
-                    static constexpr auto k_max_length = 32767;
-                    const auto length                  = thdr_rdr.read<tdsl::uint16_t>();
-                    if (length < sizeof(detail::tds_header) || length > k_max_length) {
-                        TDSL_DEBUG_PRINTLN("invalid tds message length %u", length);
-                        // invalid length
-                        TDSL_ASSERT_MSG(0, "Invalid tds message length!");
-                        return processed_tds_message_count;
-                    }
-
-                    // Length field includes the header length too, so subtract it
-                    auto packet_data_size = length - sizeof(detail::tds_header);
-
-                    // (mgilor): Instead of trying to pull a complete TDS packet,
-                    // we can try to pull remaining space amount from the buffer.
-                    // this will deliberately
-                    // We might try to pull whatever we got in the buffer.
-
-                    // If we can't pull whole packet, try to pull whatever we can from the
-                    // network
-
-                    if (packet_data_size > network_buffer.get_writer()->remaining_bytes()) {
-                        TDSL_DEBUG_PRINTLN("Cannot fit complete message into network "
-                                           "buffer " TDSL_SIZET_FORMAT_SPECIFIER
-                                           " > " TDSL_SIZET_FORMAT_SPECIFIER " "
-                                           "will try partial pull",
-                                           packet_data_size,
-                                           network_buffer.get_writer()->remaining_bytes());
-                        do {
-                            if (network_buffer.get_writer()->remaining_bytes() == 0) {
-                                TDSL_DEBUG_PRINTLN("Cannot pull " TDSL_SIZET_FORMAT_SPECIFIER
-                                                   " byte(s) of data from network, network "
-                                                   "buffer exhausted!",
-                                                   packet_data_size);
-                                // There's no point keeping the data around, so reset the buffer
-                                network_buffer.get_writer()->reset();
-                                return processed_tds_message_count;
-                            }
-                            const auto recv_result =
-                                impl().do_recv(network_buffer.get_writer()->remaining_bytes());
-                            if (recv_result) {
-                                auto nmsg_rdr           = network_buffer.get_reader();
-                                const auto needed_bytes = packet_data_cb(message_type, *nmsg_rdr);
-                                (void) needed_bytes;
-                                packet_data_size -= recv_result.get();
-                            }
-                            else {
-                                TDSL_DEBUG_PRINTLN("Cannot receive " TDSL_SIZET_FORMAT_SPECIFIER
-                                                   " byte(s) of data from "
-                                                   "network, receive error %u ",
-                                                   packet_data_size, recv_result.error());
-                                // There's no point keeping the data around, so reset the buffer
-                                network_buffer.get_writer()->reset();
-                                return processed_tds_message_count;
-                            }
-                        } while (packet_data_size > network_buffer.get_writer()->remaining_bytes());
-                    }
-                    else {
-                        impl().do_recv(packet_data_size); // FIXME: Check for errors
-                                                          // This is a netbuf_reader instance.
-                        // Read operations on this will be committed
-                        // to underlying buffer on object destruction
-                        // e.g. nmsg_rdr.read(2) will cause 2 bytes from
-                        // the start of the underlying buffer to be removed
-                        auto nmsg_rdr = network_buffer.get_reader();
-
-                        // pass current buffer down
-                        if (not nmsg_rdr->has_bytes(packet_data_size)) {
-                            TDSL_DEBUG_PRINTLN(
-                                "network_io_base::do_receive_tds_pdu(...) -> error, receive buffer "
-                                "does not contain expected amount of bytes "
-                                "(" TDSL_SIZET_FORMAT_SPECIFIER " < " TDSL_SIZET_FORMAT_SPECIFIER
-                                ") ",
-                                nmsg_rdr->remaining_bytes(), packet_data_size);
-                            // this should not happen
-                            TDSL_ASSERT_MSG(
-                                0, "The receive buffer does not contain expected amount of "
-                                   "bytes, something is wrong!");
-                            return processed_tds_message_count;
-                        }
-
-                        // TODO: check if downstream consumed the message
-                        // TODO: Check if we got enough space to pull the next message
-                        const auto needed_bytes = packet_data_cb(message_type, *nmsg_rdr);
-                        if (needed_bytes) {
-                            TDSL_DEBUG_PRINTLN("network_impl_base::do_receive_tds_pdu(...) -> "
-                                               "packet_data_cb needs `%d` more bytes",
-                                               needed_bytes);
-                        }
-
-                        (void) needed_bytes;
-                    }
-
-                    eom_flag = status.end_of_message;
-                } while (processed_tds_message_count++, not eom_flag);
-
-                // NOTE: Sometimes, the message contains some parts that
-                // not yet be parsed, which results in parsing failure.
-                // The unparsed data remains in the receive buffer and
-                // affects the consequent responses' parsing. In such case
-                // it is for better to flush the receive buffer.
-                {
-                    auto rbuf_reader = network_buffer.get_reader();
-                    if (rbuf_reader->remaining_bytes()) {
-                        TDSL_DEBUG_PRINTLN("Although the EOM is received, receive buffer still "
-                                           "contains " TDSL_SIZET_FORMAT_SPECIFIER " bytes of "
-                                           "data which means packet handler failed to handle "
-                                           "all the data in the "
-                                           "message. Discarding the data.",
-                                           rbuf_reader->remaining_bytes());
-                        // Consume the remaining data
-                        rbuf_reader->advance(
-                            static_cast<tdsl::ssize_t>(rbuf_reader->remaining_bytes()));
-                    }
-                }
-                return processed_tds_message_count;
+                using has_recv_some =
+                    typename contract_type::template has_recv_some_member_fn<Implementation>;
+                return receive_tds_pdu_impl(
+                    traits::integral_constant<bool, has_recv_some::value>{});
             }
 
             /**
              * Send contents of the message buffer in one or more TDS PDU's,
              * depending on negotiated packet size.
              *
+             * If the implementation provides do_sendv(), all packets are
+             * submitted with a single scatter/gather write. Otherwise, each
+             * packet header is placed right in front of its payload inside
+             * the network buffer, so the header and the payload of a packet
+             * are sent with a single do_send() call.
+             *
              * @param [in] mtype The type of the message currently in
              *                   the network buffer
              */
@@ -300,33 +158,51 @@ namespace tdsl {
                 TDSL_ASSERT_MSG(not(network_buffer.get_underlying_view().data() == nullptr),
                                 "The network implementation MUST initialize network_buffer "
                                 "prior any network I/O!");
-                const int k_message_segmentation_size = (tds_packet_size - 8);
-                auto buf_rdr                          = network_buffer.get_reader();
-                auto fragment_count = (buf_rdr->remaining_bytes() / k_message_segmentation_size);
-                do {
-                    auto segment_size = buf_rdr->has_bytes(k_message_segmentation_size)
-                                            ? k_message_segmentation_size
-                                            : buf_rdr->remaining_bytes();
-                    auto segment      = buf_rdr->read(segment_size);
-                    const tdsl::uint16_t segsize_nbo = host_to_network(static_cast<tdsl::uint16_t>(
-                        segment.size_bytes() + sizeof(detail::tds_header)));
-                    const tdsl::uint8_t(&segsize_nbo_b) [2] =
-                        reinterpret_cast<const tdsl::uint8_t(&) [2]>(segsize_nbo);
+                using has_sendv =
+                    typename contract_type::template has_sendv_member_fn<Implementation>;
+                send_tds_pdu_impl(mtype, traits::integral_constant<bool, has_sendv::value>{});
+                // The message has overwritten the carried over data, if any
+                rx_carry = {0};
+            }
+
+            // --------------------------------------------------------------------------------
 
-                    const tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)] = {
-                        static_cast<tdsl::uint8_t>(mtype),
-                        static_cast<tdsl::uint8_t>(fragment_count == 0),
-                        segsize_nbo_b [0],
-                        segsize_nbo_b [1],
-                        0x00,
-                        0x00,
-                        0x00,
-                        0x00};
+            /**
+             * Send the complete TDS packets of the (partial) message in the
+             * network buffer, without the EOM bit. The rest of the message is
+             * kept in the network buffer, and sent by the next do_flush_tds_pdu()
+             * or do_send_tds_pdu() call, which completes the message.
+             *
+             * Allows streaming a message larger than the network buffer. Since
+             * TDS 7.3, every packet of a message but the last one must be of the
+             * negotiated packet size, so an incomplete packet is never sent here.
+             * Streaming therefore needs a network buffer that can hold a complete
+             * packet along with the bytes that are written next.
+             *
+             * @param [in] mtype The type of the message currently in
+             *                   the network buffer
+             */
+            void do_flush_tds_pdu(tdsl::detail::e_tds_message_type mtype) noexcept {
+                TDSL_ASSERT_MSG(not(network_buffer.get_underlying_view().data() == nullptr),
+                                "The network implementation MUST initialize network_buffer "
+                                "prior any network I/O!");
+                // The message overwrites the carried over data, if any
+                rx_carry                = {0};
+                // The consumed bytes are reclaimed by the next write
+                auto buf_rdr            = network_buffer.get_reader();
+                const auto segment_size = segmentation_size();
+                while (buf_rdr->has_bytes(segment_size)) {
+                    send_tds_packet(mtype, buf_rdr->read(segment_size));
+                }
+            }
 
-                    impl().do_send(byte_view{tds_hbuf}, segment);
-                } while (fragment_count--);
+            // --------------------------------------------------------------------------------
 
-                TDSL_ASSERT_MSG(not buf_rdr->has_bytes(1), "Send buffer must be empty after!");
+            /**
+             * Get the amount of bytes that can be appended to network buffer
+             */
+            inline TDSL_NODISCARD tdsl::size_t do_get_free_space() const noexcept {
+                return network_buffer.free_space();
             }
 
             // --------------------------------------------------------------------------------
@@ -354,6 +230,22 @@ namespace tdsl {
 
             // --------------------------------------------------------------------------------
 
+            /**
+             * Get a view of the bytes written to the network
+             * buffer since @p offset
+             *
+             * @param [in] offset Start offset
+             */
+            inline TDSL_NODISCARD auto do_get_written_bytes(tdsl::size_t offset) noexcept
+                -> tdsl::byte_view {
+                const auto end = do_get_write_offset();
+                TDSL_ASSERT(offset <= end);
+                return tdsl::byte_view{network_buffer.get_underlying_view().data() + offset,
+                                       end - offset};
+            }
+
+            // --------------------------------------------------------------------------------
+
             /**
              * Append @p data to network buffer,
              * starting from @p offset
@@ -385,15 +277,12 @@ namespace tdsl {
             /**
              * Update negotiated packet size
              *
+             * The packet size can be larger than the network buffer,
+             * since the incoming packets are received in chunks.
+             *
              * @param [in] value New packet size
              */
             TDSL_SYMBOL_VISIBLE inline void set_tds_packet_size(tdsl::uint16_t value) noexcept {
-                if (value > network_buffer.get_underlying_view().size_bytes()) {
-                    TDSL_ASSERT_MSG(false, "Negotiated packet size cannot be larger than the "
-                                           "network buffer itself!");
-                    TDSL_TRAP;
-                }
-
                 TDSL_DEBUG_PRINTLN(
                     "network_io_base::set_tds_packet_size(...) -> old [%u], new [%u]",
                     tds_packet_size, value);
@@ -405,7 +294,9 @@ namespace tdsl {
              * Set the conn retry count
              *
              * @param attempts Number of attempts
-             * @param delay_ms Delay between each attempt (millseconds)
+             * @param delay_ms Delay between each attempt (millseconds). Implementations
+             *                 that back off between the attempts use this as the
+             *                 upper bound of the delay.
              */
             inline void set_connection_timeout_params(tdsl::uint16_t attempts,
                                                       tdsl::uint16_t delay_ms) noexcept {
@@ -413,7 +304,978 @@ namespace tdsl {
                 conn_retry_delay_ms = delay_ms;
             }
 
+            /**
+             * Bound the time a receive waits for data from the server
+             *
+             * When the time elapses, the receive stops with e_receive_status::timed_out
+             * and the next do_receive_tds_pdu() call resumes it. Only effective on
+             * implementations that provide do_set_recv_timeout().
+             *
+             * @param [in] timeout_ms Timeout in milliseconds (0 = implementation default)
+             */
+            inline void set_receive_timeout(tdsl::uint32_t timeout_ms) noexcept {
+                using has_set_recv_timeout =
+                    typename contract_type::template has_set_recv_timeout_member_fn<
+                        Implementation>;
+                set_receive_timeout_impl(
+                    timeout_ms, traits::integral_constant<bool, has_set_recv_timeout::value>{});
+            }
+
+            /**
+             * The outcome of the last do_receive_tds_pdu() call
+             */
+            inline TDSL_NODISCARD auto receive_status() const noexcept -> e_receive_status {
+                return rx_status;
+            }
+
+            /**
+             * Drop the state of an interrupted receive, and the data in the network
+             * buffer. Used when the rest of the response is not going to be received
+             * (e.g. the connection is closed).
+             */
+            inline void abandon_receive() noexcept {
+                rx_status = e_receive_status::complete;
+                rx        = {};
+                rx_carry  = {0};
+                network_buffer.get_writer()->reset();
+            }
+
+            /**
+             * Send an ATTENTION message, asking the server to cancel the
+             * request in progress.
+             *
+             * The message consists of a packet header only and is sent right
+             * away, without touching the network buffer, so it can be sent while
+             * the response is being received. The server acknowledges the
+             * ATTENTION with a DONE token with the DONE_ATTN status bit set.
+             */
+            inline void send_attention() noexcept {
+                tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)];
+                make_tds_header(
+                    tds_hbuf, tdsl::detail::e_tds_message_type::attention_signal,
+                    static_cast<tdsl::uint8_t>(detail::e_tds_message_status::end_of_message), 0);
+                using has_sendv =
+                    typename contract_type::template has_sendv_member_fn<Implementation>;
+                send_attention_impl(tds_hbuf, traits::integral_constant<bool, has_sendv::value>{});
+            }
+
+            /**
+             * Ask the server to reset the session state before it executes the
+             * next request (SQL batch, RPC or transaction manager request).
+             *
+             * The reset is requested by setting the RESETCONNECTION bit in the
+             * status of the first packet of the request, so it costs no extra
+             * round trip. The server drops the temporary tables, rolls back the
+             * open transactions and restores the SET options, the database and
+             * the language to the values the session had after login.
+             *
+             * @param [in] keep_transaction Reset the session, but keep the open
+             *             transaction (RESETCONNECTIONSKIPTRAN)
+             */
+            inline void set_reset_connection(bool keep_transaction = false) noexcept {
+                using status_t  = tdsl::detail::e_tds_message_status;
+                tx_reset_status = static_cast<tdsl::uint8_t>(
+                    keep_transaction ? status_t::reset_connection_skip_tran
+                                     : status_t::reset_connection);
+            }
+
+            /**
+             * Whether a session reset is pending for the next request
+             */
+            inline TDSL_NODISCARD bool is_reset_connection_pending() const noexcept {
+                return not(tx_reset_status == 0);
+            }
+
+            /**
+             * Ask the server to discard the message being written.
+             *
+             * The IGNORE bit is set in the status of the last packet of the
+             * message, along with the EOM bit. The server ignores the whole
+             * message, including the packets already sent by do_flush_tds_pdu(),
+             * so a streamed message can be abandoned halfway.
+             */
+            inline void set_ignore_message() noexcept {
+                tx_ignore_message = {true};
+            }
+
+        protected:
+            /**
+             * Result of handing received data to the TDS PDU receiver
+             */
+            enum class e_rx_step : tdsl::int8_t
+            {
+                // More data is needed to complete the message
+                in_progress = 0,
+                // The message is received completely
+                complete    = 1,
+                // The message is malformed, receive is aborted
+                failed      = -1
+            };
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Packet headers and buffers for a vectored send of
+             * the message in the network buffer
+             */
+            struct tds_tx_batch {
+                static constexpr tdsl::size_t k_max_segments = k_max_sendv_buffers / 2;
+
+                tdsl::uint8_t tds_hbufs [k_max_segments][sizeof(detail::tds_header)] = {};
+                byte_view bufs [k_max_sendv_buffers]                                 = {};
+                tdsl::size_t buf_count                                               = {0};
+                tdsl::size_t remaining_segments                                      = {0};
+                tdsl::detail::e_tds_message_type message_type                        = {};
+
+                /**
+                 * The buffers of the current batch
+                 */
+                inline TDSL_NODISCARD auto buffers() const noexcept -> tdsl::span<const byte_view> {
+                    return tdsl::span<const byte_view>{bufs, buf_count};
+                }
+            };
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Start sending the message in the network buffer in batches
+             *
+             * @param [out] batch Batch state
+             * @param [in] mtype The type of the message in the network buffer
+             */
+            inline void begin_send_tds_pdu(tds_tx_batch & batch,
+                                           tdsl::detail::e_tds_message_type mtype) noexcept {
+                // The message overwrites the carried over data, if any
+                rx_carry                 = {0};
+                batch.buf_count          = {0};
+                batch.message_type       = mtype;
+                batch.remaining_segments = segment_count(network_buffer.unconsumed_bytes());
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Prepare the next batch of packets to send
+             *
+             * The payloads in @p batch refer to the network buffer, which
+             * MUST NOT be modified until the batch is sent.
+             *
+             * @param [in,out] batch Batch state
+             *
+             * @return true if a batch is prepared, false if the whole message is sent
+             */
+            inline TDSL_NODISCARD bool next_send_tds_pdu_batch(tds_tx_batch & batch) noexcept {
+                batch.buf_count = {0};
+                auto buf_rdr    = network_buffer.get_reader();
+                for (tdsl::size_t i = 0;
+                     i < tds_tx_batch::k_max_segments && batch.remaining_segments;
+                     i++, batch.remaining_segments--) {
+                    const auto segment_size = buf_rdr->has_bytes(segmentation_size())
+                                                  ? segmentation_size()
+                                                  : buf_rdr->remaining_bytes();
+                    const auto segment      = buf_rdr->read(segment_size);
+                    make_tds_header(batch.tds_hbufs [i], batch.message_type,
+                                    packet_status(batch.message_type,
+                                                  batch.remaining_segments == 1),
+                                    segment.size_bytes());
+                    batch.bufs [batch.buf_count++] = byte_view{batch.tds_hbufs [i]};
+                    batch.bufs [batch.buf_count++] = segment;
+                }
+                TDSL_ASSERT_MSG(batch.remaining_segments || not buf_rdr->has_bytes(1),
+                                "Send buffer must be empty after!");
+                return batch.buf_count > 0;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Start receiving a TDS PDU in push mode
+             *
+             * The receive is driven by the caller: read into the span
+             * returned by receive_tds_pdu_buffer(), then pass the amount
+             * of bytes read to on_tds_pdu_data(), until it reports that
+             * the message is complete.
+             */
+            inline void begin_receive_tds_pdu() noexcept {
+                rx = {};
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Get the buffer the next read should go into
+             *
+             * The span is the free space at the tail of the network buffer,
+             * and it is never empty. The reads never go past the end of a
+             * packet whose EOM bit is known to be set.
+             */
+            inline TDSL_NODISCARD auto receive_tds_pdu_buffer() noexcept -> byte_span {
+                if (not rx.discard && network_buffer.free_space() == 0 && rx.received_bytes) {
+                    // The buffer is full, but the parser has not seen
+                    // the latest chunk yet. Give it a chance to free
+                    // up some space before giving up.
+                    rx.needed_bytes   = deliver_packet_data(rx.packet_info.message_type);
+                    rx.received_bytes = {0};
+                }
+
+                if (network_buffer.free_space() == 0) {
+                    TDSL_DEBUG_PRINTLN("Network buffer exhausted (needed: %u)! Discarding "
+                                       "the message.",
+                                       rx.needed_bytes);
+                    // The parser cannot make progress with the data in
+                    // the buffer, so the current message is lost. The
+                    // rest of it is received and discarded to keep the
+                    // connection in sync.
+                    rx.discard = {true};
+                    network_buffer.get_writer()->reset();
+                }
+
+                // Do not read past the end of the message
+                auto read_size = network_buffer.free_space();
+                if (rx.eom && rx.packet_data_size < read_size) {
+                    read_size = rx.packet_data_size;
+                }
+
+                auto writer = network_buffer.get_writer(read_size);
+                return byte_span{writer->free_begin(), read_size};
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Process @p amount bytes read into the span returned by
+             * the last receive_tds_pdu_buffer() call.
+             *
+             * The TDS headers are parsed in place and stripped from the
+             * buffer, so the packet data of the consecutive packets becomes
+             * one contiguous stream for the parser. A header split between
+             * two reads is reassembled in the receive state. The bytes
+             * received after the end of the message are kept for the next
+             * receive (see take_carried_over_data()).
+             *
+             * @param [in] amount Amount of bytes read
+             *
+             * @return e_rx_step Receive progress
+             */
+            inline TDSL_NODISCARD auto on_tds_pdu_data(tdsl::size_t amount) noexcept
+                -> e_rx_step {
+                // Offset and size of the bytes received after the EOM
+                tdsl::size_t trailing_offset = {0};
+                tdsl::size_t trailing_size   = {0};
+                {
+                    // Do not compact, the data is at the tail
+                    auto writer               = network_buffer.get_writer(/*min_free_space=*/0);
+                    tdsl::uint8_t * const beg = writer->free_begin();
+                    tdsl::uint8_t * const end = beg + amount;
+                    // Packet data is moved down over the stripped headers
+                    // in a single pass, `src` is always ahead of `dst`.
+                    tdsl::uint8_t * src       = beg;
+                    tdsl::uint8_t * dst       = beg;
+
+                    while (src < end) {
+                        const auto avail = static_cast<tdsl::size_t>(end - src);
+                        if (rx.packet_data_size) {
+                            // Packet data
+                            const auto n =
+                                rx.packet_data_size < avail ? rx.packet_data_size : avail;
+                            if (not(dst == src)) {
+                                memmove(dst, src, n);
+                            }
+                            src += n;
+                            dst += n;
+                            rx.packet_data_size -= n;
+                            rx.received_bytes += n;
+                            if (rx.packet_data_size == 0) {
+                                rx.processed_tds_message_count++;
+                            }
+                            continue;
+                        }
+
+                        if (rx.eom) {
+                            // The rest belongs to the next message
+                            trailing_offset = static_cast<tdsl::size_t>(src - writer->data());
+                            trailing_size   = avail;
+                            break;
+                        }
+
+                        // TDS header, move it out of the network buffer
+                        const auto hdr_missing = sizeof(rx.tds_hbuf) - rx.tds_hbuf_len;
+                        const auto n           = hdr_missing < avail ? hdr_missing : avail;
+                        memcpy(rx.tds_hbuf + rx.tds_hbuf_len, src, n);
+                        src += n;
+                        rx.tds_hbuf_len += static_cast<tdsl::uint8_t>(n);
+
+                        if (rx.tds_hbuf_len == sizeof(rx.tds_hbuf)) {
+                            rx.tds_hbuf_len = {0};
+                            if (not parse_tds_header(rx.tds_hbuf, rx.packet_info)) {
+                                writer->reset();
+                                return e_rx_step::failed;
+                            }
+                            rx.packet_data_size = rx.packet_info.data_size;
+                            rx.eom              = rx.packet_info.status.end_of_message;
+                            if (rx.packet_data_size == 0) {
+                                rx.processed_tds_message_count++;
+                            }
+                        }
+                    }
+
+                    writer->advance(static_cast<tdsl::ssize_t>(dst - beg));
+
+                    if (rx.discard) {
+                        writer->reset();
+                        rx.received_bytes = {0};
+                    }
+                }
+
+                const bool last_chunk = rx.eom && rx.packet_data_size == 0;
+
+                // Do not bother the parser until the amount of bytes
+                // it asked for has arrived, unless this is the last
+                // chunk of the message.
+                if (not rx.discard &&
+                    (last_chunk || (rx.received_bytes && rx.received_bytes >= rx.needed_bytes))) {
+                    rx.needed_bytes   = deliver_packet_data(rx.packet_info.message_type);
+                    rx.received_bytes = {0};
+                }
+
+                if (not last_chunk) {
+                    return e_rx_step::in_progress;
+                }
+
+                discard_unconsumed_data();
+                carry_over_data(trailing_offset, trailing_size);
+                return e_rx_step::complete;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Claim the bytes the last receive got past the end of its message
+             *
+             * The bytes are at the beginning of the network buffer, right where
+             * the span returned by receive_tds_pdu_buffer() starts, so they can
+             * be passed to on_tds_pdu_data() as if they were just read.
+             *
+             * @return Amount of bytes carried over (0 if none)
+             */
+            inline TDSL_NODISCARD auto take_carried_over_data() noexcept -> tdsl::size_t {
+                const auto amount = rx_carry;
+                rx_carry          = {0};
+                if (amount && network_buffer.unconsumed_bytes()) {
+                    // The network buffer is written to since, so
+                    // the bytes are overwritten
+                    return 0;
+                }
+                return amount;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Amount of TDS packets received by the current (or the last) push mode receive
+             */
+            inline TDSL_NODISCARD auto received_tds_packet_count() const noexcept
+                -> tdsl::uint32_t {
+                return rx.processed_tds_message_count;
+            }
+
+
         private:
+            /**
+             * The information we need from a TDS packet header
+             */
+            struct tds_packet_info {
+                tdsl::detail::e_tds_message_type message_type = {};
+                tdsl::detail::tds_message_status status       = {};
+                tdsl::size_t data_size                        = {0};
+            };
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * State of a push mode TDS PDU receive
+             */
+            struct tds_rx_state {
+                // TDS header bytes received so far. A header might be split
+                // between two reads, so the partial header is kept here.
+                tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)] = {0};
+                tdsl::uint8_t tds_hbuf_len                           = {0};
+                // Whether the current packet is the last packet of the message
+                bool eom                                             = {false};
+                // True when the network buffer is exhausted. The rest of the
+                // message is received and discarded.
+                bool discard                                         = {false};
+                tds_packet_info packet_info                          = {};
+                // Remaining data size of the current packet
+                tdsl::size_t packet_data_size                        = {0};
+                // Amount of bytes received since the last delivery
+                tdsl::size_t received_bytes                          = {0};
+                // Amount of bytes the parser asked for in the last delivery
+                tdsl::uint32_t needed_bytes                          = {0};
+                tdsl::uint32_t processed_tds_message_count           = {0};
+            };
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Write the TDS packet header for a packet with
+             * @p payload_size bytes of data into @p tds_hbuf
+             *
+             * @param [out] tds_hbuf Header buffer
+             * @param [in] mtype Message type
+             * @param [in] status Packet status (see packet_status())
+             * @param [in] payload_size Packet data size
+             */
+            static inline void make_tds_header(tdsl::uint8_t * tds_hbuf,
+                                               tdsl::detail::e_tds_message_type mtype,
+                                               tdsl::uint8_t status,
+                                               tdsl::size_t payload_size) noexcept {
+                const tdsl::uint16_t segsize_nbo = host_to_network(
+                    static_cast<tdsl::uint16_t>(payload_size + sizeof(detail::tds_header)));
+                const tdsl::uint8_t(&segsize_nbo_b) [2] =
+                    reinterpret_cast<const tdsl::uint8_t(&) [2]>(segsize_nbo);
+
+                tds_hbuf [0] = static_cast<tdsl::uint8_t>(mtype);
+                tds_hbuf [1] = status;
+                tds_hbuf [2] = segsize_nbo_b [0];
+                tds_hbuf [3] = segsize_nbo_b [1];
+                tds_hbuf [4] = 0x00;
+                tds_hbuf [5] = 0x00;
+                tds_hbuf [6] = 0x00;
+                tds_hbuf [7] = 0x00;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Status byte of the next packet of a message of type @p mtype
+             *
+             * The pending session reset request, if any, is put into the
+             * first packet of the next request and cleared. The pending
+             * IGNORE request, if any, is put into the last packet.
+             *
+             * @param [in] mtype Message type
+             * @param [in] eom Whether the packet is the last packet of the message
+             */
+            inline TDSL_NODISCARD auto packet_status(tdsl::detail::e_tds_message_type mtype,
+                                                     bool eom) noexcept -> tdsl::uint8_t {
+                using mtype_t             = tdsl::detail::e_tds_message_type;
+                const bool is_request     = (mtype == mtype_t::sql_batch) ||
+                                        (mtype == mtype_t::rpc) ||
+                                        (mtype == mtype_t::transaction_manager_req);
+                const tdsl::uint8_t reset = is_request ? tx_reset_status : 0;
+                if (is_request) {
+                    tx_reset_status = {0};
+                }
+                const tdsl::uint8_t ignore =
+                    (eom && tx_ignore_message)
+                        ? static_cast<tdsl::uint8_t>(
+                              tdsl::detail::e_tds_message_status::ignore_this_event)
+                        : 0;
+                if (eom) {
+                    tx_ignore_message = {false};
+                }
+                return static_cast<tdsl::uint8_t>(eom) | ignore | reset;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Amount of TDS packets needed to send @p message_size bytes
+             */
+            inline TDSL_NODISCARD auto segment_count(tdsl::size_t message_size) const noexcept
+                -> tdsl::size_t {
+                const tdsl::size_t segment_size = segmentation_size();
+                // An empty message still needs a packet to carry the EOM
+                return message_size == 0 ? 1 : (message_size + segment_size - 1) / segment_size;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Maximum amount of packet data in a TDS packet
+             */
+            inline TDSL_NODISCARD auto segmentation_size() const noexcept -> tdsl::size_t {
+                return tds_packet_size - sizeof(detail::tds_header);
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Send @p payload as a non-final packet of a message of type @p mtype
+             */
+            inline void send_tds_packet(tdsl::detail::e_tds_message_type mtype,
+                                        byte_view payload) noexcept {
+                tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)];
+                make_tds_header(tds_hbuf, mtype, packet_status(mtype, /*eom=*/false),
+                                payload.size_bytes());
+                impl().do_send(byte_view{tds_hbuf}, payload);
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Send the message in the network buffer (vectored mode)
+             *
+             * The packet headers are built on the stack and submitted along
+             * with the payloads as a single scatter/gather write. Messages with
+             * more than `tds_tx_batch::k_max_segments` packets are sent in batches.
+             */
+            void send_tds_pdu_impl(tdsl::detail::e_tds_message_type mtype,
+                                   traits::true_type /*has_sendv*/) noexcept {
+                tds_tx_batch batch{};
+                begin_send_tds_pdu(batch, mtype);
+                while (next_send_tds_pdu_batch(batch)) {
+                    impl().do_sendv(batch.buffers());
+                }
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Send the message in the network buffer (coalescing mode)
+             *
+             * The payload is moved forward by the size of a TDS header to make
+             * room for the first packet's header. The headers of the following
+             * packets overwrite the last bytes of the previous packet's payload,
+             * which are already sent by then. This way, every packet goes out
+             * with a single do_send() call.
+             */
+            void send_tds_pdu_impl(tdsl::detail::e_tds_message_type mtype,
+                                   traits::false_type /*has_sendv*/) noexcept {
+                constexpr auto k_hdr_size = sizeof(detail::tds_header);
+                auto writer               = network_buffer.get_writer();
+                const auto message_size   = writer->offset();
+                auto remaining_count      = segment_count(message_size);
+
+                // Where the header of the next packet goes. The packet
+                // data follows the header.
+                tdsl::uint8_t * packet    = writer->data();
+
+                if (writer->has_bytes(k_hdr_size)) {
+                    memmove(writer->data() + k_hdr_size, writer->data(), message_size);
+                    writer->advance(static_cast<tdsl::ssize_t>(k_hdr_size));
+                }
+                else {
+                    // No room for the first header, send it separately
+                    tdsl::uint8_t tds_hbuf [k_hdr_size];
+                    const auto segment_size =
+                        message_size < segmentation_size() ? message_size : segmentation_size();
+                    make_tds_header(tds_hbuf, mtype, packet_status(mtype, remaining_count == 1),
+                                    segment_size);
+                    impl().do_send(byte_view{tds_hbuf}, byte_view{writer->data(), segment_size});
+                    packet += segment_size - k_hdr_size;
+                    remaining_count--;
+                }
+
+                for (; remaining_count; remaining_count--) {
+                    const auto remaining_payload =
+                        static_cast<tdsl::size_t>(writer->current() - packet) - k_hdr_size;
+                    const auto segment_size = remaining_payload < segmentation_size()
+                                                  ? remaining_payload
+                                                  : segmentation_size();
+                    make_tds_header(packet, mtype, packet_status(mtype, remaining_count == 1),
+                                    segment_size);
+                    impl().do_send(byte_view{}, byte_view{packet, segment_size + k_hdr_size});
+                    packet += segment_size;
+                }
+
+                writer->reset();
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Receive one, complete TDS PDU (exact mode)
+             *
+             * Each TDS header is read into a stack buffer with an exact read,
+             * followed by exact reads for the packet data.
+             */
+            tdsl::uint32_t receive_tds_pdu_impl(traits::false_type /*has_recv_some*/) noexcept {
+                rx_status = e_receive_status::failed;
+
+                /**
+                 * TDS packet data can span multiple TDS messages.
+                 * In such scenarios, each TDS message will have its
+                 * EOM flag set to false except the last TDS message
+                 * for the packet data.
+                 */
+                bool eom_flag                              = {false};
+
+                /**
+                 * The amount of successfully read TDS messages.
+                 * (for diagnostic purposes only)
+                 */
+                tdsl::uint32_t processed_tds_message_count = 0;
+
+                /**
+                 * The amount of bytes the packet data callback asked for
+                 * in its last invocation, and the amount of bytes received
+                 * from the network since then.
+                 */
+                tdsl::uint32_t needed_bytes                = {0};
+                tdsl::size_t received_bytes                = {0};
+
+                /**
+                 * The main TDS message receive loop.
+                 *
+                 * The loop is stream-based, meaning it will not wait for
+                 * a whole TDS message to arrive before delivering the data
+                 * down to parsing. The packet data is pulled from the network
+                 * in chunks no larger than the free space in the network
+                 * buffer.
+                 *
+                 * The downstream parsing code immediately parses the
+                 * complete tokens and fires the callback functions, which
+                 * allows us to discard the processed data from receive buffer
+                 * (e.g. a processed ROW token's data). The incomplete token
+                 * at the end stays in the buffer until the rest of it is
+                 * received.
+                 */
+                do {
+                    tds_packet_info packet_info = {};
+                    if (not receive_tds_header(packet_info)) {
+                        network_buffer.get_writer()->reset();
+                        return processed_tds_message_count;
+                    }
+
+                    auto packet_data_size = packet_info.data_size;
+                    eom_flag              = packet_info.status.end_of_message;
+
+                    while (packet_data_size > 0) {
+
+                        if (network_buffer.free_space() == 0 && received_bytes) {
+                            // The buffer is full, but the parser has not seen
+                            // the latest chunk yet. Give it a chance to free
+                            // up some space before giving up.
+                            needed_bytes = deliver_packet_data(packet_info.message_type);
+                            received_bytes = {0};
+                        }
+
+                        if (network_buffer.free_space() == 0) {
+                            TDSL_DEBUG_PRINTLN("Cannot pull " TDSL_SIZET_FORMAT_SPECIFIER
+                                               " byte(s) of data from network, network buffer "
+                                               "exhausted (needed: %u)! Discarding the message.",
+                                               packet_data_size, needed_bytes);
+                            // The parser cannot make progress with the data in
+                            // the buffer, so the current message is lost. Drain
+                            // the rest of it to keep the connection in sync.
+                            drain_tds_message(packet_data_size, eom_flag);
+                            rx_status = e_receive_status::complete;
+                            return processed_tds_message_count;
+                        }
+
+                        const auto chunk_size =
+                            packet_data_size < network_buffer.free_space()
+                                ? packet_data_size
+                                : network_buffer.free_space();
+
+                        const auto recv_result =
+                            impl().do_recv(static_cast<tdsl::uint32_t>(chunk_size));
+                        if (not recv_result) {
+                            TDSL_DEBUG_PRINTLN("Cannot receive " TDSL_SIZET_FORMAT_SPECIFIER
+                                               " byte(s) of data from "
+                                               "network, receive error %d ",
+                                               chunk_size, recv_result.error());
+                            // There's no point keeping the data around, so reset the buffer
+                            network_buffer.get_writer()->reset();
+                            return processed_tds_message_count;
+                        }
+
+                        packet_data_size -= chunk_size;
+                        received_bytes += chunk_size;
+
+                        // Do not bother the parser until the amount of bytes
+                        // it asked for has arrived, unless this is the last
+                        // chunk of the message.
+                        if (received_bytes < needed_bytes &&
+                            not(eom_flag && packet_data_size == 0)) {
+                            continue;
+                        }
+
+                        needed_bytes   = deliver_packet_data(packet_info.message_type);
+                        received_bytes = {0};
+                    }
+
+                } while (processed_tds_message_count++, not eom_flag);
+
+                discard_unconsumed_data();
+                rx_status = e_receive_status::complete;
+                return processed_tds_message_count;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Receive one, complete TDS PDU (batched mode)
+             *
+             * The data is read from the network with do_recv_some(), which
+             * transfers whatever the socket has available, up to the free
+             * space in the network buffer.
+             *
+             * @see on_tds_pdu_data
+             */
+            tdsl::uint32_t receive_tds_pdu_impl(traits::true_type /*has_recv_some*/) noexcept {
+                // A timed out receive is resumed where it was left
+                if (not(rx_status == e_receive_status::timed_out)) {
+                    begin_receive_tds_pdu();
+                }
+                rx_status = e_receive_status::failed;
+
+                for (;;) {
+                    rx_timed_out           = {false};
+                    const auto carried     = take_carried_over_data();
+                    const auto recv_result =
+                        carried ? network_io_result{tdsl::size_t{carried}}
+                                : impl().do_recv_some(receive_tds_pdu_buffer());
+                    if (not recv_result) {
+                        if (rx_timed_out) {
+                            // Nothing is consumed, so the receive state is intact
+                            rx_status = e_receive_status::timed_out;
+                            break;
+                        }
+                        TDSL_DEBUG_PRINTLN("Cannot receive data from network, receive "
+                                           "error %d ",
+                                           recv_result.error());
+                        // There's no point keeping the data around, so reset the buffer
+                        network_buffer.get_writer()->reset();
+                        break;
+                    }
+
+                    const auto step = on_tds_pdu_data(recv_result.get());
+                    if (e_rx_step::complete == step) {
+                        rx_status = e_receive_status::complete;
+                    }
+                    if (not(e_rx_step::in_progress == step)) {
+                        break;
+                    }
+                }
+                return rx.processed_tds_message_count;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            inline void set_receive_timeout_impl(tdsl::uint32_t timeout_ms,
+                                                 traits::true_type) noexcept {
+                impl().do_set_recv_timeout(timeout_ms);
+            }
+
+            // --------------------------------------------------------------------------------
+
+            inline void set_receive_timeout_impl(tdsl::uint32_t, traits::false_type) noexcept {}
+
+            // --------------------------------------------------------------------------------
+
+            inline void send_attention_impl(const tdsl::uint8_t * tds_hbuf,
+                                            traits::true_type /*has_sendv*/) noexcept {
+                const byte_view bufs [] = {
+                    byte_view{tds_hbuf, sizeof(detail::tds_header)}
+                };
+                impl().do_sendv(tdsl::span<const byte_view>{bufs});
+            }
+
+            // --------------------------------------------------------------------------------
+
+            inline void send_attention_impl(const tdsl::uint8_t * tds_hbuf,
+                                            traits::false_type /*has_sendv*/) noexcept {
+                impl().do_send(byte_view{}, byte_view{tds_hbuf, sizeof(detail::tds_header)});
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Receive and validate the next TDS packet header
+             *
+             * @param [out] info Packet information
+             *
+             * @return true if a valid header is received, false otherwise
+             */
+            inline TDSL_NODISCARD bool receive_tds_header(tds_packet_info & info) noexcept {
+                // We're using a stack buffer to read TDS header
+                // because we only need it to determine the amount of
+                // bytes to expect in the message and whether the received
+                // message is the final one. The downstream parser does
+                // not need these information. Therefore, we only read
+                // packet data into internal packet buffer of network
+                // stack, which allows us to handle fragmented packets
+                // more easily (no header data to remove from buffer)
+                tdsl::uint8_t tds_hbuf [sizeof(detail::tds_header)] = {0};
+                byte_span tds_hbuf_s{tds_hbuf};
+
+                // We demand exactly `k_tds_hdr_len` bytes, even if the network
+                // receive buffer has more available. This is done preventing
+                // fragmented reads. When we read the header first, we know
+                // exactly how many bytes we will need to read the rest of the
+                // packet.
+                const auto recv_result = impl().do_recv(tds_hbuf_s.size_bytes(), tds_hbuf_s);
+                if (not recv_result) {
+                    TDSL_DEBUG_PRINTLN("Cannot receive tds message header, receive error %d",
+                                       recv_result.error());
+                    return false;
+                }
+                return parse_tds_header(tds_hbuf, info);
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Parse and validate a TDS packet header
+             *
+             * @param [in] tds_hbuf Header bytes
+             * @param [out] info Packet information
+             *
+             * @return true if the header is valid, false otherwise
+             */
+            static inline TDSL_NODISCARD bool
+            parse_tds_header(const tdsl::uint8_t (&tds_hbuf) [sizeof(detail::tds_header)],
+                             tds_packet_info & info) noexcept {
+                auto thdr_rdr     = binary_reader<tdsl::endian::big>{tds_hbuf};
+
+                // Type defines the type of message. Type is a 1-byte unsigned char.
+                info.message_type = static_cast<tdsl::detail::e_tds_message_type>(
+                    thdr_rdr.read<tdsl::uint8_t>());
+
+                // Status is a bit field used to indicate the message state. Status is a 1-byte
+                // unsigned char.
+                info.status       = thdr_rdr.read_raw<tdsl::detail::tds_message_status>();
+                // Length is the size of the packet including the 8 bytes in the packet header.
+                // It is the number of bytes from the start of this header to the start of the
+                // next packet header. Length is a 2-byte, unsigned short and is represented
+                // in network byte order (big-endian). The Length value MUST be greater than
+                // or equal to 512 bytes and smaller than or equal to 32,767 bytes. The default
+                // value is 4,096 bytes. Starting with TDS 7.3, the Length MUST be the
+                // negotiated packet size when sending a packet from client to server, unless it
+                // is the last packet of a request (that is, the EOM bit in Status is ON) or the
+                // client has not logged in.
+                static constexpr auto k_max_length = 32767;
+                const auto length                  = thdr_rdr.read<tdsl::uint16_t>();
+                if (length < sizeof(detail::tds_header) || length > k_max_length) {
+                    TDSL_DEBUG_PRINTLN("invalid tds message length %u", length);
+                    // invalid length
+                    TDSL_ASSERT_MSG(0, "Invalid tds message length!");
+                    return false;
+                }
+
+                // Length field includes the header length too, so subtract it
+                info.data_size = length - sizeof(detail::tds_header);
+                return true;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Pass the unconsumed data in the network buffer down to
+             * the packet data callback.
+             *
+             * @param [in] message_type Type of the message being received
+             *
+             * @return tdsl::uint32_t Amount of bytes the callback needs to make progress
+             */
+            inline tdsl::uint32_t
+            deliver_packet_data(tdsl::detail::e_tds_message_type message_type) noexcept {
+                // This is a netbuf_reader instance.
+                // Read operations on this will be committed
+                // to underlying buffer on object destruction
+                // e.g. nmsg_rdr.read(2) will cause 2 bytes from
+                // the start of the underlying buffer to be removed
+                auto nmsg_rdr           = network_buffer.get_reader();
+                const auto needed_bytes = packet_data_cb(message_type, *nmsg_rdr);
+                if (needed_bytes) {
+                    TDSL_DEBUG_PRINTLN("network_impl_base::deliver_packet_data(...) -> "
+                                       "packet_data_cb needs `%u` more bytes",
+                                       needed_bytes);
+                }
+                return needed_bytes;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Discard the data left in the network buffer after the
+             * EOM is received.
+             */
+            inline void discard_unconsumed_data() noexcept {
+                // NOTE: Sometimes, the message contains some parts that
+                // not yet be parsed, which results in parsing failure.
+                // The unparsed data remains in the receive buffer and
+                // affects the consequent responses' parsing. In such case
+                // it is for better to flush the receive buffer.
+                auto rbuf_reader = network_buffer.get_reader();
+                if (rbuf_reader->remaining_bytes()) {
+                    TDSL_DEBUG_PRINTLN("Although the EOM is received, receive buffer still "
+                                       "contains " TDSL_SIZET_FORMAT_SPECIFIER " bytes of "
+                                       "data which means packet handler failed to handle "
+                                       "all the data in the "
+                                       "message. Discarding the data.",
+                                       rbuf_reader->remaining_bytes());
+                    // Consume the remaining data
+                    rbuf_reader->advance(
+                        static_cast<tdsl::ssize_t>(rbuf_reader->remaining_bytes()));
+                }
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Keep @p size bytes at @p offset of the network buffer, which
+             * were received after the end of the current message, for the
+             * next receive. The network buffer MUST be empty.
+             *
+             * @param [in] offset Offset of the bytes in the network buffer
+             * @param [in] size Amount of bytes
+             */
+            inline void carry_over_data(tdsl::size_t offset, tdsl::size_t size) noexcept {
+                rx_carry = {0};
+                if (0 == size) {
+                    return;
+                }
+                auto writer = network_buffer.get_writer();
+                TDSL_ASSERT(writer->offset() == 0);
+                TDSL_DEBUG_PRINTLN("Keeping " TDSL_SIZET_FORMAT_SPECIFIER
+                                   " byte(s) received after the EOM for the next receive",
+                                   size);
+                memmove(writer->data(), writer->data() + offset, size);
+                rx_carry = size;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Receive and discard the rest of the current TDS message
+             *
+             * @param [in] packet_data_size Remaining data size of the current packet
+             * @param [in] eom Whether the current packet is the last one of the message
+             */
+            void drain_tds_message(tdsl::size_t packet_data_size, bool eom) noexcept {
+                network_buffer.get_writer()->reset();
+                for (;;) {
+                    while (packet_data_size > 0) {
+                        const auto free_space = network_buffer.free_space();
+                        const auto chunk_size =
+                            packet_data_size < free_space ? packet_data_size : free_space;
+                        if (not impl().do_recv(static_cast<tdsl::uint32_t>(chunk_size))) {
+                            network_buffer.get_writer()->reset();
+                            return;
+                        }
+                        network_buffer.get_writer()->reset();
+                        packet_data_size -= chunk_size;
+                    }
+
+                    if (eom) {
+                        return;
+                    }
+
+                    tds_packet_info packet_info = {};
+                    if (not receive_tds_header(packet_info)) {
+                        return;
+                    }
+                    packet_data_size = packet_info.data_size;
+                    eom              = packet_info.status.end_of_message;
+                }
+            }
+
+            // --------------------------------------------------------------------------------
+
             // The callback to be invoked for each TDS packet.
             // The callback is invoked in streaming fashion to
             // free occupied space as soon as possible, which
@@ -422,16 +1284,42 @@ namespace tdsl {
             tds_packet_data_callback packet_data_cb{};
 
             // Negotiated TDS packet size
-            // The capacity of @p network_buffer MUST
-            // be equal to this value (may be greater).
-            // Otherwise, the client may not be able to
-            // receive the data from the server.
+            // The packets are received in chunks, so
+            // the capacity of @p network_buffer can be
+            // less than this value.
             tdsl::uint16_t tds_packet_size = {4096};
 
+            // State of the push mode receive
+            tds_rx_state rx                = {};
+
+            // Amount of bytes received after the EOM of the last message,
+            // kept at the beginning of the network buffer for the next receive
+            tdsl::size_t rx_carry          = {0};
+
+            // RESETCONNECTION(SKIPTRAN) status bit for the next request, if any
+            tdsl::uint8_t tx_reset_status  = {0};
+
+            // Whether the message being sent is to be ignored by the server
+            bool tx_ignore_message         = {false};
+
+            // The outcome of the last receive
+            e_receive_status rx_status     = {e_receive_status::complete};
+
+            // Set by the implementation when a receive times out
+            bool rx_timed_out              = {false};
+
         protected:
+            /**
+             * Implementations call this when a receive fails because
+             * the receive timeout has elapsed.
+             */
+            inline void on_recv_timeout() noexcept {
+                rx_timed_out = {true};
+            }
+
             // How many attempts the driver should make to establish a connection
             tdsl::uint16_t conn_retry_count{10};
-            // The delay between each connection attempt (milliseconds)
+            // The (maximum) delay between each connection attempt (milliseconds)
             tdsl::uint16_t conn_retry_delay_ms{3000};
 
             // The network I/O buffer.
@@ -35,6 +35,26 @@ namespace tdsl { namespace net {
      *    expected<tdsl::uint32_t, tdsl::int32_t> do_recv(tdsl::uint32_t exact_amount,
      *                                                    byte_span dst_buf);
      *
+     * Optionally, an implementation may also implement:
+     *
+     *    expected<tdsl::uint32_t, tdsl::int32_t> do_recv_some(byte_span dst_buf) noexcept;
+     *
+     * which reads whatever is available in the socket (at least one byte, at most
+     * dst_buf.size_bytes()) into @p dst_buf. When present, the TDS packets are
+     * received in batched mode, which allows multiple TDS packets to be received
+     * with a single read call.
+     *
+     *    tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept;
+     *
+     * which sends @p bufs sequentially with a single scatter/gather write. When
+     * present, all TDS packets of a message are sent with a single call.
+     *
+     *    void do_set_recv_timeout(tdsl::uint32_t timeout_ms) noexcept;
+     *
+     * which bounds the time do_recv_some() waits for data (0 = implementation
+     * default). When the time elapses, do_recv_some() must call on_recv_timeout()
+     * and fail without consuming any data, so the receive can be resumed later.
+     *
      * @tparam Implementation Concrete network implementation to validate
      */
     template <typename Implementation>
@@ -54,6 +74,28 @@ namespace tdsl { namespace net {
         template <typename T>
         using has_recv_member_fn_2 = traits::is_detected<has_recv_member_fn_2_t, T>;
 
+        template <typename T>
+        using has_recv_some_member_fn_t =
+            decltype(traits::declval<T>().do_recv_some(tdsl::byte_span{}));
+
+        template <typename T>
+        using has_recv_some_member_fn = traits::is_detected<has_recv_some_member_fn_t, T>;
+
+        template <typename T>
+        using has_sendv_member_fn_t =
+            decltype(traits::declval<T>().do_sendv(tdsl::span<const tdsl::byte_view>{}));
+
+        template <typename T>
+        using has_sendv_member_fn = traits::is_detected<has_sendv_member_fn_t, T>;
+
+        template <typename T>
+        using has_set_recv_timeout_member_fn_t =
+            decltype(traits::declval<T>().do_set_recv_timeout(tdsl::uint32_t{0}));
+
+        template <typename T>
+        using has_set_recv_timeout_member_fn =
+            traits::is_detected<has_set_recv_timeout_member_fn_t, T>;
+
         template <typename T>
         using has_send_member_fn_t =
             decltype(traits::declval<T>().do_send(tdsl::byte_view{}, tdsl::byte_view{}));
@@ -0,0 +1,205 @@
+/**
+ * ____________________________________________________
+ * Network implementation for tdslite using non-blocking
+ * sockets and epoll (Linux).
+ *
+ * @file   tdsl_netimpl_epoll.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_NETIMPL_EPOLL_HPP
+#define TDSL_NET_NETIMPL_EPOLL_HPP
+
+#include <tdslite-net/base/network_io_base.hpp>
+
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_expected.hpp>
+#include <tdslite/util/tdsl_buffer_object.hpp>
+
+#include <vector>
+
+namespace tdsl { namespace net {
+
+    /**
+     * Synchronous networking code for tdslite on top of non-blocking
+     * POSIX sockets and epoll, without any third-party dependency.
+     *
+     * The socket is non-blocking; an operation that would block waits
+     * for the socket readiness with epoll_wait(), bounded by the I/O timeout.
+     * Sends are scatter-gather writes, and reads go straight into the
+     * network buffer.
+     */
+    struct tdsl_netimpl_epoll : public network_io_base<tdsl_netimpl_epoll> {
+
+        using network_io_base<tdsl_netimpl_epoll>::network_io_result;
+
+        /**
+         * Socket options, applied on connect
+         */
+        struct socket_options {
+            // Disable Nagle's algorithm (TCP_NODELAY)
+            bool tcp_nodelay            = {true};
+            // SO_RCVBUF size in bytes (0 = system default)
+            tdsl::int32_t rcvbuf_size   = {0};
+            // SO_SNDBUF size in bytes (0 = system default)
+            tdsl::int32_t sndbuf_size   = {0};
+            // Maximum time to wait for the socket readiness
+            // in milliseconds (-1 = wait indefinitely)
+            tdsl::int32_t io_timeout_ms = {-1};
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Default c-tor
+         */
+        TDSL_SYMBOL_VISIBLE tdsl_netimpl_epoll();
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Construct with socket options @p opts
+         */
+        TDSL_SYMBOL_VISIBLE explicit tdsl_netimpl_epoll(const socket_options & opts);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * D-tor
+         */
+        TDSL_SYMBOL_VISIBLE ~tdsl_netimpl_epoll();
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Set the socket options. Takes effect on the next connect.
+         */
+        TDSL_SYMBOL_VISIBLE void set_socket_options(const socket_options & opts) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to the target endpoint @p target : @p port
+         *
+         * @param [in] target Hostname or IP
+         * @param [in] port Port number
+         *
+         * @returns true_type when connected
+         * @returns -1 when socket associated with network implementation is alive, call @ref
+         * do_disconnect first
+         * @returns -2 when resolve of @p target fails
+         * @returns -3 when connection to all of the resolved endpoints fails
+         * @returns -4 when the epoll instance cannot be created
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::expected<tdsl::traits::true_type, int>
+        do_connect(tdsl::char_view target, tdsl::uint16_t port);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Disconnect the socket from the connected endpoint and close it.
+         *
+         * @returns 0 if socket is disconnected and the class is ready for re-use
+         * @returns -1 if socket is not alive
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_disconnect() noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views @p header and @p message sequentially to the
+         * connected endpoint with a single write
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -1 when the send times out
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_send(byte_view header, byte_view message) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views in @p bufs sequentially to the connected endpoint
+         * with a single write
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -1 when the send times out
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_exactly bytes from socket
+         * into network buffer.
+         *
+         * @param [in] transfer_exactly Exact amount of bytes to read
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_exactly) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_amount bytes from socket
+         * into @p dst_buf
+         *
+         * @param [in] transfer_amount Exact amount of bytes to read
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_amount,
+                                                      byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read whatever is available in the socket into @p dst_buf
+         *
+         * Waits until at least one byte is available.
+         *
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv_some(byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Bound the time do_recv_some() waits for data to @p timeout_ms
+         * milliseconds, overriding socket_options::io_timeout_ms for the
+         * receives (0 = use io_timeout_ms).
+         *
+         * @param [in] timeout_ms Receive timeout
+         */
+        TDSL_SYMBOL_VISIBLE void do_set_recv_timeout(tdsl::uint32_t timeout_ms) noexcept;
+
+    private:
+        /**
+         * Wait until the socket is ready for @p events, for at most
+         * @p timeout_ms milliseconds (-1 = wait indefinitely)
+         *
+         * @returns 0 when ready
+         * @returns -1 on timeout
+         * @returns -2 on error
+         */
+        tdsl::int32_t wait_ready(tdsl::uint32_t events, tdsl::int32_t timeout_ms) noexcept;
+
+        // Underlying buffer
+        static constexpr tdsl::uint32_t k_buffer_size = {16384};
+        std::vector<tdsl::uint8_t> underlying_buffer{std::vector<tdsl::uint8_t>(k_buffer_size)};
+        socket_options options                        = {};
+        // The events the socket is currently registered for
+        tdsl::uint32_t registered_events              = {0};
+        // Receive timeout override (0 = none)
+        tdsl::uint32_t recv_timeout_ms                = {0};
+        int socket_fd                                 = {-1};
+        int epoll_fd                                  = {-1};
+    };
+
+}} // namespace tdsl::net
+
+#endif
@@ -0,0 +1,954 @@
+/**
+ * ____________________________________________________
+ * Session Multiplexing Protocol (SMP, MARS) layer for
+ * tdslite
+ *
+ * @file   tdsl_netimpl_smp.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_NETIMPL_SMP_HPP
+#define TDSL_NET_NETIMPL_SMP_HPP
+
+#include <tdslite-net/base/network_io_base.hpp>
+
+#include <tdslite/detail/tdsl_allocator.hpp>
+#include <tdslite/detail/tdsl_message_type.hpp>
+#include <tdslite/detail/tdsl_prelogin.hpp>
+#include <tdslite/detail/tdsl_version.hpp>
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_expected.hpp>
+#include <tdslite/util/tdsl_buffer_object.hpp>
+#include <tdslite/util/tdsl_debug_print.hpp>
+
+#include <string.h> // needed for memcpy
+
+namespace tdsl { namespace net {
+
+    template <typename NetImpl>
+    struct tdsl_netimpl_smp;
+
+    /**
+     * SMP packet header ([MC-SMP] 2.2.1)
+     *
+     * All fields are little-endian on the wire.
+     */
+    struct smp_header {
+        static constexpr tdsl::uint8_t k_smid = {0x53};
+        static constexpr tdsl::size_t k_size  = {16};
+
+        enum e_flags : tdsl::uint8_t
+        {
+            syn  = 0x01,
+            ack  = 0x02,
+            fin  = 0x04,
+            data = 0x08
+        };
+
+        tdsl::uint8_t flags   = {0};
+        // Session ID
+        tdsl::uint16_t sid    = {0};
+        // Packet length, including the header
+        tdsl::uint32_t length = {0};
+        // SEQNUM of this DATA packet, or of the last DATA packet sent
+        tdsl::uint32_t seqnum = {0};
+        // The highest SEQNUM the sender of the packet is willing to accept
+        tdsl::uint32_t wndw   = {0};
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Encode the header into @p out
+         */
+        inline void encode(tdsl::uint8_t (&out) [k_size]) const noexcept {
+            out [0] = k_smid;
+            out [1] = flags;
+            put_le(out + 2, sid, 2);
+            put_le(out + 4, length, 4);
+            put_le(out + 8, seqnum, 4);
+            put_le(out + 12, wndw, 4);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Decode the header in @p in
+         *
+         * @returns false if @p in is not an SMP header
+         */
+        inline TDSL_NODISCARD bool decode(const tdsl::uint8_t (&in) [k_size]) noexcept {
+            if (not(in [0] == k_smid)) {
+                return false;
+            }
+            flags  = in [1];
+            sid    = static_cast<tdsl::uint16_t>(get_le(in + 2, 2));
+            length = get_le(in + 4, 4);
+            seqnum = get_le(in + 8, 4);
+            wndw   = get_le(in + 12, 4);
+            return length >= k_size;
+        }
+
+    private:
+        static inline void put_le(tdsl::uint8_t * p, tdsl::uint32_t v, tdsl::uint8_t n) noexcept {
+            for (tdsl::uint8_t i = 0; i < n; i++) {
+                p [i] = static_cast<tdsl::uint8_t>(v >> (i * 8));
+            }
+        }
+
+        static inline tdsl::uint32_t get_le(const tdsl::uint8_t * p, tdsl::uint8_t n) noexcept {
+            tdsl::uint32_t v = {0};
+            for (tdsl::uint8_t i = 0; i < n; i++) {
+                v |= static_cast<tdsl::uint32_t>(p [i]) << (i * 8);
+            }
+            return v;
+        }
+    };
+
+    /**
+     * A physical connection shared by multiple logical sessions (MARS)
+     *
+     * The link connects to the server with @p NetImpl, negotiates MARS in
+     * the PRELOGIN message and then carries the TDS messages of the sessions
+     * in SMP packets ([MC-SMP]). Each session is a @ref tdsl_netimpl_smp,
+     * which can be used as the network implementation of a tds_context (or a
+     * tdsl_driver), so each session has its own command state:
+     *
+     *    smp_link<tdsl_netimpl_epoll> link{};
+     *    tdsl_driver<tdsl_netimpl_smp<tdsl_netimpl_epoll>> a{link}, b{link};
+     *    a.connect(params); // connects the link, logs in
+     *    b.connect(params); // opens a second session, no login
+     *
+     * The data received for the other sessions is queued in their own
+     * session, up to the window each session advertises, so a command can
+     * be executed on a session while the result of another one is being
+     * read (e.g. from the row callback).
+     *
+     * The link and its sessions must be used from a single thread.
+     *
+     * @tparam NetImpl Network implementation of the physical connection.
+     *                 Must implement do_sendv() and do_recv_some().
+     */
+    template <typename NetImpl>
+    struct smp_link {
+        using network_io_result = typename NetImpl::network_io_result;
+
+        // Maximum amount of sessions open at the same time
+        static constexpr tdsl::uint16_t k_max_sessions = {16};
+
+        // Amount of DATA packets a session accepts before it has to
+        // acknowledge them (the initial window is 4, see [MC-SMP] 3.1.5.1)
+        static constexpr tdsl::uint32_t k_window       = {4};
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Construct a new smp link
+         *
+         * (forwarding constructor, @p args are passed to NetImpl)
+         */
+        template <typename... Args>
+        inline smp_link(Args &&... args) noexcept : net(TDSL_FORWARD(args)...) {}
+
+        smp_link(const smp_link &)             = delete;
+        smp_link & operator=(const smp_link &) = delete;
+
+        // --------------------------------------------------------------------------------
+
+        inline ~smp_link() noexcept {
+            disconnect();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to @p target : @p port and negotiate MARS
+         *
+         * @returns true_type when connected and MARS is enabled
+         * @returns -1 when the physical connection cannot be established
+         * @returns -2 when the PRELOGIN response cannot be received
+         * @returns -3 when the server does not enable MARS, or requires encryption
+         */
+        template <typename T>
+        inline auto connect(T target, tdsl::uint16_t port) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, int> {
+            disconnect();
+            if (not net.do_connect(target, port)) {
+                return tdsl::unexpected(-1);
+            }
+
+            const auto r = prelogin();
+            if (not(r == 0)) {
+                net.do_disconnect();
+                return tdsl::unexpected(r);
+            }
+
+            connected          = {true};
+            opened_any_session = {false};
+            login_tds_version  = {tdsl::detail::e_tds_version::sql_server_2000_sp1};
+            rx                 = {};
+            return tdsl::traits::true_type{};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Close the physical connection. All sessions are closed.
+         */
+        inline void disconnect() noexcept {
+            if (connected) {
+                net.do_disconnect();
+            }
+            connected = {false};
+            free_chunk(rx.chunk);
+            rx = {};
+            for (auto & slot : sessions) {
+                if (slot.state) {
+                    slot.state->peer_closed = {true};
+                    drop_queue(*slot.state);
+                }
+                slot = {};
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the physical connection is alive
+         */
+        inline TDSL_NODISCARD bool is_connected() const noexcept {
+            return connected;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The physical connection (e.g. for setting the socket options)
+         */
+        inline TDSL_NODISCARD auto physical() noexcept -> NetImpl & {
+            return net;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Amount of sessions currently open
+         */
+        inline TDSL_NODISCARD auto session_count() const noexcept -> tdsl::uint16_t {
+            tdsl::uint16_t count = {0};
+            for (const auto & slot : sessions) {
+                count += slot.state ? 1 : 0;
+            }
+            return count;
+        }
+
+    private:
+        friend struct tdsl_netimpl_smp<NetImpl>;
+
+        /**
+         * A received DATA packet payload, waiting to be consumed
+         */
+        struct rx_chunk {
+            rx_chunk * next       = {nullptr};
+            tdsl::uint8_t * data  = {nullptr};
+            tdsl::uint32_t size   = {0};
+            tdsl::uint32_t filled = {0};
+        };
+
+        /**
+         * Per-session SMP state
+         */
+        struct session_state {
+            tdsl::uint16_t sid          = {0};
+            bool open                   = {false};
+            // The server has closed the session, or the link is down
+            bool peer_closed            = {false};
+            // Opened after another session on the same connection,
+            // so the login of the connection applies to it
+            bool joined                 = {false};
+            // SEQNUM of the last DATA packet sent
+            tdsl::uint32_t send_seqnum  = {0};
+            // The highest SEQNUM the server accepts
+            tdsl::uint32_t peer_wndw    = {0};
+            // SEQNUM of the last DATA packet received
+            tdsl::uint32_t recv_seqnum  = {0};
+            // The highest SEQNUM this session accepts, and the last
+            // value advertised to the server
+            tdsl::uint32_t recv_wndw    = {0};
+            tdsl::uint32_t acked_wndw   = {0};
+            // Received DATA payloads, oldest first
+            rx_chunk * head             = {nullptr};
+            rx_chunk * tail             = {nullptr};
+            tdsl::uint32_t head_offset  = {0};
+        };
+
+        struct session_slot {
+            session_state * state = {nullptr};
+            // FIN is sent, waiting for the FIN of the server
+            // before the SID can be reused
+            bool closing          = {false};
+        };
+
+        /**
+         * State of the SMP packet being received
+         */
+        struct rx_state {
+            tdsl::uint8_t hbuf [smp_header::k_size] = {0};
+            tdsl::uint8_t hbuf_len                  = {0};
+            smp_header header                       = {};
+            // Remaining payload bytes of the current packet
+            tdsl::uint32_t remaining                = {0};
+            // The chunk the payload goes into (nullptr = discard)
+            rx_chunk * chunk                        = {nullptr};
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send PRELOGIN with the MARS option on and check the response
+         *
+         * @returns 0 if MARS is enabled by the server
+         */
+        inline int prelogin() noexcept {
+            tdsl::uint8_t message [tdsl::detail::prelogin::k_message_size];
+            tdsl::detail::prelogin::encode(message, /*mars=*/true);
+
+            prelogin_response = {};
+            net.register_packet_data_callback(&handle_prelogin_response, this);
+            net.do_write(tdsl::byte_view{message});
+            net.do_send_tds_pdu(tdsl::detail::e_tds_message_type::pre_login);
+            net.do_receive_tds_pdu();
+            if (not prelogin_response.received) {
+                return -2;
+            }
+            return (prelogin_response.mars && not prelogin_response.requires_encryption()) ? 0
+                                                                                           : -3;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        static tdsl::uint32_t
+        handle_prelogin_response(void * self_optr, tdsl::detail::e_tds_message_type message_type,
+                                 tdsl::binary_reader<tdsl::endian::little> & rr) noexcept {
+            auto & self = *static_cast<smp_link *>(self_optr);
+            if (not(message_type == tdsl::detail::e_tds_message_type::tabular_result)) {
+                return 0;
+            }
+            return tdsl::detail::prelogin::decode(tdsl::byte_view{rr.data(), rr.size_bytes()},
+                                                  self.prelogin_response);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Assign a SID to @p s and send SYN
+         *
+         * @returns false if the link is down, or all SIDs are in use
+         */
+        inline TDSL_NODISCARD bool open(session_state & s) noexcept {
+            if (not connected) {
+                return false;
+            }
+
+            for (tdsl::uint16_t sid = 0; sid < k_max_sessions; sid++) {
+                auto & slot = sessions [sid];
+                if (slot.state || slot.closing) {
+                    continue;
+                }
+                s             = {};
+                s.sid         = sid;
+                s.open        = {true};
+                s.joined      = opened_any_session;
+                s.peer_wndw   = k_window;
+                s.recv_wndw   = k_window;
+                s.acked_wndw  = k_window;
+                slot.state    = &s;
+                if (not send_control(s, smp_header::syn)) {
+                    slot.state = {nullptr};
+                    s.open     = {false};
+                    return false;
+                }
+                opened_any_session = {true};
+                return true;
+            }
+            TDSL_DEBUG_PRINTLN("smp_link::open() -> no free session id");
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send FIN for @p s and detach it from the link
+         */
+        inline void close(session_state & s) noexcept {
+            if (not s.open) {
+                return;
+            }
+            auto & slot = sessions [s.sid];
+            if (connected && slot.state == &s) {
+                // The SID is reused after the server's FIN arrives
+                slot.closing = not s.peer_closed;
+                if (not s.peer_closed) {
+                    send_control(s, smp_header::fin);
+                }
+            }
+            if (slot.state == &s) {
+                slot.state = {nullptr};
+            }
+            drop_queue(s);
+            s.open = {false};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send the TDS packets in @p bufs on session @p s, one DATA packet
+         * per TDS packet. Waits for the server to open the window, if needed.
+         *
+         * @returns 0 on success, -1 on failure
+         */
+        inline tdsl::int32_t send(session_state & s, tdsl::span<const byte_view> bufs) noexcept {
+            static constexpr tdsl::size_t k_max_headers = {8};
+
+            tdsl::uint8_t headers [k_max_headers][smp_header::k_size];
+            byte_view out [k_max_headers * 4];
+            tdsl::size_t header_count = {0}, out_count = {0};
+
+            auto flush = [&]() -> bool {
+                const bool ok = not out_count ||
+                                net.do_sendv(tdsl::span<const byte_view>{out, out_count}) == 0;
+                header_count = out_count = {0};
+                return ok;
+            };
+
+            // Read position in bufs
+            tdsl::size_t bi = {0}, bo = {0};
+            auto skip_empty = [&]() {
+                while (bi < bufs.size() && bo == bufs [bi].size()) {
+                    bi++;
+                    bo = {0};
+                }
+            };
+
+            for (skip_empty(); bi < bufs.size(); skip_empty()) {
+                if (not s.open || s.peer_closed) {
+                    return -1;
+                }
+
+                // The TDS packet length is in the header, which might
+                // be split between the buffers.
+                tdsl::uint8_t tds_hdr [4] = {0};
+                {
+                    tdsl::size_t i = bi, o = bo;
+                    for (tdsl::uint8_t n = 0; n < sizeof(tds_hdr); n++) {
+                        while (i < bufs.size() && o == bufs [i].size()) {
+                            i++;
+                            o = {0};
+                        }
+                        if (i == bufs.size()) {
+                            return -1;
+                        }
+                        tds_hdr [n] = bufs [i].data() [o++];
+                    }
+                }
+                tdsl::uint32_t packet_len = (tds_hdr [2] << 8) | tds_hdr [3];
+
+                if (header_count == k_max_headers ||
+                    out_count + 2 > sizeof(out) / sizeof(out [0])) {
+                    if (not flush()) {
+                        return -1;
+                    }
+                }
+
+                // Wait for the server to open the window
+                if (s.send_seqnum + 1 > s.peer_wndw) {
+                    if (not flush()) {
+                        return -1;
+                    }
+                    while (s.send_seqnum + 1 > s.peer_wndw) {
+                        if (s.peer_closed || not pump()) {
+                            return -1;
+                        }
+                    }
+                }
+
+                smp_header h{};
+                h.flags      = smp_header::data;
+                h.sid        = s.sid;
+                h.length     = static_cast<tdsl::uint32_t>(smp_header::k_size + packet_len);
+                h.seqnum     = ++s.send_seqnum;
+                h.wndw       = s.recv_wndw;
+                s.acked_wndw = s.recv_wndw;
+                h.encode(headers [header_count]);
+                out [out_count++] = byte_view{headers [header_count++], smp_header::k_size};
+
+                // The TDS packet itself
+                while (packet_len) {
+                    skip_empty();
+                    if (bi == bufs.size()) {
+                        return -1;
+                    }
+                    if (out_count == sizeof(out) / sizeof(out [0])) {
+                        if (not flush()) {
+                            return -1;
+                        }
+                    }
+                    const auto avail = bufs [bi].size() - bo;
+                    const auto n     = avail < packet_len ? avail : packet_len;
+                    out [out_count++] = byte_view{bufs [bi].data() + bo, n};
+                    bo += n;
+                    packet_len -= static_cast<tdsl::uint32_t>(n);
+                }
+            }
+            return flush() ? 0 : -1;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Copy the received data of session @p s into @p dst, receiving
+         * from the physical connection until some data arrives for @p s.
+         */
+        inline auto receive(session_state & s, byte_span dst) noexcept -> network_io_result {
+            for (;;) {
+                if (s.head) {
+                    return consume(s, dst);
+                }
+                if (not s.open || s.peer_closed) {
+                    return tdsl::unexpected(-1);
+                }
+                // The server has used up the advertised window, do not
+                // let it wait for the window update we are holding back
+                if (s.recv_seqnum >= s.acked_wndw && not(s.recv_wndw == s.acked_wndw) &&
+                    not send_control(s, smp_header::ack)) {
+                    return tdsl::unexpected(-1);
+                }
+                if (not pump()) {
+                    return tdsl::unexpected(-1);
+                }
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline auto consume(session_state & s, byte_span dst) noexcept -> tdsl::size_t {
+            rx_chunk * c     = s.head;
+            const auto avail = c->size - s.head_offset;
+            const auto n     = avail < dst.size_bytes() ? avail : dst.size_bytes();
+            memcpy(dst.data(), c->data + s.head_offset, n);
+            s.head_offset += static_cast<tdsl::uint32_t>(n);
+
+            if (s.head_offset == c->size) {
+                s.head        = c->next;
+                s.head_offset = {0};
+                if (not s.head) {
+                    s.tail = {nullptr};
+                }
+                free_chunk(c);
+                // The packet is consumed, open the window by one
+                s.recv_wndw++;
+                if (s.recv_wndw - s.acked_wndw >= k_window / 2) {
+                    send_control(s, smp_header::ack);
+                }
+            }
+            return n;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send a SYN, ACK or FIN packet for session @p s
+         */
+        inline bool send_control(session_state & s, smp_header::e_flags flag) noexcept {
+            smp_header h{};
+            h.flags      = flag;
+            h.sid        = s.sid;
+            h.length     = smp_header::k_size;
+            h.seqnum     = s.send_seqnum;
+            h.wndw       = s.recv_wndw;
+            s.acked_wndw = s.recv_wndw;
+            tdsl::uint8_t hbuf [smp_header::k_size];
+            h.encode(hbuf);
+            const byte_view bufs [] = {byte_view{hbuf}};
+            if (not(net.do_sendv(tdsl::span<const byte_view>{bufs}) == 0)) {
+                disconnect();
+                return false;
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read from the physical connection once and dispatch the
+         * received SMP packets to their sessions.
+         *
+         * @returns false if the link is down
+         */
+        inline bool pump() noexcept {
+            if (not connected) {
+                return false;
+            }
+
+            const auto r = net.do_recv_some(byte_span{rx_buffer});
+            if (not r) {
+                TDSL_DEBUG_PRINTLN("smp_link::pump() -> receive failed (%d)", r.error());
+                disconnect();
+                return false;
+            }
+
+            const tdsl::uint8_t * pos = rx_buffer;
+            const tdsl::uint8_t * end = rx_buffer + r.get();
+            while (pos < end) {
+                const auto avail = static_cast<tdsl::uint32_t>(end - pos);
+                if (rx.remaining) {
+                    const auto n = avail < rx.remaining ? avail : rx.remaining;
+                    if (rx.chunk) {
+                        memcpy(rx.chunk->data + rx.chunk->filled, pos, n);
+                        rx.chunk->filled += n;
+                    }
+                    pos += n;
+                    rx.remaining -= n;
+                    if (rx.remaining == 0) {
+                        on_data_complete();
+                    }
+                    continue;
+                }
+
+                const tdsl::uint32_t missing = smp_header::k_size - rx.hbuf_len;
+                const auto n                 = avail < missing ? avail : missing;
+                memcpy(rx.hbuf + rx.hbuf_len, pos, n);
+                rx.hbuf_len += static_cast<tdsl::uint8_t>(n);
+                pos += n;
+                if (rx.hbuf_len == smp_header::k_size) {
+                    rx.hbuf_len = {0};
+                    if (not on_header()) {
+                        disconnect();
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline bool on_header() noexcept {
+            if (not rx.header.decode(rx.hbuf)) {
+                TDSL_DEBUG_PRINTLN("smp_link::on_header() -> invalid SMP header");
+                return false;
+            }
+
+            const auto & h = rx.header;
+            auto * slot    = h.sid < k_max_sessions ? &sessions [h.sid] : nullptr;
+            auto * s       = slot ? slot->state : nullptr;
+
+            if (s) {
+                s->peer_wndw = h.wndw;
+            }
+
+            if (h.flags & smp_header::fin) {
+                if (s) {
+                    s->peer_closed = {true};
+                }
+                else if (slot) {
+                    slot->closing = {false};
+                }
+            }
+
+            if (h.flags & smp_header::data) {
+                if (s) {
+                    s->recv_seqnum = h.seqnum;
+                }
+                rx.remaining = h.length - static_cast<tdsl::uint32_t>(smp_header::k_size);
+                rx.chunk     = nullptr;
+                if (s && rx.remaining) {
+                    rx.chunk = alloc_chunk(rx.remaining);
+                    if (not rx.chunk) {
+                        return false;
+                    }
+                }
+                if (rx.remaining == 0) {
+                    on_data_complete();
+                }
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void on_data_complete() noexcept {
+            rx_chunk * c = rx.chunk;
+            rx.chunk     = nullptr;
+            if (not c) {
+                return;
+            }
+
+            auto * s = sessions [rx.header.sid].state;
+            if (not s) {
+                // The session is closed while its data was being received
+                free_chunk(c);
+                return;
+            }
+            if (s->tail) {
+                s->tail->next = c;
+            }
+            else {
+                s->head = c;
+            }
+            s->tail = c;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        static inline auto alloc_chunk(tdsl::uint32_t size) noexcept -> rx_chunk * {
+            rx_chunk * c = tds_allocator<rx_chunk>::create();
+            if (not c) {
+                return nullptr;
+            }
+            c->data = tds_allocator<tdsl::uint8_t>::allocate(size);
+            if (not c->data) {
+                tds_allocator<rx_chunk>::destroy(c);
+                return nullptr;
+            }
+            c->size = size;
+            return c;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        static inline void free_chunk(rx_chunk * c) noexcept {
+            if (not c) {
+                return;
+            }
+            tds_allocator<tdsl::uint8_t>::deallocate(c->data, c->size);
+            tds_allocator<rx_chunk>::destroy(c);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        static inline void drop_queue(session_state & s) noexcept {
+            while (s.head) {
+                rx_chunk * next = s.head->next;
+                free_chunk(s.head);
+                s.head = next;
+            }
+            s.tail        = {nullptr};
+            s.head_offset = {0};
+        }
+
+        // The physical connection
+        NetImpl net;
+        session_slot sessions [k_max_sessions]             = {};
+        rx_state rx                                        = {};
+        tdsl::uint8_t rx_buffer [8192]                     = {};
+        tdsl::detail::prelogin::response prelogin_response = {};
+        // The TDS version negotiated by the login of the connection
+        tdsl::detail::e_tds_version login_tds_version      = {
+            tdsl::detail::e_tds_version::sql_server_2000_sp1};
+        bool connected                                     = {false};
+        bool opened_any_session                            = {false};
+    };
+
+    /**
+     * A logical session on a @ref smp_link
+     *
+     * The TDS messages of the session are carried in SMP DATA packets
+     * on the link's physical connection. The first session connects
+     * the link. See @ref smp_link for the details.
+     *
+     * @tparam NetImpl Network implementation of the physical connection
+     */
+    template <typename NetImpl>
+    struct tdsl_netimpl_smp : public network_io_base<tdsl_netimpl_smp<NetImpl>> {
+        using link_type         = smp_link<NetImpl>;
+        using network_io_result = typename network_io_base<tdsl_netimpl_smp>::network_io_result;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Construct a new session on @p l
+         *
+         * @param [in] l The link
+         * @param [in] buffer_size Size of the network buffer of the session
+         */
+        inline explicit tdsl_netimpl_smp(link_type & l,
+                                         tdsl::uint32_t buffer_size = 16384) noexcept :
+            link(l) {
+            buffer = tds_allocator<tdsl::uint8_t>::allocate(buffer_size);
+            if (buffer) {
+                buffer_capacity      = buffer_size;
+                this->network_buffer = tdsl_buffer_object{buffer, buffer_size};
+            }
+        }
+
+        tdsl_netimpl_smp(const tdsl_netimpl_smp &)             = delete;
+        tdsl_netimpl_smp & operator=(const tdsl_netimpl_smp &) = delete;
+
+        // --------------------------------------------------------------------------------
+
+        inline ~tdsl_netimpl_smp() noexcept {
+            do_disconnect();
+            if (buffer) {
+                tds_allocator<tdsl::uint8_t>::deallocate(buffer, buffer_capacity);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Open the session, connecting the link to @p target : @p port first
+         * if it is not connected.
+         *
+         * @returns true_type when the session is open
+         * @returns -1, -2, -3 when the link cannot connect (see smp_link::connect)
+         * @returns -4 when the session cannot be opened
+         */
+        template <typename T>
+        inline auto do_connect(T target, tdsl::uint16_t port) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, int> {
+            do_disconnect();
+            if (not link.is_connected()) {
+                auto r = link.connect(target, port);
+                if (not r) {
+                    return r;
+                }
+            }
+            this->network_buffer.get_writer()->reset();
+            if (not link.open(state)) {
+                return tdsl::unexpected(-4);
+            }
+            return tdsl::traits::true_type{};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Close the session. The link stays connected.
+         *
+         * @returns 0 if the session is closed
+         * @returns -1 if the session is not open
+         */
+        inline tdsl::int32_t do_disconnect() noexcept {
+            if (not state.open) {
+                return -1;
+            }
+            link.close(state);
+            return 0;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the session shares the login of a session opened before
+         * it on the same connection. Such sessions must not log in again.
+         */
+        inline TDSL_NODISCARD bool joins_existing_login() const noexcept {
+            return state.open && state.joined;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The TDS version negotiated by the login that the session joins
+         * (see joins_existing_login())
+         */
+        inline TDSL_NODISCARD auto joined_tds_version() const noexcept
+            -> tdsl::detail::e_tds_version {
+            return link.login_tds_version;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Record the TDS version negotiated by the login made on this
+         * session, for the sessions that join the login afterwards
+         */
+        inline void on_login(tdsl::detail::e_tds_version negotiated) noexcept {
+            link.login_tds_version = negotiated;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The PRELOGIN handshake is done by the link, on the physical connection.
+         * The sessions must not send PRELOGIN.
+         */
+        inline TDSL_NODISCARD bool negotiates_prelogin() const noexcept {
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The SMP session ID
+         */
+        inline TDSL_NODISCARD auto session_id() const noexcept -> tdsl::uint16_t {
+            return state.sid;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept {
+            return link.send(state, bufs);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline tdsl::int32_t do_send(byte_view header, byte_view message) noexcept {
+            const byte_view bufs [] = {header, message};
+            return link.send(state, tdsl::span<const byte_view>{bufs});
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline auto do_recv_some(byte_span dst_buf) noexcept -> network_io_result {
+            return link.receive(state, dst_buf);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline auto do_recv(tdsl::uint32_t transfer_exactly, byte_span dst_buf) noexcept
+            -> network_io_result {
+            if (transfer_exactly > dst_buf.size_bytes()) {
+                return tdsl::unexpected(-2);
+            }
+            tdsl::uint32_t received = {0};
+            while (received < transfer_exactly) {
+                auto r = do_recv_some(
+                    byte_span{dst_buf.data() + received, transfer_exactly - received});
+                if (not r) {
+                    return r;
+                }
+                received += static_cast<tdsl::uint32_t>(r.get());
+            }
+            return received;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline auto do_recv(tdsl::uint32_t transfer_exactly) noexcept -> network_io_result {
+            auto writer = this->network_buffer.get_writer();
+            if (writer->remaining_bytes() < transfer_exactly) {
+                return tdsl::unexpected(-2);
+            }
+            auto result = do_recv(transfer_exactly, writer->free_span());
+            if (result) {
+                writer->advance(static_cast<tdsl::ssize_t>(result.get()));
+            }
+            return result;
+        }
+
+    private:
+        link_type & link;
+        typename link_type::session_state state = {};
+        tdsl::uint8_t * buffer                  = {nullptr};
+        tdsl::uint32_t buffer_capacity          = {0};
+    };
+}} // namespace tdsl::net
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * ____________________________________________________
+ * Network implementation for tdslite using io_uring
+ * (Linux).
+ *
+ * @file   tdsl_netimpl_uring.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_NET_NETIMPL_URING_HPP
+#define TDSL_NET_NETIMPL_URING_HPP
+
+#include <tdslite-net/base/network_io_base.hpp>
+
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_expected.hpp>
+#include <tdslite/util/tdsl_buffer_object.hpp>
+
+#include <vector>
+#include <memory>
+
+namespace tdsl { namespace net {
+
+    /**
+     * Synchronous networking code for tdslite on top of io_uring.
+     *
+     * The ring is set up per connection, and the network buffer is
+     * registered to it as a fixed buffer. The receive strategy is
+     * selected by what the running kernel supports, in order:
+     *
+     *  - multishot: a single armed multishot recv keeps posting
+     *    completions into a provided buffer ring as data arrives, so
+     *    the data that is already received is consumed without a syscall.
+     *  - fixed: each read is a READ_FIXED into the registered network buffer.
+     *  - plain: each read is a RECV.
+     *
+     * The buffers of a vectored send are submitted as a chain of
+     * linked SEND SQEs with a single io_uring_enter() call.
+     */
+    struct tdsl_netimpl_uring : public network_io_base<tdsl_netimpl_uring> {
+
+        using network_io_base<tdsl_netimpl_uring>::network_io_result;
+
+        enum class e_recv_mode : tdsl::uint8_t
+        {
+            plain,
+            fixed,
+            multishot
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Default c-tor
+         */
+        TDSL_SYMBOL_VISIBLE tdsl_netimpl_uring();
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * D-tor
+         */
+        TDSL_SYMBOL_VISIBLE ~tdsl_netimpl_uring();
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to the target endpoint @p target : @p port
+         *
+         * @param [in] target Hostname or IP
+         * @param [in] port Port number
+         *
+         * @returns true_type when connected
+         * @returns -1 when socket associated with network implementation is alive, call @ref
+         * do_disconnect first
+         * @returns -2 when resolve of @p target fails
+         * @returns -3 when connection to all of the resolved endpoints fails
+         * @returns -4 when the io_uring instance cannot be created
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::expected<tdsl::traits::true_type, int>
+        do_connect(tdsl::char_view target, tdsl::uint16_t port);
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Disconnect the socket from the connected endpoint, close
+         * it and tear down the ring.
+         *
+         * @returns 0 if socket is disconnected and the class is ready for re-use
+         * @returns -1 if socket is not alive
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_disconnect() noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views @p header and @p message sequentially to the
+         * connected endpoint
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_send(byte_view header, byte_view message) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send byte_views in @p bufs sequentially to the connected endpoint,
+         * as linked SQEs
+         *
+         * @returns 0 when all buffers are sent
+         * @returns -2 when the socket is disconnected due to a send error
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::int32_t do_sendv(tdsl::span<const byte_view> bufs) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_exactly bytes from socket
+         * into network buffer.
+         *
+         * @param [in] transfer_exactly Exact amount of bytes to read
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_exactly) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read exactly @p transfer_amount bytes from socket
+         * into @p dst_buf
+         *
+         * @param [in] transfer_amount Exact amount of bytes to read
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv(tdsl::uint32_t transfer_amount,
+                                                      byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Read whatever is available in the socket into @p dst_buf
+         *
+         * Waits until at least one byte is available.
+         *
+         * @param [in] dst_buf Destination
+         */
+        TDSL_SYMBOL_VISIBLE network_io_result do_recv_some(byte_span dst_buf) noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The receive strategy of the current connection
+         */
+        TDSL_SYMBOL_VISIBLE e_recv_mode recv_mode() const noexcept;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Amount of io_uring_enter() calls made on the current connection
+         */
+        TDSL_SYMBOL_VISIBLE tdsl::size_t enter_count() const noexcept;
+
+    private:
+        // Underlying buffer
+        static constexpr tdsl::uint32_t k_buffer_size = {16384};
+        std::vector<tdsl::uint8_t> underlying_buffer{std::vector<tdsl::uint8_t>(k_buffer_size)};
+        // Type-erased io_uring state (ring, provided buffers, ...)
+        std::shared_ptr<void> ring{nullptr};
+        int socket_fd = {-1};
+    };
+
+}} // namespace tdsl::net
+
+#endif
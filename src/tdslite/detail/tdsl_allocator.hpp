@@ -84,7 +84,41 @@ namespace tdsl {
 
     // --------------------------------------------------------------------------------
 
+#if defined(TDSL_ALLOCATION_STATS_ENABLED) && TDSL_ALLOCATION_STATS_ENABLED == 1
+
+    /**
+     * Allocation statistics
+     *
+     * Counts the calls made through tdslite_malloc and tdslite_free.
+     * Only available when TDSL_ALLOCATION_STATS_ENABLED is defined as 1.
+     * The counters are not synchronized.
+     */
+    struct allocation_stats {
+        tdsl::uint32_t malloc_calls = {0};
+        tdsl::uint32_t free_calls   = {0};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Get the allocation statistics
+     *
+     * @return allocation_stats& Allocation statistics (can be reset by assigning {})
+     */
+    inline auto tdslite_allocation_stats() noexcept -> allocation_stats & {
+        static allocation_stats stats = {};
+        return stats;
+    }
+
+#define TDSL_ALLOCATION_STATS_COUNT(MEMBER) ++tdsl::tdslite_allocation_stats().MEMBER
+#else
+#define TDSL_ALLOCATION_STATS_COUNT(MEMBER)
+#endif
+
+    // --------------------------------------------------------------------------------
+
     inline TDSL_NODISCARD auto tdslite_malloc(unsigned long n_bytes) noexcept -> void * {
+        TDSL_ALLOCATION_STATS_COUNT(malloc_calls);
         return tdslite_malloc_free().a(n_bytes);
     }
 
@@ -92,6 +126,7 @@ namespace tdsl {
 
     inline auto tdslite_free(void * p, unsigned long n_bytes) noexcept -> void {
         (void) n_bytes;
+        TDSL_ALLOCATION_STATS_COUNT(free_calls);
         tdslite_malloc_free().f(p);
     }
 
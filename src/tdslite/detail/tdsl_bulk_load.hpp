@@ -0,0 +1,73 @@
+/**
+ * ____________________________________________________
+ * Bulk load (BCP) column & row producer types
+ *
+ * @file   tdsl_bulk_load.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_TDSL_BULK_LOAD_HPP
+#define TDSL_DETAIL_TDSL_BULK_LOAD_HPP
+
+#include <tdslite/detail/tdsl_data_type.hpp>
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+#include <tdslite/util/tdsl_inttypes.hpp>
+
+namespace tdsl { namespace detail {
+
+    /**
+     * A column of a bulk load, or of a table-valued parameter
+     * (see sql_parameter_tvp)
+     *
+     * The supported types are BIT, TINYINT, SMALLINT, INT, BIGINT, REAL,
+     * FLOAT, DATETIME, SMALLDATETIME, UNIQUEIDENTIFIER, (N)CHAR, (N)VARCHAR,
+     * BINARY and VARBINARY, either as the fixed length type or as the
+     * corresponding nullable type (e.g. INTNTYPE) with type_size.
+     */
+    struct sql_bulk_column {
+        // Column name (not used by the TVPs)
+        tdsl::string_view name;
+        // Column type
+        e_tds_data_type type;
+        // Length of the nullable fixed types (e.g. 4 for INTNTYPE), or the
+        // declared length of the string & binary types (in characters for
+        // NCHAR & NVARCHAR, e.g. 30 for NVARCHAR(30))
+        tdsl::uint32_t type_size;
+        // Value of the current row, set by the row producer.
+        // A value with no data (nullptr) is NULL.
+        tdsl::byte_view value;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Bulk load (and TVP) row producer function
+     *
+     * Called for each row to set the values of the columns. The values must
+     * stay valid until the next call. Returns false when there are no more rows.
+     *
+     * (uptr, columns)
+     */
+    using bulk_row_producer_fn_t = bool (*)(void *, tdsl::span<sql_bulk_column>);
+
+    // --------------------------------------------------------------------------------
+
+    enum class e_bulk_load_error_code : tdsl::uint8_t
+    {
+        // A column type is not supported
+        unsupported_column_type = 1,
+        // The server rejected the INSERT BULK statement (e.g. no such table)
+        insert_bulk_failed      = 2,
+        // A value does not fit to its column. The load is aborted, no rows are loaded.
+        invalid_value_length    = 3,
+        // The server failed to load the rows
+        bulk_load_failed        = 4,
+    };
+}} // namespace tdsl::detail
+
+#endif
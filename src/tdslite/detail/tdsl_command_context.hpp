@@ -17,12 +17,15 @@
 #include <tdslite/detail/tdsl_string_writer.hpp>
 #include <tdslite/detail/tdsl_callback.hpp>
 #include <tdslite/detail/tdsl_row.hpp>
+#include <tdslite/detail/tdsl_row_decode_plan.hpp>
 #include <tdslite/detail/tdsl_token_handler_result.hpp>
 #include <tdslite/detail/token/tds_done_token.hpp>
 #include <tdslite/detail/token/tds_info_token.hpp>
 #include <tdslite/detail/token/tds_colmetadata_token.hpp>
 #include <tdslite/detail/tdsl_data_type.hpp>
 #include <tdslite/detail/tdsl_sql_parameter.hpp>
+#include <tdslite/detail/tdsl_statement.hpp>
+#include <tdslite/detail/tdsl_bulk_load.hpp>
 #include <tdslite/detail/tdsl_tds_procedure_id.hpp>
 
 #include <tdslite/util/tdsl_span.hpp>
@@ -31,6 +34,8 @@
 #include <tdslite/util/tdsl_type_traits.hpp>
 #include <tdslite/util/tdsl_utos.hpp>
 
+#include <string.h> // needed for memcpy
+
 namespace tdsl { namespace detail {
 
     /**
@@ -49,19 +54,32 @@ namespace tdsl { namespace detail {
         // Constant reference to tdsl_row
         using row_cref             = const tdsl::tdsl_row &;
         using row_callback_fn_t    = void (*)(void *, column_metadata_cref, row_cref);
+        // (uptr, column metadata, column index, chunk, is last chunk)
+        using stream_sink_fn_t     = void (*)(void *, column_metadata_cref, tdsl::uint32_t,
+                                              tdsl::byte_view, bool);
         using execute_rpc_result   = tdsl::expected<tdsl::uint32_t, e_rpc_error_code>;
+        using execute_bulk_load_result =
+            tdsl::expected<tdsl::uint32_t, e_bulk_load_error_code>;
 
         struct command_options {
             struct {
                 tdsl::uint8_t read_colnames : 1;
                 tdsl::uint8_t reserved : 7;
-            } flags = {};
+            } flags                   = {};
+            // How long to wait for the server to respond before
+            // cancelling the command (milliseconds, 0 = no timeout)
+            tdsl::uint32_t timeout_ms = {0};
+            // Sink for the large fields (see set_stream_sink())
+            callback<void, stream_sink_fn_t> stream_sink = {};
         };
 
         struct query_result {
 
             /**
              * Number of affected rows from current query
+             *
+             * TDS 7.2+ reports 64-bit row counts; the counts that do not
+             * fit are clamped to 0xFFFFFFFF.
              */
             tdsl::uint32_t affected_rows       = {0};
 
@@ -105,11 +123,12 @@ namespace tdsl { namespace detail {
                     ctx.qstate.result.status = dt.status;
                     if (dt.status.count_valid()) {
                         // Update affected row count only when row count is valid
-                        ctx.qstate.result.affected_rows = dt.done_row_count;
+                        ctx.qstate.result.affected_rows = clamp_row_count(dt.done_row_count);
                     }
-                    TDSL_DEBUG_PRINT("cc: done token -- status %d, affected rows(%d)\n",
+                    TDSL_DEBUG_PRINT("cc: done token -- status %d, affected rows(%lu)\n",
                                                   static_cast<tdsl::uint16_t>(dt.status.value),
-                                                  dt.done_row_count);
+                                                  static_cast<unsigned long>(dt.done_row_count));
+                    ctx.handle_batch_done(dt);
                 },
                 this};
         }
@@ -137,22 +156,87 @@ namespace tdsl { namespace detail {
             row_callback_fn_t row_callback = +[](void *, const tds_colmetadata_token &,
                                                  const tdsl_row &) -> void {},
             void * rcb_uptr                = nullptr) noexcept -> query_result {
+            prepare_query(command, row_callback, rcb_uptr);
+            // Send the command
+            tds_ctx.send_tds_pdu(e_tds_message_type::sql_batch);
+            // Receive the response
+            tds_ctx.receive_tds_response(options.timeout_ms);
+
+            // The state will be updated upon receiving the response
+            return result();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the SQL batch message for query @p command into the
+         * network buffer, without sending it.
+         *
+         * The message is sent as e_tds_message_type::sql_batch. The result
+         * is available via result() after the response is received.
+         *
+         * @param [in] command SQL command to execute
+         * @param [in] row_callback Row callback function
+         * @param [in] rcb_uptr Row callback user pointer
+         */
+        template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                               struct progmem_string_view> = true>
+        inline void prepare_query(T command, row_callback_fn_t row_callback,
+                                  void * rcb_uptr) noexcept {
             // Reset query state object & reassign row callback
             qstate              = {};
             qstate.row_callback = {row_callback, rcb_uptr};
+            write_all_headers();
             // Write the SQL command
             string_writer_type::write(tds_ctx, command);
-            // Send the command
-            tds_ctx.send_tds_pdu(e_tds_message_type::sql_batch);
-            // Receive the response
-            tds_ctx.receive_tds_pdu();
+        }
 
-            // The state will be updated upon receiving the response
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Stream the large fields of the result sets to @p sink
+         *
+         * The text, ntext, image and PLP ((max) types) fields are pushed to
+         * @p sink in chunks as they arrive, instead of being delivered in
+         * the row. Therefore, the memory needed to read a row is bounded by
+         * the network buffer size regardless of the size of these fields.
+         * The sink receives a last, empty chunk when a field is complete.
+         *
+         * The streamed fields are delivered to the row callback as zero
+         * length fields, or as NULL if they are NULL. The row callback is
+         * invoked after the sink received all the fields of the row.
+         *
+         * Takes effect from the next result set on.
+         *
+         * @param [in] sink Sink function (nullptr to stop streaming)
+         * @param [in] sink_uptr Sink user pointer (optional)
+         */
+        inline void set_stream_sink(stream_sink_fn_t sink, void * sink_uptr = nullptr) noexcept {
+            options.stream_sink = {sink, sink_uptr};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The result of the last command, updated as the response is received
+         */
+        inline TDSL_NODISCARD auto result() const noexcept -> const query_result & {
             return qstate.result;
         }
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Whether the RPC message written by the last prepare_rpc() or add_rpc()
+         * is aborted, because a TVP value does not fit to its column. The server
+         * discards an aborted message, so its calls are not run.
+         */
+        inline TDSL_NODISCARD bool is_rpc_aborted() const noexcept {
+            return qstate.invalid_tvp_value;
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Perform a remote procedure call (e.g. execute a stored procedure or
          * a parameterized query)
@@ -168,8 +252,22 @@ namespace tdsl { namespace detail {
          * The result set returned by query @p command can be read by providing
          * a row callback function
          *
+         * In e_rpc_mode::prepexec mode, the statement is prepared on its first
+         * execution (sp_prepexec) and the handle returned by the server is kept
+         * per connection, keyed by @p command and the parameter declarations.
+         * The subsequent executions send only the handle and the parameter
+         * values (sp_execute). See TDSL_PREPARED_STATEMENT_CACHE_CAPACITY.
+         *
+         * The rows of the table-valued parameters (see sql_parameter_tvp) are
+         * streamed into the request as they are produced.
+         *
          * @returns e_rpc_error_code::invalid_mode if @p mode
          *          value is invalid
+         * @returns e_rpc_error_code::unsupported_parameter_type if a
+         *          parameter type is not supported
+         * @returns e_rpc_error_code::invalid_parameter_length if a TVP value
+         *          does not fit to its column. The RPC message is sent with the
+         *          IGNORE bit, so the server discards it and the call is not run.
          * @returns rows_affected if successful
          */
         template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
@@ -180,162 +278,327 @@ namespace tdsl { namespace detail {
             row_callback_fn_t row_callback = +[](void *, const tds_colmetadata_token &,
                                                  const tdsl_row &) -> void {},
             void * rcb_uptr                = nullptr) noexcept {
-            // Validate mode
-            switch (mode) {
-                // Allowed & supported modes
-                case e_rpc_mode::executesql:
-                    break;
-                case e_rpc_mode::prepexec:
-                    TDSL_NOT_YET_IMPLEMENTED;
-                    break;
-                default:
-                    return tdsl::unexpected(e_rpc_error_code::invalid_mode);
+            const auto prep_result = prepare_rpc(command, params, mode, row_callback, rcb_uptr);
+            if (not prep_result) {
+                return tdsl::unexpected(prep_result.error());
+            }
+            const auto result = send_rpc();
+            if (qstate.invalid_tvp_value) {
+                return tdsl::unexpected(e_rpc_error_code::invalid_parameter_length);
             }
+            return result;
+        }
 
-            // 0xffff means we're going to use special procedure id
-            // instead of a procedure name.
-            tds_ctx.write_le(tdsl::uint16_t{0xffff});            // procedure name length
-            tds_ctx.write_le(static_cast<tdsl::uint16_t>(mode)); // stored procedure id
-            tds_ctx.write_le(tdsl::uint16_t{0});                 // option flags
+        // --------------------------------------------------------------------------------
 
-            // sp_executesql expects @statement, @params and param values in order
+        /**
+         * Execute a statement whose parameter types are known at compile time
+         *
+         * Same as the execute_rpc() above, except the parameter declarations
+         * and the parameter TYPE_INFOs are generated at compile time.
+         *
+         * @param [in] command Command to execute
+         * @param [in] stmt Statement parameters
+         * @param [in] mode RPC execution mode
+         * @param [in] row_callback Row callback function (optional)
+         * @param [in] rcb_uptr Row callback user pointer (optional)
+         *
+         * @returns e_rpc_error_code::invalid_mode if @p mode
+         *          value is invalid
+         * @returns e_rpc_error_code::invalid_parameter_length if a
+         *          value does not fit to its declared type
+         * @returns rows_affected if successful
+         */
+        template <typename T, typename... Params,
+                  traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                   struct progmem_string_view> = true,
+                  // (avoid ambiguity with the span overload for `{}`)
+                  typename traits::enable_if<(sizeof...(Params) > 0), bool>::type = true>
+        inline execute_rpc_result execute_rpc(
+            T command, const statement<Params...> & stmt,
+            e_rpc_mode mode                = e_rpc_mode::executesql,
+            row_callback_fn_t row_callback = +[](void *, const tds_colmetadata_token &,
+                                                 const tdsl_row &) -> void {},
+            void * rcb_uptr                = nullptr) noexcept {
+            const auto prep_result = prepare_rpc(command, stmt, mode, row_callback, rcb_uptr);
+            if (not prep_result) {
+                return tdsl::unexpected(prep_result.error());
+            }
+            return send_rpc();
+        }
 
-            // Step 1:
-            // Write the SQL command
-            {
-                tds_ctx.write(tdsl::uint8_t{0}); // name len
-                tds_ctx.write(tdsl::uint8_t{0}); // status flags
-                tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::NVARCHARTYPE)); // type
-                tds_ctx.write(tdsl::uint16_t{8000});                                      // maxlen
-                tds_ctx.write(tdsl::uint8_t{0});  // collation
-                tds_ctx.write(tdsl::uint32_t{0}); // collation
-
-                // write_type_info
-
-                tds_ctx.write(
-                    static_cast<tdsl::uint16_t>(string_writer_type::calculate_write_size(command)));
-                string_writer_type::write(tds_ctx, command);
-            }
-
-            // Step 2:
-            // Write parameter decls
-            {
-                tds_ctx.write(tdsl::uint8_t{0}); // name len
-                tds_ctx.write(tdsl::uint8_t{0}); // status flags
-                tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::NVARCHARTYPE)); // type
-                tds_ctx.write(tdsl::uint16_t{8000});                                      // maxlen
-                tds_ctx.write(tdsl::uint8_t{0});  // collation
-                tds_ctx.write(tdsl::uint32_t{0}); // collation
-
-                // put a placeholder
-                auto param_decl_sz_ph  = tds_ctx.put_placeholder(tdsl::uint16_t{0});
-
-                auto cw                = string_writer_type::make_counted_writer(tds_ctx);
-                tdsl::size_t param_idx = {0};
-                for (const auto & param : params) {
-                    char utos_buf [10] = {0};
-                    // written output should look like this
-                    // @p1 int, @p2 varchar(30), @p3 int
-                    tdsl::string_view param_decl{/*str=*/"@p"};
-                    tdsl::string_view param_idx_str{tdsl::utos(param_idx++, utos_buf)};
-                    cw.write(param_decl);
-                    cw.write(param_idx_str);
-                    cw.write(" ");
-                    write_param_type_str(param, cw);
-                    write_param_len_str(param, cw);
-
-                    if (param_idx == params.size()) {
-                        break;
-                    }
-                    cw.write(",");
-                }
+        // --------------------------------------------------------------------------------
 
-                // Write parameter declaration string length (in bytes)
-                param_decl_sz_ph.write_le(static_cast<tdsl::uint16_t>(cw.get()));
+        /**
+         * Write the RPC message for @p command into the network buffer,
+         * without sending it.
+         *
+         * The message is sent as e_tds_message_type::rpc. The result
+         * is available via result() after the response is received.
+         * (The complete packets of a message with table-valued parameters
+         * are sent as the network buffer fills up. See is_rpc_aborted())
+         *
+         * @returns e_rpc_error_code::invalid_mode if @p mode
+         *          value is invalid
+         * @returns e_rpc_error_code::unsupported_parameter_type if a
+         *          parameter type is not supported
+         */
+        template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                               struct progmem_string_view> = true>
+        inline auto prepare_rpc(T command, tdsl::span<sql_parameter_binding> params,
+                                e_rpc_mode mode, row_callback_fn_t row_callback,
+                                void * rcb_uptr) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            if (not are_params_supported(params)) {
+                return tdsl::unexpected(e_rpc_error_code::unsupported_parameter_type);
             }
+            return prepare_rpc_impl(command, params, mode, row_callback, rcb_uptr);
+        }
 
-            // Write the parameter list
-            for (const auto & param : params) {
-                // We're not going to use parameter names in order
-                // to save space. Instead, we'll put the values in
-                // their declaration order.
-                tds_ctx.write_le(tdsl::uint8_t{0}); // name length
+        // --------------------------------------------------------------------------------
 
-                // I haven't able to find any use case for
-                // this (yet) so, not used ATM.
-                tds_ctx.write_le(tdsl::uint8_t{0}); // status flags
+        /**
+         * Write the RPC message for @p command with the compile-time
+         * typed statement parameters @p stmt into the network buffer,
+         * without sending it.
+         *
+         * @returns e_rpc_error_code::invalid_mode if @p mode
+         *          value is invalid
+         * @returns e_rpc_error_code::invalid_parameter_length if a
+         *          value does not fit to its declared type
+         */
+        template <typename T, typename... Params,
+                  traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                   struct progmem_string_view> = true,
+                  // (avoid ambiguity with the span overload for `{}`)
+                  typename traits::enable_if<(sizeof...(Params) > 0), bool>::type = true>
+        inline auto prepare_rpc(T command, const statement<Params...> & stmt, e_rpc_mode mode,
+                                row_callback_fn_t row_callback, void * rcb_uptr) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            if (not stmt.is_valid()) {
+                return tdsl::unexpected(e_rpc_error_code::invalid_parameter_length);
+            }
+            return prepare_rpc_impl(command, stmt, mode, row_callback, rcb_uptr);
+        }
 
-                auto type           = param.type;
-                auto type_size      = param.type_size;
+        // --------------------------------------------------------------------------------
 
-                // Data type properties
-                const auto & dprops = [&]() {
-                    const auto & props = get_data_type_props(type);
-                    // Convert fixed length data types to variable
-                    // size data types.
-                    if (not props.is_variable_size()) {
-                        type      = props.corresponding_varsize_type;
-                        type_size = props.length.fixed;
-                        return get_data_type_props(type);
-                    }
-                    return props;
-                }();
+        /**
+         * Start an RPC batch. The calls appended by add_rpc() are sent
+         * in a single RPC message by execute_rpc_batch(), so N calls
+         * take one round trip instead of N.
+         *
+         * The server executes the calls in order. The affected row count
+         * and the status of each call is put into @p results, in call order.
+         * A call that fails does not prevent the execution of the others.
+         * The rows of all calls are delivered to @p row_callback, in order.
+         *
+         * @param [in] results Storage for the per-call results. Its size is
+         *                     the maximum amount of calls in the batch.
+         * @param [in] row_callback Row callback function (optional)
+         * @param [in] rcb_uptr Row callback user pointer (optional)
+         */
+        inline void begin_rpc_batch(
+            tdsl::span<query_result> results,
+            row_callback_fn_t row_callback = +[](void *, const tds_colmetadata_token &,
+                                                 const tdsl_row &) -> void {},
+            void * rcb_uptr                = nullptr) noexcept {
+            // Reset query state object & reassign row callback
+            qstate               = {};
+            qstate.row_callback  = {row_callback, rcb_uptr};
+            qstate.batch.results = results;
+            qstate.batch.active  = {true};
+            for (auto & r : results) {
+                r = {};
+            }
+        }
 
-                tds_ctx.write_le(static_cast<tdsl::uint8_t>(type)); // type
+        // --------------------------------------------------------------------------------
 
-                auto maybe_write_collation = [&]() {
-                    if (dprops.flags.has_collation) {
-                        // put collation data as well
-                        // FIXME: Put proper collation data!
-                        tds_ctx.write_le(tdsl::uint32_t{0});
-                        tds_ctx.write_le(tdsl::uint8_t{0});
-                    }
-                };
+        /**
+         * Append an RPC call to the current RPC batch
+         *
+         * @param [in] command Command to execute
+         * @param [in] params Parameters of the command, if any
+         * @param [in] mode RPC execution mode
+         *
+         * In e_rpc_mode::prepexec mode, at most one statement is prepared per
+         * batch. The other statements that are not prepared yet are executed
+         * with sp_executesql, and prepared by a later batch.
+         *
+         * @returns e_rpc_error_code::invalid_mode if @p mode
+         *          value is invalid
+         * @returns e_rpc_error_code::unsupported_parameter_type if a
+         *          parameter type is not supported
+         * @returns e_rpc_error_code::batch_full if the batch has no
+         *          room for another call
+         */
+        template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                               struct progmem_string_view> = true>
+        inline auto add_rpc(T command, tdsl::span<sql_parameter_binding> params = {},
+                            e_rpc_mode mode = e_rpc_mode::executesql) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            if (not are_params_supported(params)) {
+                return tdsl::unexpected(e_rpc_error_code::unsupported_parameter_type);
+            }
+            return add_rpc_impl(command, params, mode);
+        }
 
-                switch (dprops.size_type) {
-                    case e_tds_data_size_type::fixed:
-                        // Do nothing.
-                        break;
-                    case e_tds_data_size_type::var_u8:
-                        tds_ctx.write_le(
-                            static_cast<tdsl::uint8_t>(type_size)); // max length - 1 byte
-                        maybe_write_collation();
-                        tds_ctx.write_le(static_cast<tdsl::uint8_t>(param.value.size_bytes()));
-                        break;
-                    case e_tds_data_size_type::var_u16:
-                        tds_ctx.write_le(
-                            static_cast<tdsl::uint16_t>(type_size)); // max length - 2 bytes
-                        maybe_write_collation();
-                        tds_ctx.write_le(static_cast<tdsl::uint16_t>(param.value.size_bytes()));
-                        break;
-                    case e_tds_data_size_type::var_u32:
-                        tds_ctx.write_le(type_size); // max length - 2 bytes
-                        maybe_write_collation();
-                        tds_ctx.write_le(static_cast<tdsl::uint32_t>(param.value.size_bytes()));
-                        break;
-                    case e_tds_data_size_type::var_precision:
-                        TDSL_NOT_YET_IMPLEMENTED;
-                        break;
-                    case e_tds_data_size_type::unknown:
-                        TDSL_CANNOT_HAPPEN;
-                        break;
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Append an RPC call with the compile-time typed statement parameters
+         * @p stmt to the current RPC batch
+         *
+         * @returns e_rpc_error_code::invalid_mode if @p mode
+         *          value is invalid
+         * @returns e_rpc_error_code::invalid_parameter_length if a
+         *          value does not fit to its declared type
+         * @returns e_rpc_error_code::batch_full if the batch has no
+         *          room for another call
+         */
+        template <typename T, typename... Params,
+                  traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                   struct progmem_string_view> = true,
+                  // (avoid ambiguity with the span overload for `{}`)
+                  typename traits::enable_if<(sizeof...(Params) > 0), bool>::type = true>
+        inline auto add_rpc(T command, const statement<Params...> & stmt,
+                            e_rpc_mode mode = e_rpc_mode::executesql) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            if (not stmt.is_valid()) {
+                return tdsl::unexpected(e_rpc_error_code::invalid_parameter_length);
+            }
+            return add_rpc_impl(command, stmt, mode);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send the calls of the current RPC batch as one RPC message
+         * and receive the responses
+         *
+         * @returns e_rpc_error_code::invalid_parameter_length if a TVP value
+         *          does not fit to its column. None of the calls is run
+         *          (see execute_rpc())
+         * @returns the total amount of rows affected by the calls. The
+         *          per-call results are in the span given to begin_rpc_batch().
+         */
+        inline execute_rpc_result execute_rpc_batch() noexcept {
+            TDSL_ASSERT_MSG(qstate.batch.active, "begin_rpc_batch() must be called first!");
+            if (qstate.batch.calls == 0) {
+                return tdsl::uint32_t{0};
+            }
+
+            const auto result = send_rpc();
+            if (qstate.invalid_tvp_value) {
+                return tdsl::unexpected(e_rpc_error_code::invalid_parameter_length);
+            }
+            if (not result) {
+                return result;
+            }
+
+            tdsl::uint64_t affected_rows = {0};
+            for (tdsl::uint32_t i = 0; i < qstate.batch.calls; i++) {
+                affected_rows += qstate.batch.results [i].affected_rows;
+            }
+            return clamp_row_count(affected_rows);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Load rows into @p table with the bulk load (BCP) protocol
+         *
+         * An `INSERT BULK` statement that describes @p columns is executed
+         * first. Then, the rows are streamed to the server in a bulk load
+         * message (COLMETADATA, ROW tokens and a DONE token), as they are
+         * produced by @p producer. The complete packets are sent as the
+         * network buffer fills up, so the memory needed is bounded by the
+         * network buffer size regardless of the amount of rows.
+         *
+         * @param [in] table Target table name (e.g. `dbo.telemetry` or `#tmp`)
+         * @param [in] columns Columns to load. The column order and the types must
+         *                     be compatible with the table. The values of each row
+         *                     are set into the columns by @p producer.
+         * @param [in] producer Row producer function
+         * @param [in] producer_uptr Row producer user pointer (optional)
+         *
+         * @returns e_bulk_load_error_code::unsupported_column_type if a column type
+         *          is not supported (see sql_bulk_column)
+         * @returns e_bulk_load_error_code::insert_bulk_failed if the server rejects
+         *          the INSERT BULK statement
+         * @returns e_bulk_load_error_code::invalid_value_length if a value does not
+         *          fit to its column. The bulk load message is sent with the IGNORE
+         *          bit, so the server discards it and none of the rows is loaded.
+         * @returns e_bulk_load_error_code::bulk_load_failed if the server fails
+         *          to load the rows
+         * @returns rows_affected (the amount of rows loaded) if successful
+         */
+        template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                               struct progmem_string_view> = true>
+        inline execute_bulk_load_result execute_bulk_load(T table,
+                                                          tdsl::span<sql_bulk_column> columns,
+                                                          bulk_row_producer_fn_t producer,
+                                                          void * producer_uptr = nullptr) noexcept {
+            for (const auto & column : columns) {
+                if (not is_bulk_column_supported(column)) {
+                    return tdsl::unexpected(e_bulk_load_error_code::unsupported_column_type);
                 }
+            }
 
-                if (param.value) {
-                    tds_ctx.write(param.value);
+            // INSERT BULK <table> (<column> <type>, ...)
+            qstate = {};
+            write_all_headers();
+            string_writer_type::write(tds_ctx, tdsl::string_view{"INSERT BULK "});
+            string_writer_type::write(tds_ctx, table);
+            auto cw = string_writer_type::make_counted_writer(tds_ctx);
+            cw.write(" (");
+            for (tdsl::size_t i = 0; i < columns.size(); i++) {
+                const auto & column = columns [i];
+                sql_parameter_binding pb{};
+                pb.type      = column.type;
+                pb.type_size = column.type_size;
+                if (i) {
+                    cw.write(",");
                 }
+                cw.write(column.name);
+                cw.write(" ");
+                write_param_type_str(pb, cw);
+                write_param_len_str(pb, cw);
+            }
+            cw.write(")");
+            tds_ctx.send_tds_pdu(e_tds_message_type::sql_batch);
+            tds_ctx.receive_tds_response(options.timeout_ms);
+            if (not qstate.result) {
+                return tdsl::unexpected(e_bulk_load_error_code::insert_bulk_failed);
             }
 
-            // Reset query state object & reassign row callback
-            qstate              = {};
-            qstate.row_callback = {row_callback, rcb_uptr};
+            // The bulk load message has no ALL_HEADERS
+            qstate = {};
+            write_bulk_colmetadata(columns);
+            bool invalid_value = {false};
+            while (producer(producer_uptr, columns)) {
+                for (const auto & column : columns) {
+                    invalid_value = invalid_value || not is_bulk_value_valid(column);
+                }
+                if (invalid_value) {
+                    // The rows before it might already be sent, so make
+                    // the server discard the whole message instead
+                    tds_ctx.set_ignore_message();
+                    break;
+                }
+                write_bulk_row(columns);
+            }
+            write_bulk_done();
+            tds_ctx.send_tds_pdu(e_tds_message_type::bulk_load_data);
+            tds_ctx.receive_tds_response(options.timeout_ms);
 
-            // Send the command
-            tds_ctx.send_tds_pdu(e_tds_message_type::rpc);
-            // Receive the response
-            tds_ctx.receive_tds_pdu();
-            TDSL_DEBUG_PRINT("rows affected %d", qstate.result.affected_rows);
-            // The state will be updated upon receiving the response
+            if (invalid_value) {
+                return tdsl::unexpected(e_bulk_load_error_code::invalid_value_length);
+            }
+            if (not qstate.result) {
+                return tdsl::unexpected(e_bulk_load_error_code::bulk_load_failed);
+            }
             return tdsl::uint32_t{qstate.result.affected_rows};
         }
 
@@ -344,13 +607,14 @@ namespace tdsl { namespace detail {
         /**
          * Token handler for command_context.
          *
-         * Handles COLMETADATA & ROW token types.
+         * Handles COLMETADATA, ROW, NBCROW & RETURNVALUE token types.
          *
          * @param [in] uptr User-ptr (command context instance)
          * @param [in] token_type Type of the token to handle
          * @param [in] rr Binary reader
          *
-         * @returns token-specific handler result for COLMETADATA & ROW tokens
+         * @returns token-specific handler result for COLMETADATA, ROW, NBCROW & RETURNVALUE
+         *          tokens
          * @returns default token handler result, which is `unhandled`
          */
         static TDSL_NODISCARD token_handler_result
@@ -363,33 +627,955 @@ namespace tdsl { namespace detail {
                     return self.handle_colmetadata_token(rr);
                 case e_tds_message_token_type::row:
                     return self.handle_row_token(rr);
+                case e_tds_message_token_type::nbcrow:
+                    return self.handle_row_token(rr, /*has_null_bitmap=*/true);
+                case e_tds_message_token_type::returnvalue:
+                    return self.handle_returnvalue_token(rr);
                 default:
                     return {};
             }
-            TDSL_UNREACHABLE;
+            TDSL_UNREACHABLE;
+        }
+
+    private:
+        // PLP total length value that represents NULL
+        static constexpr tdsl::uint64_t k_plp_null = 0xFFFFFFFFFFFFFFFF;
+
+        /**
+         * The query state object.
+         */
+        struct query_state {
+            /**
+             * Column metadata for current query (if applicable)
+             */
+            tds_colmetadata_token colmd                    = {};
+
+            query_result result                            = {};
+
+            /**
+             * Field storage for the rows of the current result set.
+             * Allocated once per COLMETADATA and reused for every row.
+             */
+            tdsl_row row                                   = {};
+
+            /**
+             * Decode plan for the rows of the current result set.
+             * Built once per COLMETADATA.
+             */
+            tds_row_decode_plan plan                       = {};
+
+            /**
+             * Resumable ROW parser state. Kept when a ROW token
+             * cannot be decoded completely with the bytes at hand.
+             */
+            struct row_parse_state {
+                // Index of the column to decode next
+                tdsl::uint16_t column_index       = {0};
+                // Index of the first column decoded from the current
+                // token data (non-zero only if the token continues)
+                tdsl::uint16_t segment_column     = {0};
+                // Bytes of the token occupied by the decoded columns
+                tdsl::uint32_t consumed           = {0};
+                // Start of the token data when the parser is suspended
+                const tdsl::uint8_t * token_start = {nullptr};
+                // Bytes of the spill buffer in use
+                tdsl::uint32_t spilled            = {0};
+                // The start of the token is consumed while a field was
+                // being streamed. The previous fields are in the spill buffer.
+                bool continued                    = {false};
+
+                struct {
+                    // A field is being streamed (column_index)
+                    bool active              = {false};
+                    // The field is a PLP stream
+                    bool plp                 = {false};
+                    // Remaining bytes of the current chunk
+                    tdsl::uint32_t remaining = {0};
+                } stream = {};
+            } row_parse                                    = {};
+
+            /**
+             * The statement that is being prepared by sp_prepexec
+             */
+            struct {
+                // The handle is expected in a RETURNVALUE token
+                bool awaiting_handle = {false};
+                // Key of the statement
+                statement_key key    = {};
+            } prepared                                     = {};
+
+            /**
+             * RPC batch state (see begin_rpc_batch())
+             */
+            struct {
+                // Per-call results, in call order
+                tdsl::span<query_result> results = {};
+                // Amount of calls in the request
+                tdsl::uint32_t calls             = {0};
+                // Index of the call whose response is being received
+                tdsl::uint32_t current           = {0};
+                // Amount of DONEPROC tokens of the calls made by tdslite
+                // itself (sp_unprepare) before the next call
+                tdsl::uint32_t skip_procs        = {0};
+                bool active                      = {false};
+            } batch                                        = {};
+
+            /**
+             * A value of a table-valued parameter does not fit to
+             * its column, so the RPC message is aborted
+             */
+            bool invalid_tvp_value                         = {false};
+
+            /**
+             * If the query returns a result set, this is the
+             * function to be called for every row read from
+             * the result set.
+             */
+            callback<void, row_callback_fn_t> row_callback = {};
+
+        } qstate = {};
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the RPC message for @p command and @p params into the network buffer
+         *
+         * @tparam T String view type
+         * @tparam P Parameter source type (parameter bindings or statement)
+         */
+        template <typename T, typename P>
+        inline auto prepare_rpc_impl(T command, const P & params, e_rpc_mode mode,
+                                     row_callback_fn_t row_callback, void * rcb_uptr) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            // Validate mode
+            switch (mode) {
+                // Allowed & supported modes
+                case e_rpc_mode::executesql:
+                case e_rpc_mode::prepexec:
+                    break;
+                default:
+                    return tdsl::unexpected(e_rpc_error_code::invalid_mode);
+            }
+
+            // Reset query state object & reassign row callback
+            qstate              = {};
+            qstate.row_callback = {row_callback, rcb_uptr};
+
+            write_all_headers();
+            write_rpc_call(command, params, mode);
+            return tdsl::traits::true_type{};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write an RPC request for @p command and @p params into the network buffer,
+         * preceded by the release of the handle evicted from the prepared statement
+         * cache, if any.
+         *
+         * @tparam T String view type
+         * @tparam P Parameter source type (parameter bindings or statement)
+         */
+        template <typename T, typename P>
+        inline void write_rpc_call(T command, const P & params, e_rpc_mode mode) noexcept {
+            auto & prepared_statements = tds_ctx.prepared_statements;
+
+            // Release the handle evicted from the prepared statement cache
+            // first. The calls in an RPC batch are executed in order.
+            if (prepared_statements.has_unprepare_pending()) {
+                // sp_unprepare expects @handle
+                write_rpc_header(e_proc_id::sp_unprepare);
+                write_handle_param(prepared_statements.take_unprepare_pending());
+                write_rpc_batch_separator();
+                // Its result is not one of the caller's
+                qstate.batch.skip_procs++;
+            }
+
+            const bool prepexec  = (mode == e_rpc_mode::prepexec);
+            tdsl::int32_t handle = {0};
+
+            const statement_key_writer<T, P> key{command, params};
+
+            if (prepexec && prepared_statements.find(key, handle)) {
+                // sp_execute expects @handle and param values in order
+                write_rpc_header(e_proc_id::sp_execute);
+                write_handle_param(handle);
+            }
+            else if (prepexec && not qstate.prepared.awaiting_handle &&
+                     qstate.prepared.key.assign(key)) {
+                // sp_prepexec expects @handle (output), @params, @statement
+                // and param values in order. The server returns the handle
+                // in a RETURNVALUE token.
+                write_rpc_header(e_proc_id::sp_prepexec);
+                write_handle_param(handle, /*output=*/true);
+                write_param_decls(params);
+                write_statement_param(command);
+                qstate.prepared.awaiting_handle = {true};
+            }
+            else {
+                // sp_executesql expects @statement, @params and param values in order.
+                // (A statement is prepared at most once per request, the others of
+                // an RPC batch are executed directly until they are prepared. So is
+                // a statement whose key cannot be allocated.)
+                write_rpc_header(e_proc_id::sp_executesql);
+                write_statement_param(command);
+                write_param_decls(params);
+            }
+
+            write_param_values(params);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Append an RPC call for @p command and @p params to the current RPC batch
+         *
+         * @tparam T String view type
+         * @tparam P Parameter source type (parameter bindings or statement)
+         */
+        template <typename T, typename P>
+        inline auto add_rpc_impl(T command, const P & params, e_rpc_mode mode) noexcept
+            -> tdsl::expected<tdsl::traits::true_type, e_rpc_error_code> {
+            TDSL_ASSERT_MSG(qstate.batch.active, "begin_rpc_batch() must be called first!");
+
+            switch (mode) {
+                case e_rpc_mode::executesql:
+                case e_rpc_mode::prepexec:
+                    break;
+                default:
+                    return tdsl::unexpected(e_rpc_error_code::invalid_mode);
+            }
+
+            auto & batch = qstate.batch;
+            if (batch.calls == batch.results.size()) {
+                return tdsl::unexpected(e_rpc_error_code::batch_full);
+            }
+
+            if (batch.calls == 0) {
+                write_all_headers();
+            }
+            else {
+                write_rpc_batch_separator();
+            }
+            write_rpc_call(command, params, mode);
+            batch.calls++;
+            return tdsl::traits::true_type{};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Narrow a (64-bit, TDS 7.2+) row count to the result type,
+         * saturating instead of wrapping around
+         */
+        static inline TDSL_NODISCARD tdsl::uint32_t
+        clamp_row_count(tdsl::uint64_t row_count) noexcept {
+            return row_count > 0xFFFFFFFF ? 0xFFFFFFFF : static_cast<tdsl::uint32_t>(row_count);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Route DONE, DONEINPROC & DONEPROC tokens to the result of the
+         * RPC batch call they belong to. Each call ends with a DONEPROC.
+         *
+         * @param [in] dt The DONE token
+         */
+        inline void handle_batch_done(const tds_done_token & dt) noexcept {
+            auto & batch = qstate.batch;
+            if (not batch.active) {
+                return;
+            }
+
+            if (batch.skip_procs) {
+                batch.skip_procs -= (dt.proc ? 1 : 0);
+                return;
+            }
+
+            if (batch.current == batch.calls) {
+                return;
+            }
+
+            // Keep the error flags of the previous statements of the call
+            constexpr tdsl::uint16_t k_error_flags = 0x2 | 0x100;
+            auto & r                               = batch.results [batch.current];
+            r.status.value =
+                static_cast<tdsl::uint16_t>(dt.status.value | (r.status.value & k_error_flags));
+            if (dt.status.count_valid()) {
+                r.affected_rows = clamp_row_count(dt.done_row_count);
+            }
+            batch.current += (dt.proc ? 1 : 0);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The wire format of a bulk load column
+         */
+        struct bulk_column_info {
+            // Type in COLMETADATA (the nullable type for the fixed types)
+            e_tds_data_type type;
+            // Maximum length of a value (bytes)
+            tdsl::uint16_t max_length;
+            // The values have a 16-bit length (8-bit otherwise)
+            bool u16_length;
+            bool has_collation;
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Get the wire format of bulk load column @p column
+         */
+        static inline TDSL_NODISCARD bulk_column_info
+        get_bulk_column_info(const sql_bulk_column & column) noexcept {
+            const auto & props = get_data_type_props(column.type);
+            bulk_column_info result{column.type, 0, false, props.flags.has_collation};
+            switch (props.size_type) {
+                case e_tds_data_size_type::fixed:
+                    result.type       = props.corresponding_varsize_type;
+                    result.max_length = props.length.fixed;
+                    break;
+                case e_tds_data_size_type::var_u8:
+                    result.max_length = static_cast<tdsl::uint16_t>(
+                        column.type == e_tds_data_type::GUIDTYPE ? 16 : column.type_size);
+                    break;
+                case e_tds_data_size_type::var_u16: {
+                    const bool wide = column.type == e_tds_data_type::NVARCHARTYPE ||
+                                      column.type == e_tds_data_type::NCHARTYPE;
+                    result.max_length =
+                        static_cast<tdsl::uint16_t>(column.type_size * (wide ? 2 : 1));
+                    result.u16_length = {true};
+                } break;
+                default:
+                    break;
+            }
+            return result;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether bulk load column @p column has a supported type & length
+         */
+        static inline TDSL_NODISCARD bool
+        is_bulk_column_supported(const sql_bulk_column & column) noexcept {
+            const auto size = column.type_size;
+            switch (column.type) {
+                case e_tds_data_type::BITTYPE:
+                case e_tds_data_type::INT1TYPE:
+                case e_tds_data_type::INT2TYPE:
+                case e_tds_data_type::INT4TYPE:
+                case e_tds_data_type::INT8TYPE:
+                case e_tds_data_type::FLT4TYPE:
+                case e_tds_data_type::FLT8TYPE:
+                case e_tds_data_type::DATETIM4TYPE:
+                case e_tds_data_type::DATETIMETYPE:
+                case e_tds_data_type::GUIDTYPE:
+                    return true;
+                case e_tds_data_type::INTNTYPE:
+                    return size == 1 || size == 2 || size == 4 || size == 8;
+                case e_tds_data_type::FLTNTYPE:
+                case e_tds_data_type::DATETIMNTYPE:
+                    return size == 4 || size == 8;
+                case e_tds_data_type::NCHARTYPE:
+                case e_tds_data_type::NVARCHARTYPE:
+                    return size > 0 && size <= 4000;
+                case e_tds_data_type::BIGCHARTYPE:
+                case e_tds_data_type::BIGVARCHRTYPE:
+                case e_tds_data_type::BIGBINARYTYPE:
+                case e_tds_data_type::BIGVARBINTYPE:
+                    return size > 0 && size <= 8000;
+                default:
+                    return false;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the current value of bulk load column @p column fits to the column
+         */
+        static inline TDSL_NODISCARD bool
+        is_bulk_value_valid(const sql_bulk_column & column) noexcept {
+            if (column.value.data() == nullptr) {
+                return true;
+            }
+            const auto info = get_bulk_column_info(column);
+            // The fixed length values must be complete
+            return info.u16_length ? column.value.size_bytes() <= info.max_length
+                                   : column.value.size_bytes() == info.max_length;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Make room for @p amount bytes in the network buffer by sending
+         * the complete packets of the @p mtype message written so far, if needed
+         */
+        inline void stream_reserve(e_tds_message_type mtype, tdsl::size_t amount) noexcept {
+            if (tds_ctx.get_free_space() < amount) {
+                tds_ctx.flush_tds_pdu(mtype);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write @p data into the @p mtype message, sending the message
+         * written so far whenever the network buffer is full
+         */
+        inline void stream_write(e_tds_message_type mtype, tdsl::byte_view data) noexcept {
+            tdsl::size_t pos = {0};
+            while (pos < data.size_bytes()) {
+                stream_reserve(mtype, 1);
+                const auto space  = tds_ctx.get_free_space();
+                const auto remain = data.size_bytes() - pos;
+                const auto amount = remain < space ? remain : space;
+                tds_ctx.write(tdsl::byte_view{data.data() + pos, amount});
+                pos += amount;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the TYPE_INFO of a bulk load (or TVP) column
+         * (type, maximum length & collation)
+         */
+        inline void write_bulk_type_info(const bulk_column_info & info) noexcept {
+            tds_ctx.write(static_cast<tdsl::uint8_t>(info.type)); // type
+            if (info.u16_length) {
+                tds_ctx.write_le(info.max_length); // max length
+            }
+            else {
+                tds_ctx.write(static_cast<tdsl::uint8_t>(info.max_length)); // max length
+            }
+            if (info.has_collation) {
+                // FIXME: Put proper collation data!
+                tds_ctx.write_le(tdsl::uint32_t{0});
+                tds_ctx.write_le(tdsl::uint8_t{0});
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the current values of @p columns (the data of a ROW or
+         * a TVP_ROW token) into the @p mtype message
+         */
+        inline void write_bulk_values(e_tds_message_type mtype,
+                                      tdsl::span<sql_bulk_column> columns) noexcept {
+            for (const auto & column : columns) {
+                const auto info    = get_bulk_column_info(column);
+                const bool is_null = (column.value.data() == nullptr);
+                stream_reserve(mtype, 2);
+                if (info.u16_length) {
+                    // NULL is represented by a length of 0xFFFF
+                    tds_ctx.write_le(is_null ? tdsl::uint16_t{0xFFFF}
+                                             : static_cast<tdsl::uint16_t>(
+                                                   column.value.size_bytes()));
+                }
+                else {
+                    // NULL is represented by a length of zero
+                    tds_ctx.write(static_cast<tdsl::uint8_t>(column.value.size_bytes()));
+                }
+                stream_write(mtype, column.value);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the COLMETADATA token of a bulk load for @p columns
+         */
+        inline void write_bulk_colmetadata(tdsl::span<sql_bulk_column> columns) noexcept {
+            constexpr auto k_mtype = e_tds_message_type::bulk_load_data;
+            // UserType is 4 bytes since TDS 7.2
+            const bool tds72       = tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005);
+
+            stream_reserve(k_mtype, 3);
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_message_token_type::colmetadata));
+            tds_ctx.write_le(static_cast<tdsl::uint16_t>(columns.size()));
+            for (const auto & column : columns) {
+                stream_reserve(k_mtype, 4 + 2 + 3 + 5 + 1 + column.name.size_bytes() * 2);
+                if (tds72) {
+                    tds_ctx.write_le(tdsl::uint32_t{0}); // user type
+                }
+                else {
+                    tds_ctx.write_le(tdsl::uint16_t{0}); // user type
+                }
+                tds_ctx.write_le(tdsl::uint16_t{0x0001}); // flags (nullable)
+                write_bulk_type_info(get_bulk_column_info(column));
+                tds_ctx.write(static_cast<tdsl::uint8_t>(column.name.size())); // name length
+                string_writer_type::write(tds_ctx, column.name);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write a ROW token of a bulk load with the current values of @p columns
+         */
+        inline void write_bulk_row(tdsl::span<sql_bulk_column> columns) noexcept {
+            stream_reserve(e_tds_message_type::bulk_load_data, 1);
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_message_token_type::row));
+            write_bulk_values(e_tds_message_type::bulk_load_data, columns);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the DONE token that ends a bulk load
+         */
+        inline void write_bulk_done() noexcept {
+            stream_reserve(e_tds_message_type::bulk_load_data, 13);
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_message_token_type::done));
+            tds_ctx.write_le(tdsl::uint16_t{0}); // status
+            tds_ctx.write_le(tdsl::uint16_t{0}); // current command
+            // The row count is 64-bit since TDS 7.2
+            if (tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005)) {
+                tds_ctx.write_le(tdsl::uint64_t{0});
+            }
+            else {
+                tds_ctx.write_le(tdsl::uint32_t{0});
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the parameter types of @p params are supported. Only the
+         * table-valued parameters are checked, as they cannot be rejected
+         * once their rows are being sent.
+         */
+        inline TDSL_NODISCARD bool
+        are_params_supported(tdsl::span<sql_parameter_binding> params) const noexcept {
+            for (const auto & param : params) {
+                if (not(param.type == e_tds_data_type::TVPTYPE)) {
+                    continue;
+                }
+                // TVPs are available since TDS 7.3
+                if (not tds_ctx.tds_version_at_least(e_tds_version::sql_server_2008)) {
+                    return false;
+                }
+                const auto & tvp = sql_parameter_tvp::from_binding(param);
+                if (tvp.columns.size() == 0 || tvp.producer == nullptr) {
+                    return false;
+                }
+                for (const auto & column : tvp.columns) {
+                    if (not is_bulk_column_supported(column)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the TYPE_INFO & the rows of table-valued parameter @p tvp
+         * (TVP_TYPENAME, TVP_COLMETADATA, TVP_END, TVP_ROW..., TVP_END),
+         * sending the RPC message written so far whenever the network
+         * buffer is full.
+         *
+         * A row with a value that does not fit to its column ends the
+         * rows, and the request is marked as invalid.
+         */
+        inline void write_tvp_value(const sql_parameter_tvp & tvp) noexcept {
+            constexpr auto k_mtype                  = e_tds_message_type::rpc;
+            constexpr tdsl::uint8_t k_tvp_end_token = 0x00;
+
+            // Split `schema.name`
+            const auto & type_name                  = tvp.type_name;
+            tdsl::size_t dot                        = type_name.size();
+            for (tdsl::size_t i = 0; i < type_name.size(); i++) {
+                if (type_name [i] == '.') {
+                    dot = i;
+                }
+            }
+            const bool has_schema          = dot < type_name.size();
+            const tdsl::size_t name_offset = has_schema ? dot + 1 : 0;
+            const tdsl::string_view schema{type_name.data(), has_schema ? dot : 0};
+            const tdsl::string_view name{type_name.data() + name_offset,
+                                         type_name.size() - name_offset};
+
+            auto write_b_varchar = [&](tdsl::string_view sv) {
+                stream_reserve(k_mtype, 1 + sv.size_bytes() * 2);
+                tds_ctx.write(static_cast<tdsl::uint8_t>(sv.size())); // length
+                string_writer_type::write(tds_ctx, sv);
+            };
+
+            // TVP_TYPENAME
+            stream_reserve(k_mtype, 2);
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::TVPTYPE)); // type
+            tds_ctx.write(tdsl::uint8_t{0});                                      // db name
+            write_b_varchar(schema);
+            write_b_varchar(name);
+
+            // TVP_COLMETADATA
+            stream_reserve(k_mtype, 2);
+            tds_ctx.write_le(static_cast<tdsl::uint16_t>(tvp.columns.size()));
+            for (const auto & column : tvp.columns) {
+                stream_reserve(k_mtype, 4 + 2 + 3 + 5 + 1);
+                tds_ctx.write_le(tdsl::uint32_t{0});      // user type
+                tds_ctx.write_le(tdsl::uint16_t{0x0001}); // flags (nullable)
+                write_bulk_type_info(get_bulk_column_info(column));
+                tds_ctx.write(tdsl::uint8_t{0}); // column name (must be empty)
+            }
+            // (no optional metadata)
+            stream_reserve(k_mtype, 1);
+            tds_ctx.write(k_tvp_end_token);
+
+            while (tvp.producer(tvp.producer_uptr, tvp.columns)) {
+                bool invalid_value = {false};
+                for (const auto & column : tvp.columns) {
+                    invalid_value = invalid_value || not is_bulk_value_valid(column);
+                }
+                if (invalid_value) {
+                    // The packets before it might already be sent, so make
+                    // the server discard the whole message instead
+                    qstate.invalid_tvp_value = {true};
+                    tds_ctx.set_ignore_message();
+                    break;
+                }
+                stream_reserve(k_mtype, 1);
+                tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_message_token_type::tvp_row));
+                write_bulk_values(k_mtype, tvp.columns);
+            }
+            stream_reserve(k_mtype, 1);
+            tds_ctx.write(k_tvp_end_token);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send the RPC message in the network buffer and receive the response
+         *
+         * @returns rows_affected
+         */
+        inline execute_rpc_result send_rpc() noexcept {
+            // Send the command
+            tds_ctx.send_tds_pdu(e_tds_message_type::rpc);
+            // Receive the response
+            tds_ctx.receive_tds_response(options.timeout_ms);
+            TDSL_DEBUG_PRINT("rows affected %d", qstate.result.affected_rows);
+            // The state will be updated upon receiving the response
+            return tdsl::uint32_t{qstate.result.affected_rows};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the ALL_HEADERS section that precedes the SQLBatch
+         * and RPC messages since TDS 7.2.
+         *
+         * Only the (mandatory) transaction descriptor header is written.
+         */
+        inline void write_all_headers() noexcept {
+            if (not tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005)) {
+                return;
+            }
+            constexpr tdsl::uint32_t k_txn_descriptor_header_size = 18;
+            constexpr tdsl::uint16_t k_txn_descriptor_header_type = 2;
+            constexpr tdsl::uint32_t k_all_headers_size =
+                sizeof(tdsl::uint32_t) + k_txn_descriptor_header_size;
+
+            tds_ctx.write_le(k_all_headers_size);                       // total length
+            tds_ctx.write_le(k_txn_descriptor_header_size);             // header length
+            tds_ctx.write_le(k_txn_descriptor_header_type);             // header type
+            tds_ctx.write_le(tds_ctx.current_transaction_descriptor()); // transaction descriptor
+            tds_ctx.write_le(tdsl::uint32_t{1});                        // outstanding requests
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the header of an RPC request for special procedure @p proc
+         *
+         * @param [in] proc Special procedure id
+         */
+        inline void write_rpc_header(e_proc_id proc) noexcept {
+            // 0xffff means we're going to use special procedure id
+            // instead of a procedure name.
+            tds_ctx.write_le(tdsl::uint16_t{0xffff});            // procedure name length
+            tds_ctx.write_le(static_cast<tdsl::uint16_t>(proc)); // stored procedure id
+            tds_ctx.write_le(tdsl::uint16_t{0});                 // option flags
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the separator between two RPC requests of an RPC batch
+         */
+        inline void write_rpc_batch_separator() noexcept {
+            // BatchFlag is 0xFF since TDS 7.2, 0x80 before
+            const bool tds72 = tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005);
+            tds_ctx.write(tds72 ? tdsl::uint8_t{0xFF} : tdsl::uint8_t{0x80});
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write a prepared statement handle (INT) parameter
+         *
+         * @param [in] handle The handle
+         * @param [in] output Write as an output parameter with a NULL value
+         */
+        inline void write_handle_param(tdsl::int32_t handle, bool output = false) noexcept {
+            constexpr tdsl::uint8_t k_by_ref_value = 0x01;
+            constexpr tdsl::uint8_t k_handle_size  = sizeof(tdsl::int32_t);
+            tds_ctx.write(tdsl::uint8_t{0});                                     // name len
+            tds_ctx.write(output ? k_by_ref_value : tdsl::uint8_t{0});           // status flags
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::INTNTYPE)); // type
+            tds_ctx.write(k_handle_size);                                        // maxlen
+            if (output) {
+                tds_ctx.write(tdsl::uint8_t{0}); // NULL
+                return;
+            }
+            tds_ctx.write(k_handle_size);
+            tds_ctx.write_le(handle);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the SQL command @p command as an NVARCHAR parameter
+         *
+         * @param [in] command SQL command
+         */
+        template <typename T>
+        inline void write_statement_param(T command) noexcept {
+            tds_ctx.write(tdsl::uint8_t{0}); // name len
+            tds_ctx.write(tdsl::uint8_t{0}); // status flags
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::NVARCHARTYPE)); // type
+            tds_ctx.write(tdsl::uint16_t{8000});                                      // maxlen
+            tds_ctx.write(tdsl::uint8_t{0});  // collation
+            tds_ctx.write(tdsl::uint32_t{0}); // collation
+
+            tds_ctx.write(
+                static_cast<tdsl::uint16_t>(string_writer_type::calculate_write_size(command)));
+            string_writer_type::write(tds_ctx, command);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the declarations of @p params (e.g. `@p0 INT,@p1 NVARCHAR(30)`)
+         * as an NVARCHAR parameter
+         *
+         * @param [in] params Parameters
+         */
+        inline void write_param_decls(tdsl::span<sql_parameter_binding> params) noexcept {
+            tds_ctx.write(tdsl::uint8_t{0}); // name len
+            tds_ctx.write(tdsl::uint8_t{0}); // status flags
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::NVARCHARTYPE)); // type
+            tds_ctx.write(tdsl::uint16_t{8000});                                      // maxlen
+            tds_ctx.write(tdsl::uint8_t{0});  // collation
+            tds_ctx.write(tdsl::uint32_t{0}); // collation
+
+            // put a placeholder
+            auto param_decl_sz_ph = tds_ctx.put_placeholder(tdsl::uint16_t{0});
+
+            auto cw               = string_writer_type::make_counted_writer(tds_ctx);
+            write_param_decl_str(params, cw);
+
+            // Write parameter declaration string length (in bytes)
+            param_decl_sz_ph.write_le(static_cast<tdsl::uint16_t>(cw.get()));
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the declarations of @p params (e.g. `@p0 INT,@p1 NVARCHAR(30)`) to @p w
+         *
+         * @param [in] params Parameters
+         * @param [in] w Target writer
+         */
+        template <typename W>
+        static inline void write_param_decl_str(tdsl::span<sql_parameter_binding> params,
+                                                W & w) noexcept {
+            tdsl::size_t param_idx = {0};
+            for (const auto & param : params) {
+                char utos_buf [10] = {0};
+                // written output should look like this
+                // @p1 int, @p2 varchar(30), @p3 int
+                tdsl::string_view param_decl{/*str=*/"@p"};
+                tdsl::string_view param_idx_str{tdsl::utos(param_idx++, utos_buf)};
+                w.write(param_decl);
+                w.write(param_idx_str);
+                w.write(" ");
+                write_param_type_str(param, w);
+                write_param_len_str(param, w);
+
+                if (param_idx == params.size()) {
+                    break;
+                }
+                w.write(",");
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Writes the key of the prepared statement for the SQL command
+         * @p command and the declarations of @p params (see statement_key)
+         *
+         * The key starts with the length of the command, so the boundary
+         * between the command and the declarations is part of it.
+         *
+         * @tparam T String view type
+         * @tparam P Parameter source type (parameter bindings or statement)
+         */
+        template <typename T, typename P>
+        struct statement_key_writer {
+            const T & command;
+            const P & params;
+
+            template <typename Sink>
+            inline void operator()(Sink & sink) const noexcept {
+                sink.put(static_cast<char16_t>(command.size()));
+                sink.write_units(command);
+                write_decls(sink, params);
+            }
+
+        private:
+            template <typename Sink>
+            static inline void write_decls(Sink & sink,
+                                           tdsl::span<sql_parameter_binding> params) noexcept {
+                write_param_decl_str(params, sink);
+            }
+
+            template <typename Sink, typename... Params>
+            static inline void write_decls(Sink & sink,
+                                           const statement<Params...> & stmt) noexcept {
+                // UTF-16LE
+                const auto decl = stmt.declaration();
+                for (tdsl::size_t i = 0; i + 1 < decl.size(); i += 2) {
+                    sink.put(static_cast<char16_t>(decl [i] | (decl [i + 1] << 8)));
+                }
+            }
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the compile-time declarations of statement @p stmt
+         * as an NVARCHAR parameter
+         */
+        template <typename... Params>
+        inline void write_param_decls(const statement<Params...> & stmt) noexcept {
+            tds_ctx.write(tdsl::uint8_t{0}); // name len
+            tds_ctx.write(tdsl::uint8_t{0}); // status flags
+            tds_ctx.write(static_cast<tdsl::uint8_t>(e_tds_data_type::NVARCHARTYPE)); // type
+            tds_ctx.write(tdsl::uint16_t{8000});                                      // maxlen
+            tds_ctx.write(tdsl::uint8_t{0});  // collation
+            tds_ctx.write(tdsl::uint32_t{0}); // collation
+
+            const auto decl = stmt.declaration();
+            tds_ctx.write_le(static_cast<tdsl::uint16_t>(decl.size_bytes()));
+            if (decl.size_bytes()) {
+                tds_ctx.write(decl);
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the values of statement @p stmt in their declaration order
+         */
+        template <typename... Params>
+        inline void write_param_values(const statement<Params...> & stmt) noexcept {
+            stmt.write_values(tds_ctx);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Write the values of @p params in their declaration order
+         *
+         * @param [in] params Parameters
+         */
+        inline void write_param_values(tdsl::span<sql_parameter_binding> params) noexcept {
+            for (const auto & param : params) {
+                // We're not going to use parameter names in order
+                // to save space. Instead, we'll put the values in
+                // their declaration order.
+                tds_ctx.write_le(tdsl::uint8_t{0}); // name length
+
+                // I haven't able to find any use case for
+                // this (yet) so, not used ATM.
+                tds_ctx.write_le(tdsl::uint8_t{0}); // status flags
+
+                if (param.type == e_tds_data_type::TVPTYPE) {
+                    write_tvp_value(sql_parameter_tvp::from_binding(param));
+                    continue;
+                }
+
+                auto type           = param.type;
+                auto type_size      = param.type_size;
+
+                // Data type properties
+                const auto & dprops = [&]() {
+                    const auto & props = get_data_type_props(type);
+                    // Convert fixed length data types to variable
+                    // size data types.
+                    if (not props.is_variable_size()) {
+                        type      = props.corresponding_varsize_type;
+                        type_size = props.length.fixed;
+                        return get_data_type_props(type);
+                    }
+                    return props;
+                }();
+
+                tds_ctx.write_le(static_cast<tdsl::uint8_t>(type)); // type
+
+                auto maybe_write_collation = [&]() {
+                    if (dprops.flags.has_collation) {
+                        // put collation data as well
+                        // FIXME: Put proper collation data!
+                        tds_ctx.write_le(tdsl::uint32_t{0});
+                        tds_ctx.write_le(tdsl::uint8_t{0});
+                    }
+                };
+
+                switch (dprops.size_type) {
+                    case e_tds_data_size_type::fixed:
+                        // Do nothing.
+                        break;
+                    case e_tds_data_size_type::var_u8:
+                        tds_ctx.write_le(
+                            static_cast<tdsl::uint8_t>(type_size)); // max length - 1 byte
+                        maybe_write_collation();
+                        tds_ctx.write_le(static_cast<tdsl::uint8_t>(param.value.size_bytes()));
+                        break;
+                    case e_tds_data_size_type::var_u16:
+                        tds_ctx.write_le(
+                            static_cast<tdsl::uint16_t>(type_size)); // max length - 2 bytes
+                        maybe_write_collation();
+                        tds_ctx.write_le(static_cast<tdsl::uint16_t>(param.value.size_bytes()));
+                        break;
+                    case e_tds_data_size_type::var_u32:
+                        tds_ctx.write_le(type_size); // max length - 2 bytes
+                        maybe_write_collation();
+                        tds_ctx.write_le(static_cast<tdsl::uint32_t>(param.value.size_bytes()));
+                        break;
+                    case e_tds_data_size_type::var_precision:
+                    case e_tds_data_size_type::var_scale:
+                        TDSL_NOT_YET_IMPLEMENTED;
+                        break;
+                    case e_tds_data_size_type::unknown:
+                        TDSL_CANNOT_HAPPEN;
+                        break;
+                }
+
+                if (param.value) {
+                    tds_ctx.write(param.value);
+                }
+            }
         }
 
-    private:
-        /**
-         * The query state object.
-         */
-        struct query_state {
-            /**
-             * Column metadata for current query (if applicable)
-             */
-            tds_colmetadata_token colmd                    = {};
-
-            query_result result                            = {};
-
-            /**
-             * If the query returns a result set, this is the
-             * function to be called for every row read from
-             * the result set.
-             */
-            callback<void, row_callback_fn_t> row_callback = {};
-
-        } qstate = {};
-
         // --------------------------------------------------------------------------------
 
         /**
@@ -416,6 +1602,13 @@ namespace tdsl { namespace detail {
                 return result;
             }
 
+            // Release the metadata & row storage of the previous result set (or,
+            // the partially read metadata from the previous attempt), if any.
+            qstate.colmd            = {};
+            qstate.row              = {};
+            qstate.plan             = {};
+            qstate.row_parse        = {};
+
             // Read colum count, try to allocate memory for N columns
             const auto column_count = rr.read<tdsl::uint16_t>();
             if (not qstate.colmd.allocate_colinfo_array(column_count)) {
@@ -440,15 +1633,21 @@ namespace tdsl { namespace detail {
                 }
             }
 
+            // UserType is 4 bytes since TDS 7.2
+            const bool wide_user_type =
+                tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005);
+
             // Absolute minimum COLMETADATA bytes, regardless of data type
-            static constexpr auto k_colinfo_min_bytes = 6; // user_type + flags + type + colname len
+            // (user_type + flags + type + colname len)
+            const tdsl::uint32_t colinfo_min_bytes = wide_user_type ? 8 : 6;
 
-            tdsl::uint16_t colindex                   = 0;
+            tdsl::uint16_t colindex                = 0;
 
             // Main column metadata read loop
-            while (colindex < column_count && rr.has_bytes(k_colinfo_min_bytes)) {
+            while (colindex < column_count && rr.has_bytes(colinfo_min_bytes)) {
                 tds_column_info & current_column = qstate.colmd.columns [colindex];
-                current_column.user_type         = rr.read<tdsl::uint16_t>();
+                current_column.user_type         = wide_user_type ? rr.read<tdsl::uint32_t>()
+                                                                  : rr.read<tdsl::uint16_t>();
                 current_column.flags             = rr.read<tdsl::uint16_t>();
                 current_column.type    = static_cast<e_tds_data_type>(rr.read<tdsl::uint8_t>());
 
@@ -487,6 +1686,13 @@ namespace tdsl { namespace detail {
                         current_column.typeprops.ps.precision = rr.read<tdsl::uint8_t>();
                         current_column.typeprops.ps.scale     = rr.read<tdsl::uint8_t>();
                         break;
+                    case e_tds_data_size_type::var_scale:
+                        // Date & time types have no length in COLMETADATA,
+                        // only the scale (except DATENTYPE, which has none)
+                        if (dtype_props.flags.has_scale) {
+                            current_column.typeprops.ps.scale = rr.read<tdsl::uint8_t>();
+                        }
+                        break;
                     case e_tds_data_size_type::unknown:
 
                         TDSL_DEBUG_PRINTLN(
@@ -569,6 +1775,26 @@ namespace tdsl { namespace detail {
                 ++colindex;
             }
 
+            // Allocate the field storage for the rows of this result set
+            auto row_storage{
+                tdsl_row::make(qstate.colmd.columns.size(), tdsl_row::do_not_construct_fields{})};
+
+            if (not row_storage) {
+                TDSL_DEBUG_PRINTLN("row storage creation failed (%d)",
+                                   static_cast<int>(row_storage.error()));
+                result.status = token_handler_status::not_enough_memory;
+                return result;
+            }
+            qstate.row = TDSL_MOVE(row_storage.get());
+
+            // Pre-compute the row decode plan for this result set
+            const bool stream_large_fields = static_cast<bool>(options.stream_sink);
+            if (not qstate.plan.build(qstate.colmd.columns, stream_large_fields)) {
+                TDSL_DEBUG_PRINTLN("row decode plan creation failed");
+                result.status = token_handler_status::not_enough_memory;
+                return result;
+            }
+
             TDSL_DEBUG_PRINTLN(
                 "received COLMETADATA token -> column count [" TDSL_SIZET_FORMAT_SPECIFIER "]",
                 qstate.colmd.columns.size());
@@ -580,19 +1806,22 @@ namespace tdsl { namespace detail {
         // --------------------------------------------------------------------------------
 
         /**
-         * Handler for ROW token type
+         * Handler for ROW & NBCROW token types
          *
-         * The function parses the given data in @p rr as DONE token and calls the info
+         * The function parses the given data in @p rr as ROW token and calls the row
          * callback function, if a callback function is assigned.
          *
+         * NBCROW is a ROW token that is prefixed with a bitmap of the NULL
+         * columns. The NULL columns have no data in the token.
+         *
          * @param [in] rr Reader to read from
+         * @param [in] has_null_bitmap True if the token is an NBCROW token
          *
          * @return token_handler_result
          */
         TDSL_NODISCARD token_handler_result
-        handle_row_token(tdsl::binary_reader<tdsl::endian::little> & rr) noexcept {
-            using data_size_type        = tdsl::detail::e_tds_data_size_type;
-
+        handle_row_token(tdsl::binary_reader<tdsl::endian::little> & rr,
+                         bool has_null_bitmap = false) noexcept {
             token_handler_result result = {};
             // Invoke handler,return
             if (not qstate.colmd) {
@@ -603,31 +1832,147 @@ namespace tdsl { namespace detail {
                 return result;
             }
 
-            auto row_data{
-                tdsl_row::make(qstate.colmd.columns.size(), tdsl_row::do_not_construct_fields{})};
+            // The field storage is allocated once per COLMETADATA and
+            // reused for every row in the result set.
+            auto & row_data = qstate.row;
+            TDSL_ASSERT(row_data.size() == qstate.colmd.columns.size());
+
+            auto & rstate           = qstate.row_parse;
+            const auto token_offset = rr.offset();
+
+            // Fast path for the result sets with fixed size columns only.
+            // Every row has the same size, so the fields are at known offsets.
+            if (not has_null_bitmap && qstate.plan.is_fixed_width && rstate.column_index == 0 &&
+                rr.has_bytes(qstate.plan.fixed_row_size)) {
+                const auto row_bytes = rr.read(qstate.plan.fixed_row_size);
+                for (tdsl::uint32_t cidx = 0; cidx < qstate.colmd.columns.size(); cidx++) {
+                    const auto & step = qstate.plan [cidx];
+                    new (&row_data [cidx], placement_new_tag{})
+                        tdsl_field(qstate.colmd.columns [cidx],
+                                   row_bytes.data() + step.fixed_offset, step.fixed_size);
+                }
+                qstate.row_callback(qstate.colmd, row_data);
+                result.status       = token_handler_status::success;
+                result.needed_bytes = 0;
+                return result;
+            }
+            // Otherwise, decode the row field by field. This also
+            // handles the partial fixed-width rows.
+
+            // NBCROW: bit N of the bitmap is set if column N is NULL. The bitmap
+            // is in the spill buffer if the start of the token is consumed.
+            const tdsl::uint8_t * null_bitmap   = {nullptr};
+            const tdsl::uint32_t null_bitmap_sz = {
+                has_null_bitmap ? (static_cast<tdsl::uint32_t>(row_data.size()) + 7) / 8 : 0};
+            if (has_null_bitmap && rstate.continued) {
+                null_bitmap = qstate.plan.spill_buffer;
+            }
 
-            if (not row_data) {
-                TDSL_DEBUG_PRINTLN("row data creation failed (%d)",
-                                   static_cast<int>(row_data.error()));
-                // report error
-                result.status = token_handler_status::not_enough_memory;
+            // Save the parser state and ask for more bytes. The token data read
+            // so far stays in the buffer (the message reader is restored to the
+            // token start) but the columns that are already decoded will not be
+            // decoded again when the rest of the row arrives.
+            auto suspend = [&](tdsl::uint32_t cidx, tdsl::size_t column_offset,
+                               tdsl::size_t needed_bytes) -> token_handler_result {
+                rstate.column_index = static_cast<tdsl::uint16_t>(cidx);
+                rstate.consumed     = static_cast<tdsl::uint32_t>(column_offset - token_offset);
+                rstate.token_start  = rr.current() - (rr.offset() - token_offset);
+                result.status       = token_handler_status::not_enough_bytes;
+                result.needed_bytes = static_cast<tdsl::uint32_t>(needed_bytes);
+                return result;
+            };
+
+            // Consume the token data read so far and ask for the rest of the
+            // streamed field at column `cidx`. The decoded fields are moved to
+            // the spill buffer since their data is about to be discarded.
+            auto continue_later = [&](tdsl::uint32_t cidx,
+                                      tdsl::uint32_t needed_bytes) -> token_handler_result {
+                if (not spill_row_fields(cidx, null_bitmap, null_bitmap_sz)) {
+                    result.status = token_handler_status::not_enough_memory;
+                    return result;
+                }
+                rstate.column_index   = static_cast<tdsl::uint16_t>(cidx);
+                rstate.segment_column = static_cast<tdsl::uint16_t>(cidx);
+                rstate.consumed       = {0};
+                rstate.token_start    = {nullptr};
+                rstate.continued      = {true};
+                result.status         = token_handler_status::partially_consumed;
+                result.needed_bytes   = needed_bytes;
                 return result;
+            };
+
+            tdsl::uint32_t cidx = 0;
+
+            if (rstate.stream.active) {
+                // Continue streaming the field that we left off. The reader
+                // is positioned at the rest of the field's data.
+                cidx                        = rstate.column_index;
+                tdsl::uint32_t needed_bytes = {0};
+                if (not stream_field(cidx, rr, needed_bytes)) {
+                    return continue_later(cidx, needed_bytes);
+                }
+                new (&row_data [cidx], placement_new_tag{})
+                    tdsl_field(qstate.colmd.columns [cidx], nullptr, nullptr);
+                cidx++;
+            }
+            else if (rstate.column_index || rstate.continued) {
+                // Resume from where we left off. The bytes of the decoded
+                // columns are guaranteed to be present since the reader is
+                // always restored back to the token start.
+                TDSL_ASSERT(rr.has_bytes(rstate.consumed));
+                const tdsl::uint8_t * token_start = rr.current();
+                if (has_null_bitmap && not rstate.continued) {
+                    // The bitmap is at the start of the token
+                    null_bitmap = token_start;
+                }
+                rr.advance(static_cast<tdsl::ssize_t>(rstate.consumed));
+
+                // The unconsumed data may have been moved in the network buffer
+                // (e.g. compaction) since we've suspended. If so, relocate the
+                // already decoded fields. The fields of the previous segments
+                // (if any) are in the spill buffer.
+                if (not(token_start == rstate.token_start)) {
+                    for (tdsl::uint32_t i = rstate.segment_column; i < rstate.column_index; i++) {
+                        auto & field = row_data [i];
+                        if (field.is_null() || field.size_bytes() == 0) {
+                            continue;
+                        }
+                        const auto offset = field.data() - rstate.token_start;
+                        const auto size   = field.size_bytes();
+                        new (&field, placement_new_tag{})
+                            tdsl_field(qstate.colmd.columns [i], token_start + offset, size);
+                    }
+                }
+                cidx = rstate.column_index;
+            }
+            else if (has_null_bitmap) {
+                if (not rr.has_bytes(null_bitmap_sz)) {
+                    return suspend(0, token_offset, null_bitmap_sz - rr.remaining_bytes());
+                }
+                null_bitmap = rr.read(null_bitmap_sz).data();
             }
 
             // Each row should contain N fields.
-            for (tdsl::uint32_t cidx = 0; cidx < qstate.colmd.columns.size(); cidx++) {
-                TDSL_ASSERT(cidx < row_data->size());
-                const auto & column             = qstate.colmd.columns [cidx];
-                const auto & dprop              = get_data_type_props(column.type);
+            for (; cidx < qstate.colmd.columns.size(); cidx++) {
+                TDSL_ASSERT(cidx < row_data.size());
+                const auto & column      = qstate.colmd.columns [cidx];
+                const auto & step        = qstate.plan [cidx];
+                const auto column_offset = rr.offset();
 
                 // (mkg): In this stage, the field's constructor is not yet
                 // invoked, only the storage is allocated. This loop expected
                 // to invoke the "placement new" for the field.
-                auto & field                    = (*row_data) [cidx];
-                bool field_length_equal_to_null = {false};
+                auto & field = row_data [cidx];
+
+                // NULL columns of an NBCROW token have no data at all
+                if (null_bitmap && ((null_bitmap [cidx / 8] >> (cidx % 8)) & 1)) {
+                    new (&field, placement_new_tag{}) tdsl_field(column, nullptr, nullptr);
+                    field.set_null();
+                    continue;
+                }
 
                 // Allow me to present yet another nonsense from TDS:
-                if (dprop.flags.has_textptr) {
+                if (step.flags.has_textptr) {
                     // non-null text, ntext or img field.
                     // FIXME: Is this any useful?
                     do {
@@ -654,79 +1999,114 @@ namespace tdsl { namespace detail {
                                            "field textptr, " TDSL_SIZET_FORMAT_SPECIFIER
                                            " more bytes needed",
                                            textptr_need_bytes - rr.remaining_bytes());
-                        result.status       = token_handler_status::not_enough_bytes;
-                        result.needed_bytes = textptr_need_bytes - rr.remaining_bytes();
-                        return result;
+                        return suspend(cidx, column_offset,
+                                       textptr_need_bytes - rr.remaining_bytes());
                     } while (0);
                 }
 
-                tdsl::uint32_t field_length = 0;
-                switch (dprop.size_type) {
-                    case data_size_type::fixed:
-                        field_length = dprop.length.fixed;
-                        break;
-                    case data_size_type::var_u8:
-                    case data_size_type::var_precision:
-                        if (not rr.has_bytes(sizeof(tdsl::uint8_t))) {
-                            result.status       = token_handler_status::not_enough_bytes;
-                            result.needed_bytes = 1;
-                            return result;
-                        }
-                        field_length               = rr.read<tdsl::uint8_t>();
-                        field_length_equal_to_null = dprop.flags.zero_represents_null &&
-                                                     (field_length == tdsl::uint8_t{0x00});
-                        break;
-                    case data_size_type::var_u16:
-                        if (not rr.has_bytes(sizeof(tdsl::uint16_t))) {
-                            result.status       = token_handler_status::not_enough_bytes;
-                            result.needed_bytes = sizeof(tdsl::uint16_t);
-                            return result;
+                if (step.flags.is_plp) {
+                    // PLP_BODY: total length (u64) followed by the chunks (u32 length
+                    // + data), terminated by a zero-length chunk. The chunks are
+                    // joined after the whole row is read.
+                    if (not rr.has_bytes(sizeof(tdsl::uint64_t))) {
+                        return suspend(cidx, column_offset,
+                                       sizeof(tdsl::uint64_t) - rr.remaining_bytes());
+                    }
+
+                    if (rr.read<tdsl::uint64_t>() == k_plp_null) {
+                        new (&field, placement_new_tag{}) tdsl_field(column, nullptr, nullptr);
+                        field.set_null();
+                        continue;
+                    }
+
+                    if (step.flags.is_streamed) {
+                        rstate.stream.active        = {true};
+                        rstate.stream.plp           = {true};
+                        rstate.stream.remaining     = {0};
+                        tdsl::uint32_t needed_bytes = {0};
+                        if (not stream_field(cidx, rr, needed_bytes)) {
+                            return continue_later(cidx, needed_bytes);
                         }
-                        field_length               = rr.read<tdsl::uint16_t>();
-                        field_length_equal_to_null = dprop.flags.maxlen_represents_null &&
-                                                     (field_length == tdsl::uint16_t{0xFFFF});
-                        break;
-                    case data_size_type::var_u32:
+                        new (&field, placement_new_tag{}) tdsl_field(column, nullptr, nullptr);
+                        continue;
+                    }
+
+                    const tdsl::uint8_t * chunks = rr.current();
+                    for (;;) {
                         if (not rr.has_bytes(sizeof(tdsl::uint32_t))) {
-                            result.status       = token_handler_status::not_enough_bytes;
-                            result.needed_bytes = sizeof(tdsl::uint32_t);
-                            return result;
+                            return suspend(cidx, column_offset,
+                                           sizeof(tdsl::uint32_t) - rr.remaining_bytes());
                         }
-                        field_length               = rr.read<tdsl::uint32_t>();
-                        field_length_equal_to_null = dprop.flags.maxlen_represents_null &&
-                                                     (field_length == tdsl::uint32_t{0xFFFFFFFF});
-                        break;
-                    case data_size_type::unknown:
-                        TDSL_ASSERT_MSG(0, "unknown size_type");
-                        TDSL_UNREACHABLE;
-                        break;
+                        const auto chunk_length = rr.read<tdsl::uint32_t>();
+                        if (chunk_length == 0) {
+                            break;
+                        }
+                        if (not rr.has_bytes(chunk_length)) {
+                            return suspend(cidx, column_offset,
+                                           chunk_length - rr.remaining_bytes());
+                        }
+                        rr.advance(static_cast<tdsl::ssize_t>(chunk_length));
+                    }
+
+                    // Holds the raw chunks until the row is complete
+                    new (&field, placement_new_tag{}) tdsl_field(column, chunks, rr.current());
+                    continue;
                 }
 
-                // TEXT, NTEXT, IMAGE
+                tdsl::uint32_t field_length     = step.fixed_size;
+                bool field_length_equal_to_null = {false};
+
+                if (step.length_prefix_size) {
+                    if (not rr.has_bytes(step.length_prefix_size)) {
+                        return suspend(cidx, column_offset,
+                                       step.length_prefix_size - rr.remaining_bytes());
+                    }
 
-                if (dprop.is_variable_size() &&
-                    not is_valid_variable_length_for_type(column.type, field_length)) {
-                    TDSL_DEBUG_PRINTLN(
-                        "handle_row_token() --> invalid varlength for column type %d -> %d",
-                        static_cast<int>(column.type), field_length);
-                    result.status = token_handler_status::invalid_field_length;
-                    return result;
+                    switch (step.length_prefix_size) {
+                        case sizeof(tdsl::uint8_t):
+                            field_length = rr.read<tdsl::uint8_t>();
+                            break;
+                        case sizeof(tdsl::uint16_t):
+                            field_length = rr.read<tdsl::uint16_t>();
+                            break;
+                        default:
+                            field_length = rr.read<tdsl::uint32_t>();
+                            break;
+                    }
+
+                    field_length_equal_to_null =
+                        step.flags.has_null_length && (field_length == step.null_length);
+
+                    if (not step.is_valid_length(field_length)) {
+                        TDSL_DEBUG_PRINTLN(
+                            "handle_row_token() --> invalid varlength for column type %d -> %d",
+                            static_cast<int>(column.type), field_length);
+                        result.status = token_handler_status::invalid_field_length;
+                        return result;
+                    }
                 }
 
                 if (field_length_equal_to_null) {
-                    field_length = {0};
                     new (&field, placement_new_tag{}) tdsl_field(column, nullptr, nullptr);
                     field.set_null();
                 }
+                else if (step.flags.is_streamed) {
+                    rstate.stream.active        = {true};
+                    rstate.stream.plp           = {false};
+                    rstate.stream.remaining     = field_length;
+                    tdsl::uint32_t needed_bytes = {0};
+                    if (not stream_field(cidx, rr, needed_bytes)) {
+                        return continue_later(cidx, needed_bytes);
+                    }
+                    new (&field, placement_new_tag{}) tdsl_field(column, nullptr, nullptr);
+                }
                 else {
                     if (not rr.has_bytes(field_length)) {
                         TDSL_DEBUG_PRINTLN("handle_row_token() --> not enough bytes for reading "
                                            "field, " TDSL_SIZET_FORMAT_SPECIFIER
                                            " more bytes needed",
                                            field_length - rr.remaining_bytes());
-                        result.status       = token_handler_status::not_enough_bytes;
-                        result.needed_bytes = field_length - rr.remaining_bytes();
-                        return result;
+                        return suspend(cidx, column_offset, field_length - rr.remaining_bytes());
                     }
 
                     // Invoke "placement new"
@@ -741,8 +2121,17 @@ namespace tdsl { namespace detail {
                 TDSL_DEBUG_PRINT("]\n");
             }
 
+            // Row is complete, reset the parser state for the next row
+            rstate = {};
+
+            if (qstate.plan.has_plp && not join_plp_fields()) {
+                TDSL_DEBUG_PRINTLN("handle_row_token() --> failed to allocate PLP buffer");
+                result.status = token_handler_status::not_enough_memory;
+                return result;
+            }
+
             // Invoke row callback
-            qstate.row_callback(qstate.colmd, row_data.get());
+            qstate.row_callback(qstate.colmd, row_data);
 
             result.status       = token_handler_status::success;
             result.needed_bytes = 0;
@@ -751,6 +2140,362 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Push the data of the streamed field at column @p cidx to the stream
+         * sink, until the field is complete or @p rr is exhausted. Continues
+         * from the state in qstate.row_parse.stream.
+         *
+         * @param [in] cidx Column index of the field
+         * @param [in] rr Reader to read from
+         * @param [out] needed_bytes Amount of bytes needed to make progress,
+         *              if the field is not complete
+         *
+         * @return true if the field is complete, false otherwise
+         */
+        TDSL_NODISCARD bool stream_field(tdsl::uint32_t cidx,
+                                         tdsl::binary_reader<tdsl::endian::little> & rr,
+                                         tdsl::uint32_t & needed_bytes) noexcept {
+            auto & stream = qstate.row_parse.stream;
+            for (;;) {
+                if (stream.remaining == 0) {
+                    if (not stream.plp) {
+                        break;
+                    }
+                    // Next PLP chunk, terminated by a zero-length chunk
+                    if (not rr.has_bytes(sizeof(tdsl::uint32_t))) {
+                        needed_bytes = static_cast<tdsl::uint32_t>(sizeof(tdsl::uint32_t) -
+                                                                   rr.remaining_bytes());
+                        return false;
+                    }
+                    stream.remaining = rr.read<tdsl::uint32_t>();
+                    if (stream.remaining == 0) {
+                        break;
+                    }
+                }
+
+                const auto amount = stream.remaining < rr.remaining_bytes()
+                                        ? stream.remaining
+                                        : static_cast<tdsl::uint32_t>(rr.remaining_bytes());
+                if (amount == 0) {
+                    // Whatever arrives next is useful
+                    needed_bytes = 1;
+                    return false;
+                }
+                options.stream_sink(qstate.colmd, cidx, rr.read(amount), false);
+                stream.remaining -= amount;
+            }
+
+            options.stream_sink(qstate.colmd, cidx, tdsl::byte_view{}, true);
+            stream = {};
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Copy the data of the fields of the current token data (up to the
+         * column @p end) to the plan's spill buffer, along with the null
+         * bitmap @p null_bitmap at the first time.
+         *
+         * @param [in] end Column index to stop at
+         * @param [in] null_bitmap Null bitmap of the NBCROW token (if any)
+         * @param [in] null_bitmap_sz Size of the null bitmap
+         *
+         * @return true if successful, false if the spill buffer is too small
+         */
+        TDSL_NODISCARD bool spill_row_fields(tdsl::uint32_t end, const tdsl::uint8_t * null_bitmap,
+                                             tdsl::uint32_t null_bitmap_sz) noexcept {
+            auto & rstate = qstate.row_parse;
+            auto & plan   = qstate.plan;
+            if (null_bitmap && not rstate.continued) {
+                TDSL_ASSERT(null_bitmap_sz <= plan.spill_buffer_size);
+                memcpy(plan.spill_buffer, null_bitmap, null_bitmap_sz);
+                rstate.spilled = null_bitmap_sz;
+            }
+
+            for (tdsl::uint32_t i = rstate.segment_column; i < end; i++) {
+                auto & field = qstate.row [i];
+                if (field.is_null() || field.size_bytes() == 0) {
+                    continue;
+                }
+                const auto size = static_cast<tdsl::uint32_t>(field.size_bytes());
+                if (rstate.spilled + size > plan.spill_buffer_size) {
+                    return false;
+                }
+                tdsl::uint8_t * dst = plan.spill_buffer + rstate.spilled;
+                memcpy(dst, field.data(), size);
+                new (&field, placement_new_tag{}) tdsl_field(qstate.colmd.columns [i], dst, size);
+                rstate.spilled += size;
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Replace the raw chunks of the PLP fields of the current row with the
+         * field data. Single chunk fields point to the chunk itself, whereas
+         * the chunks of the multi-chunk fields are copied into the plan's
+         * PLP buffer.
+         *
+         * @return true if successful, false if memory allocation failed
+         */
+        TDSL_NODISCARD bool join_plp_fields() noexcept {
+            auto & plan     = qstate.plan;
+            auto & row_data = qstate.row;
+
+            // Count the chunks & the data bytes of a PLP field,
+            // and locate the data of the first chunk.
+            auto scan_chunks = [](const tdsl_field & field, const tdsl::uint8_t ** first,
+                                     tdsl::uint32_t * count) -> tdsl::uint32_t {
+                tdsl::binary_reader<tdsl::endian::little> cr{field};
+                tdsl::uint32_t total = 0;
+                *count               = 0;
+                for (auto len = cr.read<tdsl::uint32_t>(); len; len = cr.read<tdsl::uint32_t>()) {
+                    if (0 == (*count)++) {
+                        *first = cr.current();
+                    }
+                    total += len;
+                    cr.advance(static_cast<tdsl::ssize_t>(len));
+                }
+                return total;
+            };
+
+            // Reserve the buffer once for all the multi-chunk fields of the row
+            tdsl::uint32_t needed = {0};
+            for (tdsl::uint32_t cidx = 0; cidx < row_data.size(); cidx++) {
+                if (not plan [cidx].flags.is_plp || plan [cidx].flags.is_streamed ||
+                    row_data [cidx].is_null()) {
+                    continue;
+                }
+                const tdsl::uint8_t * first = {nullptr};
+                tdsl::uint32_t count        = {0};
+                const auto total            = scan_chunks(row_data [cidx], &first, &count);
+                needed += (count > 1) ? total : 0;
+            }
+
+            if (not plan.reserve_plp_buffer(needed)) {
+                return false;
+            }
+
+            tdsl::uint8_t * out = plan.plp_buffer;
+            for (tdsl::uint32_t cidx = 0; cidx < row_data.size(); cidx++) {
+                auto & field = row_data [cidx];
+                if (not plan [cidx].flags.is_plp || plan [cidx].flags.is_streamed ||
+                    field.is_null()) {
+                    continue;
+                }
+                const auto & column         = qstate.colmd.columns [cidx];
+                const tdsl::uint8_t * first = {field.data()};
+                tdsl::uint32_t count        = {0};
+                const auto total            = scan_chunks(field, &first, &count);
+                if (count <= 1) {
+                    new (&field, placement_new_tag{}) tdsl_field(column, first, total);
+                    continue;
+                }
+
+                tdsl::binary_reader<tdsl::endian::little> cr{field};
+                tdsl::uint8_t * begin = out;
+                for (auto len = cr.read<tdsl::uint32_t>(); len; len = cr.read<tdsl::uint32_t>()) {
+                    memcpy(out, cr.current(), len);
+                    out += len;
+                    cr.advance(static_cast<tdsl::ssize_t>(len));
+                }
+                new (&field, placement_new_tag{}) tdsl_field(column, begin, total);
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Handler for RETURNVALUE token type
+         *
+         * The output parameters of an RPC are returned in RETURNVALUE tokens.
+         * The only output parameter tdslite declares is the statement handle
+         * of sp_prepexec, which is put into the prepared statement cache.
+         * The other return values are skipped.
+         *
+         * @param [in] rr Reader to read from
+         *
+         * @return token_handler_result The amount of needed bytes to read a complete
+         * RETURNVALUE token, if any.
+         */
+        TDSL_NODISCARD token_handler_result
+        handle_returnvalue_token(tdsl::binary_reader<tdsl::endian::little> & rr) noexcept {
+            token_handler_result result = {};
+
+            auto need_bytes = [&](tdsl::uint32_t amount) -> bool {
+                if (rr.has_bytes(amount)) {
+                    return false;
+                }
+                result.status       = token_handler_status::not_enough_bytes;
+                result.needed_bytes = amount - static_cast<tdsl::uint32_t>(rr.remaining_bytes());
+                return true;
+            };
+
+            // UserType is 4 bytes since TDS 7.2
+            const tdsl::uint32_t user_type_size =
+                tds_ctx.tds_version_at_least(e_tds_version::sql_server_2005) ? 4 : 2;
+
+            // ParamOrdinal, ParamName length
+            if (need_bytes(3)) {
+                return result;
+            }
+            rr.advance(2);
+            const tdsl::uint32_t name_bytes = rr.read<tdsl::uint8_t>() * 2U;
+
+            // ParamName, Status, UserType, Flags, Type
+            if (need_bytes(name_bytes + 1 + user_type_size + 2 + 1)) {
+                return result;
+            }
+            rr.advance(static_cast<tdsl::ssize_t>(name_bytes + 1 + user_type_size + 2));
+            const auto type   = static_cast<e_tds_data_type>(rr.read<tdsl::uint8_t>());
+            const auto dprops = get_data_type_props(type);
+
+            // TYPE_INFO
+            tdsl::uint32_t max_length = {0};
+            switch (dprops.size_type) {
+                case e_tds_data_size_type::fixed:
+                    break;
+                case e_tds_data_size_type::var_u8:
+                    if (need_bytes(1)) {
+                        return result;
+                    }
+                    max_length = rr.read<tdsl::uint8_t>();
+                    break;
+                case e_tds_data_size_type::var_u16:
+                    if (need_bytes(2)) {
+                        return result;
+                    }
+                    max_length = rr.read<tdsl::uint16_t>();
+                    break;
+                case e_tds_data_size_type::var_u32:
+                    if (need_bytes(4)) {
+                        return result;
+                    }
+                    max_length = rr.read<tdsl::uint32_t>();
+                    break;
+                case e_tds_data_size_type::var_precision:
+                    // length, precision, scale
+                    if (need_bytes(3)) {
+                        return result;
+                    }
+                    rr.advance(3);
+                    break;
+                case e_tds_data_size_type::var_scale:
+                    if (dprops.flags.has_scale) {
+                        if (need_bytes(1)) {
+                            return result;
+                        }
+                        rr.advance(1);
+                    }
+                    break;
+                case e_tds_data_size_type::unknown:
+                    TDSL_DEBUG_PRINTLN("handle_returnvalue_token() --> unknown size type for "
+                                       "data type %d",
+                                       static_cast<int>(type));
+                    result.status = token_handler_status::unknown_column_size_type;
+                    return result;
+            }
+
+            if (dprops.flags.has_collation) {
+                constexpr tdsl::uint32_t k_collation_info_size = 5;
+                if (need_bytes(k_collation_info_size)) {
+                    return result;
+                }
+                rr.advance(k_collation_info_size);
+            }
+
+            // TYPE_VARBYTE
+            tdsl::byte_view value = {};
+            if (dprops.size_type == e_tds_data_size_type::var_u16 && max_length == 0xFFFF) {
+                // PLP_BODY: total length followed by the chunks
+                if (need_bytes(sizeof(tdsl::uint64_t))) {
+                    return result;
+                }
+                if (not(rr.read<tdsl::uint64_t>() == k_plp_null)) {
+                    for (;;) {
+                        if (need_bytes(sizeof(tdsl::uint32_t))) {
+                            return result;
+                        }
+                        const auto chunk_length = rr.read<tdsl::uint32_t>();
+                        if (chunk_length == 0) {
+                            break;
+                        }
+                        if (need_bytes(chunk_length)) {
+                            return result;
+                        }
+                        rr.advance(static_cast<tdsl::ssize_t>(chunk_length));
+                    }
+                }
+            }
+            else {
+                tdsl::uint32_t length = dprops.length.fixed;
+                bool has_value        = {true};
+                if (dprops.flags.has_textptr) {
+                    // TextPointer & Timestamp, no TextPointer means NULL
+                    if (need_bytes(1)) {
+                        return result;
+                    }
+                    const tdsl::uint32_t textptr_size = rr.read<tdsl::uint8_t>();
+                    has_value                         = (textptr_size > 0);
+                    if (has_value) {
+                        if (need_bytes(textptr_size + 8)) {
+                            return result;
+                        }
+                        rr.advance(static_cast<tdsl::ssize_t>(textptr_size + 8));
+                    }
+                }
+                if (has_value && dprops.is_variable_size()) {
+                    // The decimal & date/time types have an 8-bit length prefix
+                    const bool u8_length =
+                        dprops.size_type == e_tds_data_size_type::var_precision ||
+                        dprops.size_type == e_tds_data_size_type::var_scale;
+                    const tdsl::uint32_t length_size =
+                        u8_length ? 1 : dprops.length.variable.length_size;
+                    if (need_bytes(length_size)) {
+                        return result;
+                    }
+                    switch (length_size) {
+                        case sizeof(tdsl::uint8_t):
+                            length = rr.read<tdsl::uint8_t>();
+                            break;
+                        case sizeof(tdsl::uint16_t):
+                            length = rr.read<tdsl::uint16_t>();
+                            length = (length == 0xFFFF) ? 0 : length;
+                            break;
+                        default:
+                            length = rr.read<tdsl::uint32_t>();
+                            length = (length == 0xFFFFFFFF) ? 0 : length;
+                            break;
+                    }
+                }
+                if (has_value) {
+                    if (need_bytes(length)) {
+                        return result;
+                    }
+                    value = rr.read(length);
+                }
+            }
+
+            // The handle of the statement prepared by sp_prepexec
+            if (qstate.prepared.awaiting_handle &&
+                (type == e_tds_data_type::INTNTYPE || type == e_tds_data_type::INT4TYPE) &&
+                value.size_bytes() == sizeof(tdsl::int32_t)) {
+                tdsl::binary_reader<tdsl::endian::little> vr{value};
+                const auto handle = vr.read<tdsl::int32_t>();
+                TDSL_DEBUG_PRINTLN("handle_returnvalue_token() --> statement handle %d", handle);
+                tds_ctx.prepared_statements.insert(TDSL_MOVE(qstate.prepared.key), handle);
+                qstate.prepared.awaiting_handle = {false};
+            }
+
+            result.status = token_handler_status::success;
+            return result;
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Convert a variable type to equivalent fixed type
          *
@@ -826,11 +2571,11 @@ namespace tdsl { namespace detail {
          * Write parameter type string
          *
          * @param [in] pb Parameter binding
-         * @param [in] wc Target counted writer
+         * @param [in] wc Target writer
          */
-        static inline void
-        write_param_type_str(const sql_parameter_binding & pb,
-                             typename string_writer_type::counted_writer & wc) noexcept {
+        template <typename W>
+        static inline void write_param_type_str(const sql_parameter_binding & pb,
+                                                W & wc) noexcept {
             /**
              * Write string representation of the type @ref pb.type
              */
@@ -883,6 +2628,10 @@ namespace tdsl { namespace detail {
                 case e_tds_data_type::BIGBINARYTYPE:
                     wc.write("BINARY");
                     break;
+                case e_tds_data_type::TVPTYPE:
+                    wc.write(sql_parameter_tvp::from_binding(pb).type_name);
+                    wc.write(" READONLY");
+                    break;
                 case e_tds_data_type::INTNTYPE:
                 case e_tds_data_type::FLTNTYPE:
                 case e_tds_data_type::DATETIMNTYPE:
@@ -904,11 +2653,11 @@ namespace tdsl { namespace detail {
          * if applicable
          *
          * @param [in] pb Parameter binding
-         * @param [in] wc Target counted writer
+         * @param [in] wc Target writer
          */
-        static inline void
-        write_param_len_str(const sql_parameter_binding & pb,
-                            typename string_writer_type::counted_writer & wc) noexcept {
+        template <typename W>
+        static inline void write_param_len_str(const sql_parameter_binding & pb,
+                                               W & wc) noexcept {
             auto write_explicit_length = [&wc](tdsl::size_t len) {
                 char utos_buf [10] = {0};
                 wc.write("(");
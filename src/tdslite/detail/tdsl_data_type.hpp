@@ -63,6 +63,7 @@ namespace tdsl { namespace detail {
         var_u16,
         var_u32,
         var_precision,
+        var_scale, // 1-byte length, preceded by scale in COLMETADATA (TDS 7.3+)
         unknown
     };
 
@@ -99,7 +100,9 @@ namespace tdsl { namespace detail {
             bool maxlen_represents_null : 1;
             // .. Other nullable data types have a length of 0 when they are null.
             bool zero_represents_null : 1;
-            bool reserved : 2;
+            // The type has a fractional seconds scale (time, datetime2 & datetimeoffset)
+            bool has_scale : 1;
+            bool reserved : 1;
         } flags;
 
         // corresponding non-fixed size type, if possible
@@ -135,6 +138,7 @@ namespace tdsl { namespace detail {
         inline bool is_variable_size() const noexcept {
             switch (size_type) {
                 case e_tds_data_size_type::var_precision:
+                case e_tds_data_size_type::var_scale:
                 case e_tds_data_size_type::var_u8:
                 case e_tds_data_size_type::var_u16:
                 case e_tds_data_size_type::var_u32:
@@ -155,6 +159,7 @@ namespace tdsl { namespace detail {
          * - Column name size (1 bytes)
          * - Collation size (5 bytes)
          * - Column data length size (N bytes, depending on type)
+         * - Scale size (1 byte, if applicable)
          *
          * @return tdsl::uint32_t Minimum COLMETADATA size for data type
          */
@@ -163,11 +168,13 @@ namespace tdsl { namespace detail {
             constexpr int k_tablename_size = 2; // UCS-2 string, so 2 bytes len.
             constexpr int k_collation_size = 5;
             constexpr int k_precision_size = 2; // precision, scale
+            constexpr int k_scale_size     = 1;
 
             tdsl::uint32_t final_size      = {0};
             final_size += (is_variable_size() ? length.variable.length_size : length.fixed);
             final_size += (flags.has_collation ? k_collation_size : 0);
             final_size += (flags.has_precision ? k_precision_size : 0);
+            final_size += (flags.has_scale ? k_scale_size : 0);
             final_size += (flags.has_table_name ? k_tablename_size : 0);
             final_size += k_colname_size;
             return final_size;
@@ -186,6 +193,7 @@ namespace tdsl { namespace detail {
      * @returns varu16_prop if @p type is a variable data type in u16-size boundary
      * @returns varu32_prop if @p type is a variable data type in u32-size boundary
      * @returns varprec_prop if @p type is variable data type with precision and scale
+     * @returns varscale_prop if @p type is a date/time data type introduced in TDS 7.3
      */
     TDSL_NODISCARD static inline tds_data_type_properties
     get_data_type_props(e_tds_data_type type) {
@@ -263,6 +271,21 @@ namespace tdsl { namespace detail {
                 result.corresponding_varsize_type  = type;
                 break;
 
+            // Date & time data types (TDS 7.3+). The length is not present in
+            // COLMETADATA (except the scale), the fields have an 8-bit length
+            // prefix where zero represents NULL.
+            case e_tds_data_type::TIMENTYPE:
+            case e_tds_data_type::DATETIME2NTYPE:
+            case e_tds_data_type::DATETIMEOFFSETNTYPE:
+                result.flags.has_scale = {true};
+            // fallthrough
+            case e_tds_data_type::DATENTYPE:
+                result.flags.zero_represents_null  = {true};
+                result.size_type                   = e_tds_data_size_type::var_scale;
+                result.length.variable.length_size = 0;
+                result.corresponding_varsize_type  = type; // is already a varsize type
+                break;
+
             // Variable length data types with 8-bit length bit width
             case e_tds_data_type::GUIDTYPE:
             case e_tds_data_type::INTNTYPE:
@@ -350,12 +373,22 @@ namespace tdsl { namespace detail {
                     case 0x08:
                         return true;
                 }
-                break;
+                return false;
 
             case e_tds_data_type::GUIDTYPE:
                 return length == 0x10;
             case e_tds_data_type::BITNTYPE:
                 return length == 0x01;
+            case e_tds_data_type::DATENTYPE:
+                return length == 0x03;
+            // The length depends on the scale; 3-5 bytes of time,
+            // followed by 3 bytes of date and 2 bytes of offset.
+            case e_tds_data_type::TIMENTYPE:
+                return length >= 0x03 && length <= 0x05;
+            case e_tds_data_type::DATETIME2NTYPE:
+                return length >= 0x06 && length <= 0x08;
+            case e_tds_data_type::DATETIMEOFFSETNTYPE:
+                return length >= 0x08 && length <= 0x0A;
 
             default:
                 return true;
@@ -17,6 +17,7 @@
 #include <tdslite/detail/tdsl_tds_context.hpp>
 #include <tdslite/detail/tdsl_login_context.hpp>
 #include <tdslite/detail/tdsl_command_context.hpp>
+#include <tdslite/detail/tdsl_allocator.hpp>
 
 namespace tdsl { namespace detail {
 
@@ -38,7 +39,9 @@ namespace tdsl { namespace detail {
         using sql_command_rpc_mode       = e_rpc_mode;
         using sql_command_rpc_result     = typename sql_command_type::execute_rpc_result;
         using sql_command_row_callback   = typename sql_command_type::row_callback_fn_t;
+        using sql_command_stream_sink    = typename sql_command_type::stream_sink_fn_t;
         using sql_command_query_result   = typename sql_command_type::query_result;
+        using sql_bulk_load_result       = typename sql_command_type::execute_bulk_load_result;
 
         // --------------------------------------------------------------------------------
 
@@ -48,7 +51,8 @@ namespace tdsl { namespace detail {
             connection_failed,
             login_failed,
             connection_param_server_name_empty,
-            connection_param_packet_size_invalid
+            connection_param_packet_size_invalid,
+            prelogin_failed
         };
 
         // --------------------------------------------------------------------------------
@@ -59,7 +63,7 @@ namespace tdsl { namespace detail {
             tdsl::uint16_t port = {1433};
             // How many attempts the driver should make to establish a connection
             tdsl::uint32_t conn_retry_count{10};
-            // The delay between each connection attempt (milliseconds)
+            // The upper bound of the delay between each connection attempt (milliseconds)
             tdsl::uint32_t conn_retry_delay_ms{3000};
 
             /**
@@ -102,6 +106,20 @@ namespace tdsl { namespace detail {
         template <typename... Args>
         inline tdsl_driver(Args &&... args) noexcept : tds_ctx(TDSL_FORWARD(args)...) {}
 
+        tdsl_driver(const tdsl_driver &)             = delete;
+        tdsl_driver & operator=(const tdsl_driver &) = delete;
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * D-tor
+         */
+        inline ~tdsl_driver() noexcept {
+            if (async_cctx) {
+                tds_allocator<sql_command_type>::destroy(async_cctx);
+            }
+        }
+
         // --------------------------------------------------------------------------------
 
         /**
@@ -113,6 +131,8 @@ namespace tdsl { namespace detail {
          * @returns e_driver_error_code::success if connected & logged in
          * @returns e_driver_error_code::connection_failed if all
          *          connection attempts are failed
+         * @returns e_driver_error_code::prelogin_failed if connection succeeded,
+         *          but PRELOGIN handshake failed (e.g. server requires encryption)
          * @returns e_driver_error_code::login_failed if connection succeeded,
          *          but login failed
          * @returns e_driver_error_code::connection_param_server_name_empty
@@ -137,16 +157,68 @@ namespace tdsl { namespace detail {
                 return e_driver_error_code::connection_failed;
             }
 
+            // A MARS session opened on a connection that is already
+            // logged in shares its login.
+            using shares_login = traits::integral_constant<bool, has_joins_existing_login::value>;
+            if (joins_existing_login(shares_login{})) {
+                join_existing_login(shares_login{});
+                return e_driver_error_code::success;
+            }
+
+            login_context_type lctx{tds_ctx};
+
+            // The network implementation may perform the PRELOGIN
+            // handshake by itself (i.e. tdsl_netimpl_smp)
+            if (not negotiates_prelogin(
+                    traits::integral_constant<bool, has_negotiates_prelogin::value>{}) &&
+                not(login_context_type::e_login_status::success == lctx.do_prelogin())) {
+                return e_driver_error_code::prelogin_failed;
+            }
+
             if (not(login_context_type::e_login_status::success ==
-                    login_context_type{tds_ctx}.do_login(p))) {
+                    lctx.do_login(p, login_cache))) {
                 return e_driver_error_code::login_failed;
             }
 
+            share_login(shares_login{});
             return e_driver_error_code::success;
         }
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Disconnect from the SQL server.
+         *
+         * The driver can be connected again with connect() afterwards.
+         */
+        inline void disconnect() noexcept {
+            tds_ctx.do_disconnect();
+            tds_ctx.abandon_receive();
+            tds_ctx.flags.authenticated = {false};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Make the server reset the session before it executes the next command.
+         *
+         * The temporary tables are dropped, the open transactions are rolled back
+         * and the SET options, the database and the language are restored to the
+         * values the session had right after the login. This is much cheaper than
+         * a disconnect & login cycle, as the reset request is carried in the next
+         * command's TDS packet header.
+         *
+         * The statements prepared in the session are released as well.
+         *
+         * @param [in] keep_transaction Keep the open transaction, if any
+         */
+        inline void reset_connection(bool keep_transaction = false) noexcept {
+            tds_ctx.set_reset_connection(keep_transaction);
+            tds_ctx.prepared_statements.clear();
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Set callback function for INFO/ERROR messages.
          *
@@ -252,8 +324,22 @@ namespace tdsl { namespace detail {
          * The result set returned by query @p command can be read by providing
          * a row callback function
          *
+         * In e_rpc_mode::prepexec mode, the statement is prepared on its first
+         * execution (sp_prepexec) and the handle returned by the server is kept
+         * per connection, keyed by @p command and the parameter declarations.
+         * The subsequent executions send only the handle and the parameter
+         * values (sp_execute). See TDSL_PREPARED_STATEMENT_CACHE_CAPACITY.
+         *
+         * The rows of a table-valued parameter (sql_parameter_tvp) are streamed
+         * into the request as they are produced, so any amount of rows can be
+         * passed to a stored procedure in a single call.
+         *
          * @returns execute_rpc_result::unexpected(e_rpc_error_code::invalid_mode) if @p mode
          *          value is invalid
+         * @returns execute_rpc_result::unexpected(e_rpc_error_code::unsupported_parameter_type)
+         *          if a parameter type is not supported
+         * @returns execute_rpc_result::unexpected(e_rpc_error_code::invalid_parameter_length)
+         *          if a TVP value does not fit to its column. The call is not run.
          * @returns rows_affected if successful
          */
         template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
@@ -272,6 +358,283 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Perform a remote procedure call with a statement whose parameter
+         * types are known at compile time, e.g.
+         *
+         *   tdsl::statement<tdsl::int32_t, tdsl::wstring_view> stmt{42, u"name"};
+         *   driver.execute_rpc("SELECT * FROM t WHERE id=@p0 AND name=@p1", stmt);
+         *
+         * The parameter declarations and the TYPE_INFO of each parameter
+         * are generated at compile time.
+         *
+         * @tparam T String view type
+         * @tparam Params Statement parameter types
+         *
+         * @param [in] command Command to execute
+         * @param [in] stmt Statement parameters
+         * @param [in] mode RPC execution mode
+         * @param [in] row_callback Row callback function (optional)
+         * @param [in] rcb_uptr Row callback user pointer (optional)
+         *
+         * @returns execute_rpc_result::unexpected(e_rpc_error_code::invalid_mode) if @p mode
+         *          value is invalid
+         * @returns execute_rpc_result::unexpected(e_rpc_error_code::invalid_parameter_length)
+         *          if a value does not fit to its declared type
+         * @returns rows_affected if successful
+         */
+        template <typename T, typename... Params,
+                  traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                   struct progmem_string_view> = true,
+                  typename traits::enable_if<(sizeof...(Params) > 0), bool>::type = true>
+        inline sql_command_rpc_result execute_rpc(
+            T command, const statement<Params...> & stmt,
+            sql_command_rpc_mode mode             = {sql_command_rpc_mode::executesql},
+            sql_command_row_callback row_callback = +[](void *, const tds_colmetadata_token &,
+                                                        const tdsl_row &) -> void {},
+            void * rcb_uptr                       = nullptr) noexcept {
+            TDSL_ASSERT(tds_ctx.is_authenticated());
+            return sql_command_type{tds_ctx, command_options}.execute_rpc(command, stmt, mode,
+                                                                          row_callback, rcb_uptr);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Perform several remote procedure calls in a single request (RPC batch)
+         *
+         * @p builder is invoked with the command context to append the calls, e.g.
+         *
+         *   sql_command_query_result results [2];
+         *   driver.execute_rpc_batch(results, [&](sql_command_type & batch) {
+         *       batch.add_rpc(tdsl::string_view{"INSERT INTO t VALUES(@p0)"}, params_a);
+         *       batch.add_rpc(tdsl::string_view{"UPDATE t SET a=@p0"}, params_b);
+         *   });
+         *
+         * The calls are sent as one message, so N calls take one round trip.
+         * The affected row count and status of each call is put into @p results,
+         * in call order.
+         *
+         * @tparam Builder Callable with `void(sql_command_type &)` signature
+         *
+         * @param [in] results Storage for the per-call results. Its size is
+         *                     the maximum amount of calls in the batch.
+         * @param [in] builder Function that appends the calls via add_rpc()
+         * @param [in] row_callback Row callback function (optional)
+         * @param [in] rcb_uptr Row callback user pointer (optional)
+         *
+         * @returns execute_rpc_result::unexpected(e_rpc_error_code::invalid_parameter_length)
+         *          if a TVP value does not fit to its column. None of the calls is run.
+         * @returns the total amount of rows affected by the calls
+         */
+        template <typename Builder>
+        inline sql_command_rpc_result execute_rpc_batch(
+            tdsl::span<sql_command_query_result> results, Builder && builder,
+            sql_command_row_callback row_callback = +[](void *, const tds_colmetadata_token &,
+                                                        const tdsl_row &) -> void {},
+            void * rcb_uptr                       = nullptr) noexcept {
+            TDSL_ASSERT(tds_ctx.is_authenticated());
+            sql_command_type cctx{tds_ctx, command_options};
+            cctx.begin_rpc_batch(results, row_callback, rcb_uptr);
+            builder(cctx);
+            return cctx.execute_rpc_batch();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Load rows into @p table with the bulk load (BCP) protocol, e.g.
+         *
+         *   sql_bulk_column columns [] = {
+         *       {"id", tdsl::data_type::INT4TYPE, 0, {}},
+         *       {"name", tdsl::data_type::NVARCHARTYPE, 30, {}}};
+         *   driver.execute_bulk_load(tdsl::string_view{"dbo.t"}, columns, producer, &source);
+         *
+         * The rows are streamed to the server as they are produced by @p producer,
+         * so the memory needed does not depend on the amount of rows.
+         *
+         * @param [in] table Target table name
+         * @param [in] columns Columns to load
+         * @param [in] producer Row producer function
+         * @param [in] producer_uptr Row producer user pointer (optional)
+         *
+         * @returns the amount of rows loaded if successful
+         * @returns e_bulk_load_error_code otherwise (see command_context::execute_bulk_load)
+         */
+        template <typename T, traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                               struct progmem_string_view> = true>
+        inline sql_bulk_load_result execute_bulk_load(T table,
+                                                      tdsl::span<sql_bulk_column> columns,
+                                                      bulk_row_producer_fn_t producer,
+                                                      void * producer_uptr = nullptr) noexcept {
+            TDSL_ASSERT(tds_ctx.is_authenticated());
+            return sql_command_type{tds_ctx, command_options}.execute_bulk_load(
+                table, columns, producer, producer_uptr);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect to the SQL server with details specified in @p p, asynchronously.
+         *
+         * Only available when the network implementation provides the
+         * asynchronous operations (e.g. tdsl_netimpl_asio_async).
+         *
+         * The login message is prepared (and cached) before the function returns,
+         * so @p p does not need to outlive the call. The PRELOGIN handshake is
+         * performed before the login. A single connection attempt is made
+         * to each resolved endpoint; conn_retry_count and conn_retry_delay_ms are
+         * not used.
+         *
+         * @param [in] p Connection parameters
+         * @param [in] handler Completion handler with void(e_driver_error_code)
+         *             signature. Must be copy-constructible. Invoked before the
+         *             function returns if @p p fails validation.
+         */
+        template <typename T, typename Handler>
+        inline void async_connect(const connection_parameters_base<T> & p,
+                                  Handler handler) noexcept {
+            using login_context_allocator = tds_allocator<login_context_type>;
+
+            const auto pvr = p.validate();
+            if (not(e_driver_error_code::success == pvr)) {
+                handler(pvr);
+                return;
+            }
+
+            tds_ctx.abandon_receive();
+
+            // The login context must be alive until the response
+            // is received, as it handles the LOGINACK token.
+            login_context_type * lctx = login_context_allocator::create(tds_ctx);
+            if (nullptr == lctx) {
+                handler(e_driver_error_code::login_failed);
+                return;
+            }
+            // The login message is sent after the PRELOGIN handshake, so
+            // it is kept in the login cache until then.
+            lctx->prepare_login(p, login_cache);
+            tds_ctx.discard_network_buffer();
+            if (not login_cache.matches(p)) {
+                login_context_allocator::destroy(lctx);
+                handler(e_driver_error_code::login_failed);
+                return;
+            }
+            lctx->prepare_prelogin();
+
+            tds_ctx.async_connect(p.server_name, p.port, [this, lctx, handler](tdsl::int32_t cr) {
+                if (not(cr == 0)) {
+                    tds_ctx.discard_network_buffer();
+                    login_context_allocator::destroy(lctx);
+                    handler(e_driver_error_code::connection_failed);
+                    return;
+                }
+
+                tds_ctx.async_send_tds_pdu(
+                    e_tds_message_type::pre_login, [this, lctx, handler](tdsl::int32_t sr) {
+                        if (not(sr == 0)) {
+                            login_context_allocator::destroy(lctx);
+                            handler(e_driver_error_code::connection_failed);
+                            return;
+                        }
+
+                        tds_ctx.async_receive_tds_pdu([this, lctx, handler](tdsl::int32_t rr) {
+                            if (not(rr == 0) || not(login_context_type::e_login_status::success ==
+                                                    lctx->prelogin_status())) {
+                                login_context_allocator::destroy(lctx);
+                                handler(e_driver_error_code::prelogin_failed);
+                                return;
+                            }
+                            async_send_login(lctx, handler);
+                        });
+                    });
+            });
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send a query to the server, asynchronously.
+         *
+         * Only available when the network implementation provides the
+         * asynchronous operations (e.g. tdsl_netimpl_asio_async).
+         *
+         * The rows are delivered to @p row_callback as they are received, and
+         * @p handler is invoked when the whole response is received. The command
+         * is written to the network buffer before the function returns, so
+         * @p command does not need to outlive the call.
+         *
+         * @param [in] command SQL command to execute
+         * @param [in] row_callback Callback to invoke for each row received
+         * @param [in] uptr User supplied pointer, will be passed to row_callback
+         * @param [in] handler Completion handler with
+         *             void(tdsl::int32_t net_error, sql_command_query_result)
+         *             signature. Must be copy-constructible.
+         */
+        template <typename T, typename Handler>
+        inline void async_execute_query(T command, sql_command_row_callback row_callback,
+                                        void * uptr, Handler handler) noexcept {
+            TDSL_ASSERT(tds_ctx.is_authenticated());
+            sql_command_type * cctx = async_command_context();
+            if (nullptr == cctx) {
+                handler(tdsl::int32_t{-1}, sql_command_query_result{});
+                return;
+            }
+            cctx->prepare_query(command, row_callback, uptr);
+            async_execute_command(cctx, e_tds_message_type::sql_batch,
+                                  [handler](tdsl::int32_t ec, const sql_command_query_result & r) {
+                                      handler(ec, r);
+                                  });
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Perform a remote procedure call, asynchronously.
+         *
+         * @see execute_rpc, async_execute_query
+         *
+         * @param [in] handler Completion handler with
+         *             void(tdsl::int32_t net_error, sql_command_rpc_result)
+         *             signature. Must be copy-constructible. Invoked before the
+         *             function returns if @p mode is invalid.
+         */
+        template <typename T, typename Handler,
+                  traits::enable_when::same_any_of<T, string_view, wstring_view,
+                                                   struct progmem_string_view> = true>
+        inline void async_execute_rpc(T command, tdsl::span<sql_parameter_binding> params,
+                                      sql_command_rpc_mode mode,
+                                      sql_command_row_callback row_callback, void * rcb_uptr,
+                                      Handler handler) noexcept {
+            TDSL_ASSERT(tds_ctx.is_authenticated());
+            sql_command_type * cctx = async_command_context();
+            if (nullptr == cctx) {
+                handler(tdsl::int32_t{-1}, sql_command_rpc_result{tdsl::uint32_t{0}});
+                return;
+            }
+
+            const auto prep_result =
+                cctx->prepare_rpc(command, params, mode, row_callback, rcb_uptr);
+            if (not prep_result) {
+                handler(tdsl::int32_t{0},
+                        sql_command_rpc_result{tdsl::unexpected(prep_result.error())});
+                return;
+            }
+
+            async_execute_command(
+                cctx, e_tds_message_type::rpc,
+                [cctx, handler](tdsl::int32_t ec, const sql_command_query_result & r) {
+                    if (cctx->is_rpc_aborted()) {
+                        handler(ec, sql_command_rpc_result{tdsl::unexpected(
+                                        e_rpc_error_code::invalid_parameter_length)});
+                        return;
+                    }
+                    handler(ec, sql_command_rpc_result{tdsl::uint32_t{r.affected_rows}});
+                });
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Enable/disable column name reading for the result
          * set returned from the commands
@@ -282,17 +645,238 @@ namespace tdsl { namespace detail {
             command_options.flags.read_colnames = value;
         }
 
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Set the command timeout for the subsequent commands.
+         *
+         * When the server does not respond within @p timeout_ms, the command
+         * is cancelled with an ATTENTION message (see cancel()) and the
+         * result has its attn() status bit set. Only effective with the network
+         * implementations that support receive timeouts.
+         *
+         * The timeout bounds the time the driver waits for the server to send
+         * anything (inactivity), not the total time the command takes. A
+         * command that keeps receiving data (e.g. a large result set) is
+         * not cancelled, no matter how long it takes.
+         *
+         * @param [in] timeout_ms The timeout in milliseconds (0 = no timeout)
+         */
+        inline void option_set_command_timeout(tdsl::uint32_t timeout_ms) noexcept {
+            command_options.timeout_ms = timeout_ms;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Stream the large fields (text, ntext, image & (max) types) of the
+         * result sets of the subsequent commands to @p sink in chunks, instead
+         * of delivering them in the rows. Keeps the memory needed to read such
+         * fields bounded by the packet size.
+         *
+         * @param [in] sink Sink function (nullptr to disable streaming)
+         * @param [in] sink_uptr User supplied pointer, passed to @p sink as
+         *             first argument on every invocation
+         *
+         * @see command_context::set_stream_sink
+         */
+        inline void option_set_stream_sink(sql_command_stream_sink sink,
+                                           void * sink_uptr = nullptr) noexcept {
+            command_options.stream_sink = {sink, sink_uptr};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Cancel the command in progress.
+         *
+         * Meant to be called from the row callback (e.g. when enough rows are
+         * received). The server stops executing the command, and the command
+         * returns after the server acknowledges the cancellation, leaving the
+         * connection ready for the next command. The result of the cancelled
+         * command has its attn() status bit set.
+         *
+         * @return true if the cancellation is requested, false otherwise
+         */
+        inline bool cancel() noexcept {
+            return tds_ctx.cancel();
+        }
+
     private:
+        /**
+         * Send the cached login message and receive the login response,
+         * asynchronously. @p lctx is destroyed afterwards.
+         */
+        template <typename Handler>
+        inline void async_send_login(login_context_type * lctx, Handler handler) noexcept {
+            using login_context_allocator = tds_allocator<login_context_type>;
+
+            tds_ctx.write(login_cache.bytes());
+            tds_ctx.async_send_tds_pdu(
+                e_tds_message_type::login, [this, lctx, handler](tdsl::int32_t sr) {
+                    if (not(sr == 0)) {
+                        login_context_allocator::destroy(lctx);
+                        handler(e_driver_error_code::connection_failed);
+                        return;
+                    }
+
+                    tds_ctx.async_receive_tds_pdu([this, lctx, handler](tdsl::int32_t rr) {
+                        const bool logged_in =
+                            (rr == 0) &&
+                            (login_context_type::e_login_status::success == lctx->login_status());
+                        login_context_allocator::destroy(lctx);
+                        if (not logged_in) {
+                            login_cache.clear();
+                        }
+                        handler(logged_in ? e_driver_error_code::success
+                                          : e_driver_error_code::login_failed);
+                    });
+                });
+        }
+
+        // --------------------------------------------------------------------------------
+
+        template <typename T>
+        using joins_existing_login_member_fn_t =
+            decltype(traits::declval<const T &>().joins_existing_login());
+
+        // Whether the network implementation can share a login
+        // between the sessions (i.e. tdsl_netimpl_smp)
+        using has_joins_existing_login =
+            traits::is_detected<joins_existing_login_member_fn_t, tds_context_type>;
+
+        // --------------------------------------------------------------------------------
+
+        inline bool joins_existing_login(traits::true_type) const noexcept {
+            return tds_ctx.joins_existing_login();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline bool joins_existing_login(traits::false_type) const noexcept {
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Take over the login of the connection, including the TDS version
+         * the server has agreed on
+         */
+        inline void join_existing_login(traits::true_type) noexcept {
+            tds_ctx.tds_version         = tds_ctx.joined_tds_version();
+            tds_ctx.flags.authenticated = {true};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void join_existing_login(traits::false_type) noexcept {}
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Make the login of this session available to the
+         * sessions that join it later
+         */
+        inline void share_login(traits::true_type) noexcept {
+            tds_ctx.on_login(tds_ctx.tds_version);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void share_login(traits::false_type) noexcept {}
+
+        // --------------------------------------------------------------------------------
+
+        template <typename T>
+        using negotiates_prelogin_member_fn_t =
+            decltype(traits::declval<const T &>().negotiates_prelogin());
+
+        // Whether the network implementation performs the
+        // PRELOGIN handshake by itself (i.e. tdsl_netimpl_smp)
+        using has_negotiates_prelogin =
+            traits::is_detected<negotiates_prelogin_member_fn_t, tds_context_type>;
+
+        // --------------------------------------------------------------------------------
+
+        inline bool negotiates_prelogin(traits::true_type) const noexcept {
+            return tds_ctx.negotiates_prelogin();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline bool negotiates_prelogin(traits::false_type) const noexcept {
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Get the command context for an asynchronous command
+         *
+         * The command context is allocated by the first asynchronous command
+         * and reused by the following ones. It is re-initialized in place on
+         * every call, so it takes the TDS context callbacks back from the
+         * commands executed in between, and picks up the current options.
+         */
+        inline TDSL_NODISCARD auto async_command_context() noexcept -> sql_command_type * {
+            if (nullptr == async_cctx) {
+                async_cctx = tds_allocator<sql_command_type>::create(tds_ctx, command_options);
+                return async_cctx;
+            }
+            async_cctx->~sql_command_type();
+            new (async_cctx, placement_new_tag{}) sql_command_type(tds_ctx, command_options);
+            return async_cctx;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Send the command prepared in @p cctx as @p mtype, receive the
+         * response and invoke @p handler with the result.
+         */
+        template <typename Handler>
+        inline void async_execute_command(sql_command_type * cctx, e_tds_message_type mtype,
+                                          Handler handler) noexcept {
+            tds_ctx.async_send_tds_pdu(mtype, [this, cctx, handler](tdsl::int32_t sr) {
+                if (not(sr == 0)) {
+                    handler(sr, sql_command_query_result{});
+                    return;
+                }
+
+                tds_ctx.async_receive_tds_pdu([cctx, handler](tdsl::int32_t rr) {
+                    // The handler may start the next command, which
+                    // re-initializes the command context
+                    const sql_command_query_result result = cctx->result();
+                    handler(rr, result);
+                });
+            });
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Driver's TDS context. All TDS related
          * operations are routed through this object.
          */
         tds_context_type tds_ctx;
 
+        /**
+         * The LOGIN7 message of the last successful login,
+         * reused when reconnecting with the same parameters
+         */
+        typename login_context_type::login_packet_cache login_cache{};
+
         /**
          * Command options
          */
         sql_command_options_type command_options{};
+
+        /**
+         * Command context of the asynchronous commands
+         * (see async_command_context())
+         */
+        sql_command_type * async_cctx = {nullptr};
     };
 }} // namespace tdsl::detail
 
@@ -0,0 +1,573 @@
+/**
+ * ____________________________________________________
+ * Thread-safe connection pool for tdsl_driver
+ *
+ * @file   tdsl_driver_pool.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_DRIVER_POOL_HPP
+#define TDSL_DETAIL_DRIVER_POOL_HPP
+
+#include <tdslite/detail/tdsl_driver.hpp>
+#include <tdslite/util/tdsl_noncopyable.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+// The pool needs a hosted standard library (threads, mutexes and clocks),
+// so this header is not included by tdslite.hpp.
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tdsl { namespace detail {
+
+    /**
+     * A pool of established (connected & logged in) drivers
+     *
+     * Drivers are handed out as leases. A lease grants exclusive use of a
+     * driver, and returns it to the pool upon destruction. All member functions
+     * of the pool are thread-safe; a lease and the driver it holds are to be
+     * used by a single thread at a time.
+     *
+     * The pool does not start any background threads. Idle connections are
+     * evicted whenever a lease is returned, or when evict_idle() is called.
+     *
+     * @tparam DriverType Driver type (tdsl_driver<NetImpl>)
+     * @tparam ConnectionParameters Connection parameters type of the driver
+     */
+    template <typename DriverType,
+              typename ConnectionParameters = typename DriverType::connection_parameters>
+    struct tdsl_driver_pool : private util::noncopyable {
+        using driver_type           = DriverType;
+        using connection_parameters = ConnectionParameters;
+        using clock_type            = std::chrono::steady_clock;
+        using driver_factory        = std::function<std::unique_ptr<driver_type>()>;
+        using health_check_fn       = std::function<bool(driver_type &)>;
+
+        // --------------------------------------------------------------------------------
+
+        enum class e_pool_error_code
+        {
+            success,
+            // No connection became available in time
+            timeout,
+            // A new connection was needed, but connect/login failed
+            connection_failed,
+            // The pool is closed
+            pool_closed
+        };
+
+        // --------------------------------------------------------------------------------
+
+        struct pool_options {
+            // Maximum amount of connections the pool can hold
+            tdsl::size_t max_connections                 = {8};
+            // Amount of connections established by warm_up(), and
+            // kept open by the idle eviction.
+            tdsl::size_t min_connections                 = {1};
+            // Connections that stay idle longer are closed, as long as
+            // there are more than min_connections.
+            std::chrono::milliseconds idle_timeout       = std::chrono::milliseconds{60000};
+            // Connections that stay idle longer are health-checked before
+            // they are handed out, and re-established if the check fails.
+            std::chrono::milliseconds health_check_after = std::chrono::milliseconds{5000};
+            // How long acquire() waits for a connection by default
+            std::chrono::milliseconds acquire_timeout    = std::chrono::milliseconds{30000};
+            // Reset the session state (temporary tables, SET options, open
+            // transactions...) when a connection is reused by another lease.
+            // The reset rides along with the next command; it costs no round trip.
+            bool reset_on_reuse                          = {true};
+        };
+
+    private:
+        enum class e_slot_state : tdsl::uint8_t
+        {
+            // Not connected
+            empty,
+            // Connected, waiting to be leased
+            idle,
+            // Owned by a lease, or by the pool while (re)connecting or evicting
+            busy
+        };
+
+        struct slot {
+            std::unique_ptr<driver_type> driver = {};
+            e_slot_state state                  = {e_slot_state::empty};
+            clock_type::time_point idle_since   = {};
+        };
+
+    public:
+        /**
+         * Exclusive handle to a pooled driver
+         *
+         * Returns the driver to the pool upon destruction.
+         */
+        struct lease : private util::noncopyable {
+
+            lease(lease && other) noexcept :
+                pool(other.pool), s(other.s), ec(other.ec), broken(other.broken) {
+                other.pool = nullptr;
+                other.s    = nullptr;
+            }
+
+            ~lease() {
+                release();
+            }
+
+            /**
+             * Whether the lease holds a driver
+             */
+            inline explicit operator bool() const noexcept {
+                return nullptr != s;
+            }
+
+            /**
+             * The reason why the lease does not hold a driver
+             */
+            inline e_pool_error_code error() const noexcept {
+                return ec;
+            }
+
+            inline driver_type & operator*() const noexcept {
+                TDSL_ASSERT(s);
+                return *s->driver;
+            }
+
+            inline driver_type * operator->() const noexcept {
+                TDSL_ASSERT(s);
+                return s->driver.get();
+            }
+
+            /**
+             * Mark the connection as unusable (e.g. after a network
+             * error). It is closed instead of being returned to the
+             * idle connections.
+             */
+            inline void invalidate() noexcept {
+                broken = {true};
+            }
+
+            /**
+             * Return the driver to the pool before the lease is destroyed
+             */
+            inline void release() noexcept {
+                if (pool && s) {
+                    pool->give_back(*s, broken);
+                }
+                pool = nullptr;
+                s    = nullptr;
+            }
+
+        private:
+            friend struct tdsl_driver_pool;
+
+            lease(tdsl_driver_pool * p, slot * sl) noexcept : pool(p), s(sl) {}
+
+            explicit lease(e_pool_error_code e) noexcept : ec(e) {}
+
+            tdsl_driver_pool * pool = {nullptr};
+            slot * s                = {nullptr};
+            e_pool_error_code ec    = {e_pool_error_code::success};
+            bool broken             = {false};
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Construct a new pool. No connections are made until
+         * warm_up() or acquire() is called.
+         *
+         * @param [in] opts Pool options
+         * @param [in] params Connection parameters. The strings referred by the
+         *             parameters must outlive the pool.
+         * @param [in] factory Function that creates a (not connected) driver.
+         *             Default-constructs the driver if not specified.
+         */
+        tdsl_driver_pool(const pool_options & opts, const connection_parameters & params,
+                         driver_factory factory = {}) :
+            options(opts), conn_params(params), make_driver(TDSL_MOVE(factory)),
+            slots(opts.max_connections) {
+            if (not make_driver) {
+                make_driver = [] { return std::unique_ptr<driver_type>{new driver_type{}}; };
+            }
+            if (options.min_connections > options.max_connections) {
+                options.min_connections = options.max_connections;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * D-tor. All leases must be returned by now.
+         */
+        ~tdsl_driver_pool() {
+            close();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Establish min_connections connections, in parallel.
+         *
+         * @return The amount of connections that are open after the warm-up
+         */
+        tdsl::size_t warm_up() {
+            std::vector<slot *> targets{};
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                tdsl::size_t open = {0};
+                for (auto & s : slots) {
+                    open += (s.state == e_slot_state::empty) ? 0 : 1;
+                }
+                for (auto & s : slots) {
+                    if (open + targets.size() >= options.min_connections) {
+                        break;
+                    }
+                    if (s.state == e_slot_state::empty) {
+                        s.state = e_slot_state::busy;
+                        targets.push_back(&s);
+                    }
+                }
+            }
+
+            std::vector<std::thread> workers{};
+            workers.reserve(targets.size());
+            for (slot * s : targets) {
+                workers.emplace_back([this, s] {
+                    const bool connected = establish(*s);
+                    std::lock_guard<std::mutex> lock{mtx};
+                    s->state      = connected ? e_slot_state::idle : e_slot_state::empty;
+                    s->idle_since = clock_type::now();
+                });
+            }
+            for (auto & w : workers) {
+                w.join();
+            }
+            cv.notify_all();
+
+            std::lock_guard<std::mutex> lock{mtx};
+            tdsl::size_t open = {0};
+            for (const auto & s : slots) {
+                open += (s.state == e_slot_state::empty) ? 0 : 1;
+            }
+            return open;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Lease a driver, waiting at most options.acquire_timeout
+         */
+        inline lease acquire() {
+            return acquire(options.acquire_timeout);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Lease a driver, waiting at most @p timeout for one to become available.
+         *
+         * Idle connections are preferred, the most recently used first. A new
+         * connection is established if there are none and the pool is not full.
+         *
+         * @param [in] timeout Maximum time to wait
+         *
+         * @returns A lease holding the driver on success
+         * @returns A lease with e_pool_error_code::timeout if all connections
+         *          stayed in use for @p timeout
+         * @returns A lease with e_pool_error_code::connection_failed if a new
+         *          connection was needed, but it could not be established
+         * @returns A lease with e_pool_error_code::pool_closed if the pool is closed
+         */
+        lease acquire(std::chrono::milliseconds timeout) {
+            const auto deadline = clock_type::now() + timeout;
+            std::unique_lock<std::mutex> lock{mtx};
+
+            for (;;) {
+                if (closed) {
+                    return lease{e_pool_error_code::pool_closed};
+                }
+
+                if (slot * s = pick(e_slot_state::idle)) {
+                    s->state                 = e_slot_state::busy;
+                    const bool needs_checkup = clock_type::now() - s->idle_since >=
+                                               options.health_check_after;
+                    lock.unlock();
+                    if (needs_checkup && not is_healthy(*s->driver)) {
+                        s->driver->disconnect();
+                        if (not establish(*s)) {
+                            return connect_failed(*s);
+                        }
+                    }
+                    return lease{this, s};
+                }
+
+                if (slot * s = pick(e_slot_state::empty)) {
+                    s->state = e_slot_state::busy;
+                    lock.unlock();
+                    if (not establish(*s)) {
+                        return connect_failed(*s);
+                    }
+                    return lease{this, s};
+                }
+
+                if (cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    if (pick(e_slot_state::idle) || pick(e_slot_state::empty)) {
+                        continue;
+                    }
+                    return lease{e_pool_error_code::timeout};
+                }
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Close the connections that have been idle for longer than
+         * options.idle_timeout, keeping at least options.min_connections open.
+         *
+         * @return The amount of closed connections
+         */
+        tdsl::size_t evict_idle() {
+            std::vector<slot *> victims{};
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                const auto now    = clock_type::now();
+                tdsl::size_t open = {0};
+                for (const auto & s : slots) {
+                    open += (s.state == e_slot_state::empty) ? 0 : 1;
+                }
+                for (auto & s : slots) {
+                    if (open <= options.min_connections) {
+                        break;
+                    }
+                    if (s.state == e_slot_state::idle &&
+                        now - s.idle_since >= options.idle_timeout) {
+                        s.state = e_slot_state::busy;
+                        victims.push_back(&s);
+                        open--;
+                    }
+                }
+            }
+
+            for (slot * s : victims) {
+                s->driver->disconnect();
+            }
+
+            if (not victims.empty()) {
+                {
+                    std::lock_guard<std::mutex> lock{mtx};
+                    for (slot * s : victims) {
+                        s->state = e_slot_state::empty;
+                    }
+                }
+                cv.notify_all();
+            }
+            return victims.size();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Close the pool. Idle connections are closed immediately, and the
+         * leased ones when they are returned. Waiting acquire() calls
+         * return with e_pool_error_code::pool_closed.
+         */
+        void close() {
+            std::vector<slot *> idle{};
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                closed = {true};
+                for (auto & s : slots) {
+                    if (s.state == e_slot_state::idle) {
+                        s.state = e_slot_state::busy;
+                        idle.push_back(&s);
+                    }
+                }
+            }
+            cv.notify_all();
+
+            for (slot * s : idle) {
+                s->driver->disconnect();
+            }
+
+            std::lock_guard<std::mutex> lock{mtx};
+            for (slot * s : idle) {
+                s->state = e_slot_state::empty;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Replace the health check. By default, a connection is healthy
+         * if `SELECT 1` returns a single row.
+         */
+        inline void set_health_check(health_check_fn fn) {
+            std::lock_guard<std::mutex> lock{mtx};
+            health_check = TDSL_MOVE(fn);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The amount of open connections (idle or leased)
+         */
+        tdsl::size_t open_connections() const {
+            std::lock_guard<std::mutex> lock{mtx};
+            tdsl::size_t open = {0};
+            for (const auto & s : slots) {
+                open += (s.state == e_slot_state::empty) ? 0 : 1;
+            }
+            return open;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * The amount of idle connections
+         */
+        tdsl::size_t idle_connections() const {
+            std::lock_guard<std::mutex> lock{mtx};
+            tdsl::size_t idle = {0};
+            for (const auto & s : slots) {
+                idle += (s.state == e_slot_state::idle) ? 1 : 0;
+            }
+            return idle;
+        }
+
+    private:
+        /**
+         * Pick the slot in @p state that became idle most recently
+         * (lock must be held)
+         */
+        inline slot * pick(e_slot_state state) noexcept {
+            slot * result = {nullptr};
+            for (auto & s : slots) {
+                if (s.state == state && (nullptr == result || s.idle_since > result->idle_since)) {
+                    result = &s;
+                }
+            }
+            return result;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Connect the driver of slot @p s (lock must not be held)
+         */
+        bool establish(slot & s) {
+            if (not s.driver) {
+                s.driver = make_driver();
+                if (not s.driver) {
+                    return false;
+                }
+            }
+            if (driver_type::e_driver_error_code::success == s.driver->connect(conn_params)) {
+                return true;
+            }
+            // Login may have failed on a connected socket
+            s.driver->disconnect();
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Run the health check on @p driver (lock must not be held)
+         */
+        bool is_healthy(driver_type & driver) {
+            health_check_fn fn{};
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                fn = health_check;
+            }
+            if (fn) {
+                return fn(driver);
+            }
+
+            tdsl::uint32_t rows = {0};
+            const auto result   = driver.execute_query(
+                tdsl::string_view{"SELECT 1"},
+                +[](void * uptr, const tds_colmetadata_token &, const tdsl_row &) {
+                    ++*static_cast<tdsl::uint32_t *>(uptr);
+                },
+                &rows);
+            return static_cast<bool>(result) && rows == 1;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Free slot @p s after a failed connection attempt
+         */
+        lease connect_failed(slot & s) {
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                s.state = e_slot_state::empty;
+            }
+            cv.notify_one();
+            return lease{e_pool_error_code::connection_failed};
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Return the slot @p s owned by a lease to the pool
+         */
+        void give_back(slot & s, bool broken) noexcept {
+            if (options.reset_on_reuse && not broken) {
+                s.driver->reset_connection();
+            }
+
+            bool keep = {false};
+            {
+                std::lock_guard<std::mutex> lock{mtx};
+                keep = not(broken || closed);
+                if (keep) {
+                    s.state      = e_slot_state::idle;
+                    s.idle_since = clock_type::now();
+                }
+            }
+
+            if (not keep) {
+                s.driver->disconnect();
+                std::lock_guard<std::mutex> lock{mtx};
+                s.state = e_slot_state::empty;
+            }
+            cv.notify_one();
+
+            if (keep) {
+                evict_idle();
+            }
+        }
+
+        pool_options options;
+        connection_parameters conn_params;
+        driver_factory make_driver;
+        health_check_fn health_check = {};
+        // The slots are never reallocated, so the leases can point to them.
+        std::vector<slot> slots;
+        mutable std::mutex mtx{};
+        std::condition_variable cv{};
+        bool closed = {false};
+    };
+
+}} // namespace tdsl::detail
+
+namespace tdsl {
+
+    template <typename NetImpl>
+    using driver_pool = detail::tdsl_driver_pool<detail::tdsl_driver<NetImpl>>;
+
+} // namespace tdsl
+
+#endif
@@ -15,11 +15,14 @@
 
 #include <tdslite/detail/tdsl_lang_code_id.hpp>
 #include <tdslite/detail/tdsl_version.hpp>
+#include <tdslite/detail/tdsl_prelogin.hpp>
 #include <tdslite/detail/tdsl_tds_context.hpp>
 #include <tdslite/detail/tdsl_mssql_error_codes.hpp>
 #include <tdslite/detail/tdsl_callback.hpp>
 #include <tdslite/detail/tdsl_string_writer.hpp>
 #include <tdslite/detail/tdsl_tds_header.hpp>
+#include <tdslite/detail/tdsl_allocator.hpp>
+#include <tdslite/detail/tdsl_prepared_statement_cache.hpp>
 
 #include <tdslite/util/tdsl_inttypes.hpp>
 #include <tdslite/util/tdsl_macrodef.hpp>
@@ -29,6 +32,8 @@
 #include <tdslite/util/tdsl_byte_swap.hpp>
 #include <tdslite/util/tdsl_debug_print.hpp>
 
+#include <string.h> // needed for memcpy
+
 namespace tdsl {
 
     struct progmem_string_view;
@@ -83,6 +88,8 @@ namespace tdsl {
                 tdsl::uint32_t timezone{0};                 // Timezone
                 tdsl::uint32_t collation{0};                // Collation
                 tdsl::uint8_t client_id [6]{0};             // Client ID
+                // Requested TDS version (default = 7.4)
+                e_tds_version tds_version{e_tds_version::sql_server_2012};
             };
 
             /**
@@ -102,19 +109,21 @@ namespace tdsl {
 
             enum class e_tds_login_parameter_idx : tdsl::uint8_t
             {
-                begin         = 0,
-                client_name   = begin,
-                user_name     = 1,
-                password      = 2,
-                app_name      = 3,
-                server_name   = 4,
-                unused        = 5,
-                library_name  = 6,
-                locale        = 7,
-                database_name = 8,
-                client_id     = 9,
-                sspi          = 10,
-                atchdbfile    = 11,
+                begin           = 0,
+                client_name     = begin,
+                user_name       = 1,
+                password        = 2,
+                app_name        = 3,
+                server_name     = 4,
+                unused          = 5,
+                library_name    = 6,
+                locale          = 7,
+                database_name   = 8,
+                client_id       = 9,
+                sspi            = 10,
+                atchdbfile      = 11,
+                change_password = 12, // TDS 7.2+
+                sspi_long       = 13, // TDS 7.2+
                 end
             };
 
@@ -124,6 +133,170 @@ namespace tdsl {
                 failure = -1
             };
 
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Encoded LOGIN7 message of the last successful login
+             *
+             * Encoding the message expands every string into UTF-16 and
+             * encodes the password, which is wasted work when the same
+             * parameters are used to reconnect. The cache keeps the encoded
+             * bytes along with a fingerprint of the parameters, so a reconnect
+             * with the same parameters only copies the bytes.
+             *
+             * The user name, the password and the database name are kept
+             * along with the message and compared on lookup, so a fingerprint
+             * collision can never log in with another user's credentials.
+             */
+            struct login_packet_cache {
+                using allocator = tds_allocator<tdsl::uint8_t>;
+
+                login_packet_cache() noexcept                                       = default;
+                login_packet_cache(const login_packet_cache &)                      = delete;
+                login_packet_cache & operator=(const login_packet_cache &) noexcept = delete;
+
+                // --------------------------------------------------------------------------------
+
+                inline ~login_packet_cache() noexcept {
+                    clear();
+                }
+
+                // --------------------------------------------------------------------------------
+
+                /**
+                 * Whether the cache holds the message for @p params
+                 */
+                template <typename LoginParamsType>
+                inline TDSL_NODISCARD bool matches(const LoginParamsType & params) const noexcept {
+                    if (not data || not(fingerprint == login_context::fingerprint(params))) {
+                        return false;
+                    }
+                    tdsl::uint32_t offset = size;
+                    return field_matches(offset, e_field::user_name, params.user_name) &&
+                           field_matches(offset, e_field::password, params.password) &&
+                           field_matches(offset, e_field::db_name, params.db_name);
+                }
+
+                // --------------------------------------------------------------------------------
+
+                /**
+                 * The cached message
+                 */
+                inline TDSL_NODISCARD auto bytes() const noexcept -> byte_view {
+                    return byte_view{data, size};
+                }
+
+                // --------------------------------------------------------------------------------
+
+                /**
+                 * Replace the cached message with @p message
+                 *
+                 * The cache stays empty if the allocation fails.
+                 *
+                 * @param [in] params Login parameters that @p message is encoded from
+                 * @param [in] message Encoded LOGIN7 message
+                 */
+                template <typename LoginParamsType>
+                inline void store(const LoginParamsType & params, byte_view message) noexcept {
+                    clear();
+                    field_sizes [e_field::user_name] = byte_size_of(params.user_name);
+                    field_sizes [e_field::password]  = byte_size_of(params.password);
+                    field_sizes [e_field::db_name]   = byte_size_of(params.db_name);
+                    data = allocator::allocate(static_cast<tdsl::uint32_t>(message.size()) +
+                                               fields_size());
+                    if (not data) {
+                        clear();
+                        return;
+                    }
+                    size        = static_cast<tdsl::uint32_t>(message.size());
+                    fingerprint = login_context::fingerprint(params);
+                    memcpy(data, message.data(), size);
+                    tdsl::uint32_t offset = size;
+                    store_field(offset, e_field::user_name, params.user_name);
+                    store_field(offset, e_field::password, params.password);
+                    store_field(offset, e_field::db_name, params.db_name);
+                }
+
+                // --------------------------------------------------------------------------------
+
+                /**
+                 * Drop the cached message
+                 *
+                 * The message and the stored credentials are wiped before the
+                 * memory is freed, so they do not linger in the free heap.
+                 */
+                inline void clear() noexcept {
+                    if (data) {
+                        wipe(data, size + fields_size());
+                        allocator::deallocate(data, size + fields_size());
+                    }
+                    data        = {nullptr};
+                    size        = {0};
+                    fingerprint = {0};
+                    for (auto & fs : field_sizes) {
+                        fs = {0};
+                    }
+                }
+
+            private:
+                // The verified login parameters, in storage order
+                enum e_field : tdsl::uint8_t
+                {
+                    user_name = 0,
+                    password,
+                    db_name,
+                    count
+                };
+
+                /**
+                 * Zero @p sz bytes at @p p. The writes go through a volatile
+                 * pointer so the compiler cannot drop them as dead stores
+                 * to memory that is about to be freed.
+                 */
+                static inline void wipe(tdsl::uint8_t * p, tdsl::uint32_t sz) noexcept {
+                    volatile tdsl::uint8_t * vp = p;
+                    while (sz--) {
+                        *vp++ = 0;
+                    }
+                }
+
+                inline TDSL_NODISCARD tdsl::uint32_t fields_size() const noexcept {
+                    return field_sizes [e_field::user_name] + field_sizes [e_field::password] +
+                           field_sizes [e_field::db_name];
+                }
+
+                template <typename SV>
+                static inline TDSL_NODISCARD tdsl::uint32_t byte_size_of(const SV & sv) noexcept {
+                    return static_cast<tdsl::uint32_t>(sv.size() * sizeof(*sv.data()));
+                }
+
+                template <typename SV>
+                inline void store_field(tdsl::uint32_t & offset, e_field field,
+                                        const SV & sv) noexcept {
+                    if (field_sizes [field]) {
+                        memcpy(data + offset, sv.data(), field_sizes [field]);
+                    }
+                    offset += field_sizes [field];
+                }
+
+                template <typename SV>
+                inline TDSL_NODISCARD bool field_matches(tdsl::uint32_t & offset, e_field field,
+                                                         const SV & sv) const noexcept {
+                    if (not(field_sizes [field] == byte_size_of(sv))) {
+                        return false;
+                    }
+                    const bool eq = (field_sizes [field] == 0) ||
+                                    (memcmp(data + offset, sv.data(), field_sizes [field]) == 0);
+                    offset += field_sizes [field];
+                    return eq;
+                }
+
+                tdsl::uint8_t * data                       = {nullptr};
+                tdsl::uint32_t size                        = {0};
+                tdsl::uint32_t field_sizes [e_field::count] = {};
+                tdsl::uint64_t fingerprint                 = {0};
+            };
+
         private:
             tds_context_type & tds_ctx;
 
@@ -147,6 +320,7 @@ namespace tdsl {
 
             static_assert(sizeof(tds_login7_header) == 36, "Invalid TDS Login7 header size");
 
+
         public:
             /**
              * Construct a new login context object
@@ -169,11 +343,16 @@ namespace tdsl {
 
             // --------------------------------------------------------------------------------
 
-            static inline constexpr auto calc_sizeof_offset_size_section() noexcept
+            /**
+             * Size of the offset/size table of the LOGIN7 message for TDS version @p v
+             */
+            static inline constexpr auto calc_sizeof_offset_size_section(e_tds_version v) noexcept
                 -> tdsl::uint16_t {
-                return ((static_cast<tdsl::uint16_t>(e_tds_login_parameter_idx::end) - 1) *
+                return ((static_cast<tdsl::uint16_t>(e_tds_login_parameter_idx::atchdbfile)) *
                         sizeof(tdsl::uint32_t)) +
-                       6 /*client id size*/;
+                       6 /*client id size*/ +
+                       // ibChangePassword, cchChangePassword & cbSSPILong
+                       (tds_version_at_least(v, e_tds_version::sql_server_2005) ? 8 : 0);
             }
 
             // --------------------------------------------------------------------------------
@@ -198,6 +377,54 @@ namespace tdsl {
 
             // --------------------------------------------------------------------------------
 
+            /**
+             * Perform the PRELOGIN handshake
+             *
+             * PRELOGIN must be the first message sent on a new connection, before
+             * the login. tdslite does not support encryption, so the handshake
+             * fails if the server insists on an encrypted connection.
+             *
+             * @param [in] mars Request MARS (multiple active result sets)
+             */
+            auto do_prelogin(bool mars = false) noexcept -> e_login_status {
+                prepare_prelogin(mars);
+                tds_ctx.send_tds_pdu(e_tds_message_type::pre_login);
+                tds_ctx.receive_tds_pdu();
+                return prelogin_status();
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Write the PRELOGIN message into the network buffer, without sending it.
+             *
+             * The message is sent as e_tds_message_type::pre_login. The result is
+             * available via prelogin_status() after the response is received.
+             *
+             * @param [in] mars Request MARS (multiple active result sets)
+             */
+            void prepare_prelogin(bool mars = false) noexcept {
+                tdsl::uint8_t message [prelogin::k_message_size];
+                prelogin::encode(message, mars);
+                tds_ctx.prelogin_response      = {};
+                tds_ctx.flags.prelogin_pending = {true};
+                tds_ctx.write(byte_view{message});
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * The result of the PRELOGIN handshake, after the response is received
+             */
+            inline TDSL_NODISCARD auto prelogin_status() const noexcept -> e_login_status {
+                const auto & response = tds_ctx.prelogin_response;
+                return (response.received && not response.requires_encryption())
+                           ? e_login_status::success
+                           : e_login_status::failure;
+            }
+
+            // --------------------------------------------------------------------------------
+
             /**
              * Attempt to login into the database engine with the specified login parameters
              *
@@ -207,11 +434,142 @@ namespace tdsl {
              */
             template <typename LoginParamsType>
             auto do_login(const LoginParamsType & params) noexcept -> e_login_status {
+                prepare_login(params);
+
+                // Send the login request.
+                tds_ctx.send_tds_pdu(e_tds_message_type::login);
+
+                // Receive the login response
+                tds_ctx.receive_tds_pdu();
+
+                return login_status();
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Attempt to login into the database engine with the specified login parameters,
+             * reusing the message in @p cache if it was encoded from the same parameters.
+             *
+             * The cache is updated on success and cleared on failure.
+             *
+             * @param [in] params Login parameters
+             * @param [in,out] cache Login message cache
+             */
+            template <typename LoginParamsType>
+            auto do_login(const LoginParamsType & params, login_packet_cache & cache) noexcept
+                -> e_login_status {
+                prepare_login(params, cache);
+                tds_ctx.send_tds_pdu(e_tds_message_type::login);
+                tds_ctx.receive_tds_pdu();
+
+                const auto status = login_status();
+                if (not(status == e_login_status::success)) {
+                    cache.clear();
+                }
+                return status;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * The result of the login, after the login response is received
+             */
+            inline TDSL_NODISCARD auto login_status() const noexcept -> e_login_status {
+                // TODO: More definitive login error codes
+                return tds_ctx.is_authenticated() ? e_login_status::success
+                                                  : e_login_status::failure;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Write the LOGIN7 message for @p params into the network buffer,
+             * copying it from @p cache if it was encoded from the same parameters.
+             * Otherwise, the message is encoded and stored into @p cache.
+             *
+             * @param [in] params Login parameters
+             * @param [in,out] cache Login message cache
+             */
+            template <typename LoginParamsType>
+            void prepare_login(const LoginParamsType & params,
+                               login_packet_cache & cache) noexcept {
+                if (cache.matches(params)) {
+                    tds_ctx.tds_version = params.tds_version;
+                    tds_ctx.write(cache.bytes());
+                    return;
+                }
+
+                const auto begin = tds_ctx.get_write_offset();
+                prepare_login(params);
+                cache.store(params, tds_ctx.written_bytes(begin));
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Compute a fingerprint (FNV-1a) of @p params
+             *
+             * Every value that ends up in the LOGIN7 message contributes
+             * to the fingerprint, so two parameter sets with the same
+             * fingerprint encode to the same message (barring collisions,
+             * see login_packet_cache).
+             *
+             * @param [in] params Login parameters
+             */
+            template <typename LoginParamsType>
+            static inline TDSL_NODISCARD auto fingerprint(const LoginParamsType & params) noexcept
+                -> tdsl::uint64_t {
+                fnv1a64_hasher h{};
+                h.mix_string(params.server_name);
+                h.mix_string(params.db_name);
+                h.mix_string(params.user_name);
+                h.mix_string(params.password);
+                h.mix_string(params.app_name);
+                h.mix_string(params.client_name);
+                h.mix_string(params.library_name);
+                h.mix(params.packet_size);
+                h.mix(params.client_program_version);
+                h.mix(params.client_pid);
+                h.mix(params.connection_id);
+                h.mix(params.option_flags_1);
+                h.mix(params.option_flags_2);
+                h.mix(params.sql_type_flags);
+                h.mix(params.option_flags_3);
+                h.mix(params.timezone);
+                h.mix(params.collation);
+                h.mix(static_cast<tdsl::uint32_t>(params.tds_version));
+                for (auto b : params.client_id) {
+                    h.mix(b);
+                }
+                return h.value;
+            }
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Write the LOGIN7 message for @p params into the network buffer
+             *
+             * The message is not sent. This allows the caller to send the
+             * message and receive the response by other means (e.g. asynchronously).
+             *
+             * @param [in] params Login parameters
+             */
+            template <typename LoginParamsType>
+            void prepare_login(const LoginParamsType & params) noexcept {
+
+                // The fields that are added in TDS 7.2 are
+                // omitted when an older version is requested.
+                const bool is_tds72 =
+                    tds_version_at_least(params.tds_version, e_tds_version::sql_server_2005);
+
+                // The responses are parsed according to the requested
+                // version until the server acknowledges the login.
+                tds_ctx.tds_version = params.tds_version;
 
                 // Put a placeholder for length.
                 auto len_ph = tds_ctx.put_placeholder(0_tdsu32);
-                tds_ctx.write_be(
-                    static_cast<tdsl::uint32_t>(e_tds_version::sql_server_2000_sp1)); // TDS version
+                tds_ctx.write_be(static_cast<tdsl::uint32_t>(params.tds_version)); // TDS version
                 tds_ctx.write_le(params.packet_size); // Requested packet size by the client
                 tds_ctx.write_le(params.client_program_version); // Client program version
                 tds_ctx.write_le(params.client_pid);             // Client program PID
@@ -225,11 +583,11 @@ namespace tdsl {
 
                 // Calculate the total packet data section size.
                 tdsl::uint16_t total_packet_data_size =
-                    (sizeof(tds_login7_header)) + calc_sizeof_offset_size_section();
+                    (sizeof(tds_login7_header)) +
+                    calc_sizeof_offset_size_section(params.tds_version);
                 // Calculate the starting positiof of the offset/size table. This will act as base
                 // offset for the offset/size table's offset values.
-                constexpr tdsl::uint32_t string_table_offset_start =
-                    (sizeof(tds_login7_header)) + calc_sizeof_offset_size_section();
+                const tdsl::uint16_t string_table_offset_start = total_packet_data_size;
 
                 // Indicates the offset of the current string in the string table
                 tdsl::uint16_t current_string_offset = string_table_offset_start;
@@ -296,6 +654,11 @@ namespace tdsl {
                                 }
                                 continue;
                                 break;
+                            case param_idx::change_password:
+                                if (not is_tds72) {
+                                    continue;
+                                }
+                                TDSL_FALLTHROUGH;
                             case param_idx::locale:
                             case param_idx::atchdbfile:
 
@@ -305,6 +668,11 @@ namespace tdsl {
                                     tds_ctx.write(/*arg=*/0_tdsu16);
                                 }
                                 continue;
+                            case param_idx::sspi_long:
+                                if (is_tds72 && pt == pass_type::offset_size_table) {
+                                    tds_ctx.write(/*arg=*/0_tdsu32);
+                                }
+                                continue;
                             default: {
                                 TDSL_ASSERT(false);
                                 TDSL_UNREACHABLE;
@@ -353,16 +721,7 @@ namespace tdsl {
                 // Replace the placeholder value (0) with the actual packet
                 // length.
                 len_ph.write_le(tdsl::uint32_t{total_packet_data_size});
-                // Send the login request.
-                tds_ctx.send_tds_pdu(e_tds_message_type::login);
-
-                // Receive the login response
-                tds_ctx.receive_tds_pdu();
-
-                // TODO: More definitive login error codes
-                return tds_ctx.is_authenticated() ? e_login_status::success
-                                                  : e_login_status::failure;
-            } // ... void do_login_impl(const LoginParamsType & params) noexcept {
+            } // ... void prepare_login(const LoginParamsType & params) noexcept {
         };
     } // namespace detail
 } // namespace tdsl
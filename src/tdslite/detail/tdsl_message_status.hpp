@@ -39,6 +39,19 @@ namespace tdsl { namespace detail {
 #error "undefined endianness!"
 #endif
     };
+
+    /**
+     * Bit values of the TDS message status byte
+     */
+    enum class e_tds_message_status : tdsl::uint8_t
+    {
+        normal                     = 0x00,
+        end_of_message             = 0x01,
+        ignore_this_event          = 0x02,
+        event_notification         = 0x04,
+        reset_connection           = 0x08,
+        reset_connection_skip_tran = 0x10
+    };
 }} // namespace tdsl::detail
 
 #endif
\ No newline at end of file
@@ -91,6 +91,26 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Get a view of the bytes written since @p offset
+         *
+         * @param [in] offset Start offset, obtained from get_write_offset()
+         */
+        inline TDSL_NODISCARD auto written_bytes(tdsl::size_t offset) noexcept -> byte_view {
+            return static_cast<Derived &>(*this).do_get_written_bytes(offset);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Get current write offset
+         */
+        inline TDSL_NODISCARD auto get_write_offset() noexcept -> tdsl::size_t {
+            return static_cast<Derived &>(*this).do_get_write_offset();
+        }
+
+        // --------------------------------------------------------------------------------
+
         template <typename... Args>
         inline void send(Args &&... args) noexcept {
             static_cast<Derived &>(*this).do_send(TDSL_FORWARD(args)...);
@@ -104,6 +124,25 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Send the complete packets of the partial message in the buffer
+         * (see network_io_base::do_flush_tds_pdu)
+         */
+        inline void flush_tds_pdu(detail::e_tds_message_type mtype) noexcept {
+            static_cast<Derived &>(*this).do_flush_tds_pdu(mtype);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Get the amount of bytes that can be written without sending
+         */
+        inline TDSL_NODISCARD auto get_free_space() noexcept -> tdsl::size_t {
+            return static_cast<Derived &>(*this).do_get_free_space();
+        }
+
+        // --------------------------------------------------------------------------------
+
         template <typename T>
         struct placeholder {
 
@@ -0,0 +1,147 @@
+/**
+ * ____________________________________________________
+ * PRELOGIN message encoding & decoding
+ *
+ * @file   tdsl_prelogin.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_TDSL_PRELOGIN_HPP
+#define TDSL_DETAIL_TDSL_PRELOGIN_HPP
+
+#include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_debug_print.hpp>
+
+#include <string.h> // needed for memcpy
+
+namespace tdsl { namespace detail {
+
+    /**
+     * PRELOGIN message ([MS-TDS] 2.2.6.5)
+     *
+     * The message is a list of option tokens, each pointing to its
+     * data with a big-endian offset & length, followed by the option
+     * data. tdslite sends VERSION, ENCRYPTION (not supported), INSTOPT,
+     * THREADID and MARS options.
+     */
+    struct prelogin {
+        enum class e_option_token : tdsl::uint8_t
+        {
+            version    = 0x00,
+            encryption = 0x01,
+            instopt    = 0x02,
+            threadid   = 0x03,
+            mars       = 0x04,
+            terminator = 0xFF
+        };
+
+        enum class e_encryption : tdsl::uint8_t
+        {
+            off     = 0x00,
+            on      = 0x01,
+            not_sup = 0x02,
+            req     = 0x03
+        };
+
+        // Size of the encoded PRELOGIN message
+        static constexpr tdsl::size_t k_message_size = {39};
+
+        /**
+         * The server's PRELOGIN response
+         */
+        struct response {
+            // A complete response is received
+            bool received           = {false};
+            // The server has enabled MARS
+            bool mars               = {false};
+            // The server's encryption option
+            e_encryption encryption = {e_encryption::not_sup};
+
+            // --------------------------------------------------------------------------------
+
+            /**
+             * Whether the server insists on an encrypted connection,
+             * which tdslite does not support
+             */
+            inline TDSL_NODISCARD bool requires_encryption() const noexcept {
+                return encryption == e_encryption::on || encryption == e_encryption::req;
+            }
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Encode the PRELOGIN message into @p buf
+         *
+         * @param [out] buf Destination
+         * @param [in] mars Request MARS
+         */
+        static inline void encode(tdsl::uint8_t (&buf) [k_message_size], bool mars) noexcept {
+            // VERSION, ENCRYPTION, INSTOPT, THREADID, MARS, TERMINATOR
+            // followed by the option data.
+            static constexpr tdsl::uint8_t k_message [k_message_size] = {
+                0x00, 0x00, 0x1A, 0x00, 0x06, 0x01, 0x00, 0x20, 0x00, 0x01,
+                0x02, 0x00, 0x21, 0x00, 0x01, 0x03, 0x00, 0x22, 0x00, 0x04,
+                0x04, 0x00, 0x26, 0x00, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+            memcpy(buf, k_message, k_message_size);
+            buf [k_message_size - 1] = mars ? 0x01 : 0x00;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Decode the PRELOGIN response in @p msg into @p out
+         *
+         * The options that tdslite does not use are skipped.
+         *
+         * @param [in] msg Response message
+         * @param [out] out Decoded response. out.received is set
+         *             when the response is complete.
+         *
+         * @return Amount of needed bytes to decode a complete response, if any.
+         */
+        static inline TDSL_NODISCARD tdsl::uint32_t decode(byte_view msg, response & out) noexcept {
+            constexpr tdsl::size_t k_option_size = 5;
+            const tdsl::size_t size              = msg.size_bytes();
+            response result{};
+            for (tdsl::size_t pos = 0;; pos += k_option_size) {
+                if (pos >= size) {
+                    return 1;
+                }
+                const auto token = static_cast<e_option_token>(msg [pos]);
+                if (token == e_option_token::terminator) {
+                    break;
+                }
+                if (pos + k_option_size > size) {
+                    return static_cast<tdsl::uint32_t>(pos + k_option_size - size);
+                }
+                const tdsl::size_t offset = (msg [pos + 1] << 8) | msg [pos + 2];
+                const tdsl::size_t length = (msg [pos + 3] << 8) | msg [pos + 4];
+                if (offset + length > size) {
+                    return static_cast<tdsl::uint32_t>(offset + length - size);
+                }
+                if (length == 1 && token == e_option_token::mars) {
+                    result.mars = msg [offset] == 0x01;
+                }
+                else if (length == 1 && token == e_option_token::encryption) {
+                    result.encryption = static_cast<e_encryption>(msg [offset]);
+                }
+            }
+
+            TDSL_DEBUG_PRINTLN("prelogin::decode(...) -> mars: %d, encryption: %d", result.mars,
+                               static_cast<int>(result.encryption));
+            result.received = {true};
+            out             = result;
+            return 0;
+        }
+    };
+}} // namespace tdsl::detail
+
+#endif
@@ -0,0 +1,408 @@
+/**
+ * ____________________________________________________
+ * Per-connection cache of prepared statement handles
+ *
+ * @file   tdsl_prepared_statement_cache.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_TDSL_PREPARED_STATEMENT_CACHE_HPP
+#define TDSL_DETAIL_TDSL_PREPARED_STATEMENT_CACHE_HPP
+
+#include <tdslite/detail/tdsl_allocator.hpp>
+#include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_noncopyable.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include <string.h> // needed for memcmp
+
+// Amount of prepared statement handles kept per connection.
+// Define as 0 to disable caching.
+#ifndef TDSL_PREPARED_STATEMENT_CACHE_CAPACITY
+#define TDSL_PREPARED_STATEMENT_CACHE_CAPACITY 8
+#endif
+
+namespace tdsl { namespace detail {
+
+    /**
+     * 64-bit FNV-1a hasher for the prepared statement fingerprints
+     */
+    struct fnv1a64_hasher {
+        tdsl::uint64_t value = {0xCBF29CE484222325};
+
+        inline void mix(tdsl::uint32_t v) noexcept {
+            for (tdsl::uint32_t i = 0; i < sizeof(v); i++) {
+                value = (value ^ ((v >> (i * 8)) & 0xFF)) * 0x100000001B3;
+            }
+        }
+
+        template <typename SV>
+        inline void mix_string(const SV & sv) noexcept {
+            mix(static_cast<tdsl::uint32_t>(sv.size()));
+            for (auto ch : sv) {
+                mix(static_cast<tdsl::uint32_t>(ch));
+            }
+        }
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * The key of a prepared statement: the SQL text and the parameter
+     * declarations, as UTF-16 code units, along with their fingerprint.
+     *
+     * The key is produced by a key writer, which is a function object
+     * that writes the key to the sink it is called with:
+     *
+     *     template <typename Sink>
+     *     void operator()(Sink & sink) const noexcept;
+     *
+     * The sinks take code units through put(), and strings of any
+     * character type through write_units() (string_view through write(),
+     * too). So a key writer can be compared against a key, or be hashed,
+     * without making a copy of the key.
+     */
+    struct statement_key : public util::noncopyable {
+        using allocator = tds_allocator<char16_t>;
+
+        statement_key() noexcept = default;
+
+        // --------------------------------------------------------------------------------
+
+        statement_key(statement_key && other) noexcept {
+            *this = TDSL_MOVE(other);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        statement_key & operator=(statement_key && other) noexcept {
+            if (this != &other) {
+                clear();
+                units             = other.units;
+                length            = other.length;
+                fingerprint       = other.fingerprint;
+                other.units       = {nullptr};
+                other.length      = {0};
+                other.fingerprint = {0};
+            }
+            return *this;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        ~statement_key() noexcept {
+            clear();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Fingerprint of the key written by @p kw
+         */
+        template <typename KeyWriter>
+        static inline TDSL_NODISCARD tdsl::uint64_t fingerprint_of(const KeyWriter & kw) noexcept {
+            hash_sink sink{};
+            kw(sink);
+            return sink.h.value;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Replace the key with a copy of the key written by @p kw
+         *
+         * @return true if successful, false if memory allocation failed
+         */
+        template <typename KeyWriter>
+        inline TDSL_NODISCARD bool assign(const KeyWriter & kw) noexcept {
+            clear();
+            hash_sink hs{};
+            kw(hs);
+            if (hs.length) {
+                units = allocator::allocate(hs.length);
+                if (nullptr == units) {
+                    return false;
+                }
+            }
+            copy_sink cs{units};
+            kw(cs);
+            length      = hs.length;
+            fingerprint = hs.h.value;
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the key written by @p kw, with fingerprint @p fp, is equal to this key
+         */
+        template <typename KeyWriter>
+        inline TDSL_NODISCARD bool matches(const KeyWriter & kw,
+                                           tdsl::uint64_t fp) const noexcept {
+            if (not(fingerprint == fp)) {
+                return false;
+            }
+            compare_sink sink{units, length};
+            kw(sink);
+            return sink.equal && sink.offset == length;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline TDSL_NODISCARD bool operator==(const statement_key & other) const noexcept {
+            return fingerprint == other.fingerprint && length == other.length &&
+                   (length == 0 || memcmp(units, other.units, length * sizeof(char16_t)) == 0);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void clear() noexcept {
+            if (units) {
+                allocator::deallocate(units, length);
+            }
+            units       = {nullptr};
+            length      = {0};
+            fingerprint = {0};
+        }
+
+    private:
+        /**
+         * Common part of the sinks, converts the strings to code units
+         */
+        template <typename Derived>
+        struct sink_base {
+            inline void write(const tdsl::string_view & sv) noexcept {
+                write_units(sv);
+            }
+
+            template <typename SV>
+            inline void write_units(const SV & sv) noexcept {
+                for (auto ch : sv) {
+                    static_cast<Derived *>(this)->put(static_cast<char16_t>(ch));
+                }
+            }
+        };
+
+        struct hash_sink : sink_base<hash_sink> {
+            inline void put(char16_t c) noexcept {
+                h.mix(static_cast<tdsl::uint32_t>(c));
+                length++;
+            }
+
+            fnv1a64_hasher h      = {};
+            tdsl::uint32_t length = {0};
+        };
+
+        struct copy_sink : sink_base<copy_sink> {
+            explicit copy_sink(char16_t * dst) noexcept : dst(dst) {}
+
+            inline void put(char16_t c) noexcept {
+                *dst++ = c;
+            }
+
+            char16_t * dst;
+        };
+
+        struct compare_sink : sink_base<compare_sink> {
+            compare_sink(const char16_t * units, tdsl::uint32_t length) noexcept :
+                units(units), length(length) {}
+
+            inline void put(char16_t c) noexcept {
+                equal  = equal && offset < length && units [offset] == c;
+                offset = offset + 1;
+            }
+
+            const char16_t * units;
+            tdsl::uint32_t length;
+            tdsl::uint32_t offset = {0};
+            bool equal            = {true};
+        };
+
+        char16_t * units           = {nullptr};
+        tdsl::uint32_t length      = {0};
+        tdsl::uint64_t fingerprint = {0};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Least recently used cache of prepared statement handles, keyed by
+     * the SQL text and the parameter declarations (see statement_key).
+     *
+     * The entries own a copy of their key, which is compared on lookup,
+     * so a fingerprint collision can never execute another statement.
+     *
+     * The handles are only valid for the connection (session) that
+     * prepared them, so the cache must be cleared when the session
+     * is reset or a new login is made. A handle that is evicted from
+     * the cache is kept as `unprepare pending` until it is released
+     * by sp_unprepare.
+     *
+     * @tparam Capacity Maximum amount of handles to keep
+     */
+    template <tdsl::uint32_t Capacity>
+    struct prepared_statement_cache : public util::noncopyable {
+
+        /**
+         * Look up the handle of the statement whose key is written by @p kw
+         *
+         * @param [in] kw Statement key writer
+         * @param [out] handle The handle, if found
+         *
+         * @return true if found, false otherwise
+         */
+        template <typename KeyWriter>
+        inline TDSL_NODISCARD bool find(const KeyWriter & kw, tdsl::int32_t & handle) noexcept {
+            const auto fp = statement_key::fingerprint_of(kw);
+            for (auto & e : entries) {
+                if (e.last_use && e.key.matches(kw, fp)) {
+                    e.last_use = ++clock;
+                    handle     = e.handle;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Store the @p handle of the statement with key @p key,
+         * evicting the least recently used handle if the cache is full.
+         *
+         * @param [in] key Statement key
+         * @param [in] handle Prepared statement handle
+         */
+        inline void insert(statement_key && key, tdsl::int32_t handle) noexcept {
+            entry * victim = &entries [0];
+            for (auto & e : entries) {
+                if (e.last_use == 0 || e.key == key) {
+                    victim = &e;
+                    break;
+                }
+                if (e.last_use < victim->last_use) {
+                    victim = &e;
+                }
+            }
+
+            if (victim->last_use && not(victim->key == key)) {
+                TDSL_ASSERT_MSG(not has_unprepare_pending(),
+                                "The evicted handle must be unprepared first!");
+                unprepare_pending = {true};
+                unprepare_handle  = victim->handle;
+            }
+            victim->key      = TDSL_MOVE(key);
+            victim->handle   = handle;
+            victim->last_use = ++clock;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether an evicted handle awaits sp_unprepare
+         */
+        inline TDSL_NODISCARD bool has_unprepare_pending() const noexcept {
+            return unprepare_pending;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Take the evicted handle that awaits sp_unprepare
+         */
+        inline TDSL_NODISCARD tdsl::int32_t take_unprepare_pending() noexcept {
+            TDSL_ASSERT(unprepare_pending);
+            unprepare_pending = {false};
+            return unprepare_handle;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Amount of cached handles
+         */
+        inline TDSL_NODISCARD tdsl::uint32_t size() const noexcept {
+            tdsl::uint32_t result = {0};
+            for (const auto & e : entries) {
+                result += (e.last_use ? 1 : 0);
+            }
+            return result;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Forget all handles. The server has already released them.
+         */
+        inline void clear() noexcept {
+            for (auto & e : entries) {
+                e.key.clear();
+                e.handle   = {0};
+                e.last_use = {0};
+            }
+            clock             = {0};
+            unprepare_handle  = {0};
+            unprepare_pending = {false};
+        }
+
+    private:
+        struct entry {
+            statement_key key      = {};
+            tdsl::int32_t handle   = {0};
+            // Zero means the entry is not in use
+            tdsl::uint32_t last_use = {0};
+        };
+
+        entry entries [Capacity]       = {};
+        tdsl::uint32_t clock           = {0};
+        tdsl::int32_t unprepare_handle = {0};
+        bool unprepare_pending         = {false};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Caching is disabled
+     */
+    template <>
+    struct prepared_statement_cache<0> {
+        template <typename KeyWriter>
+        inline TDSL_NODISCARD bool find(const KeyWriter &, tdsl::int32_t &) noexcept {
+            return false;
+        }
+
+        inline void insert(statement_key &&, tdsl::int32_t handle) noexcept {
+            // Release the handle right away
+            unprepare_pending = {true};
+            unprepare_handle  = handle;
+        }
+
+        inline TDSL_NODISCARD bool has_unprepare_pending() const noexcept {
+            return unprepare_pending;
+        }
+
+        inline TDSL_NODISCARD tdsl::int32_t take_unprepare_pending() noexcept {
+            unprepare_pending = {false};
+            return unprepare_handle;
+        }
+
+        inline TDSL_NODISCARD tdsl::uint32_t size() const noexcept {
+            return 0;
+        }
+
+        inline void clear() noexcept {
+            *this = {};
+        }
+
+    private:
+        tdsl::int32_t unprepare_handle = {0};
+        bool unprepare_pending         = {false};
+    };
+}} // namespace tdsl::detail
+
+#endif
@@ -25,6 +25,11 @@ namespace tdsl {
     /**
      * A type that represents a row in a result set.
      * Composed of N fields, where N is the field count.
+     *
+     * The field storage of the rows delivered to the row callback
+     * is allocated once per result set and reused for every row.
+     * Therefore, the row (and its fields) are only valid during
+     * the row callback invocation.
      */
     struct tdsl_row : util::noncopyable {
         enum class e_tdsl_row_make_err
@@ -39,6 +44,13 @@ namespace tdsl {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Default c-tor (empty row)
+         */
+        tdsl_row() noexcept = default;
+
+        // --------------------------------------------------------------------------------
+
         inline TDSL_NODISCARD auto begin() const noexcept -> fields_type_t::iterator {
             return fields.begin();
         }
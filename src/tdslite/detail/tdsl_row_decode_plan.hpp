@@ -0,0 +1,394 @@
+/**
+ * ____________________________________________________
+ * Pre-computed decode plan for the rows of a result set
+ *
+ * @file   tdsl_row_decode_plan.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_TDSL_ROW_DECODE_PLAN_HPP
+#define TDSL_DETAIL_TDSL_ROW_DECODE_PLAN_HPP
+
+#include <tdslite/detail/tdsl_allocator.hpp>
+#include <tdslite/detail/tdsl_data_type.hpp>
+#include <tdslite/detail/tdsl_tds_column_info.hpp>
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+#include <tdslite/util/tdsl_noncopyable.hpp>
+
+namespace tdsl { namespace detail {
+
+    /**
+     * Decode step for a single column of a row.
+     *
+     * Everything the row parser needs to know about a column,
+     * derived from the column's data type properties once per
+     * result set instead of once per field.
+     */
+    struct tds_column_decode_step {
+        // Width of the length prefix in bytes (0 for fixed size types)
+        tdsl::uint8_t length_prefix_size = {0};
+
+        struct {
+            // Field is prefixed with a TEXTPTR (text, ntext & image)
+            tdsl::uint8_t has_textptr : 1;
+            // Field is NULL when its length equals to `null_length`
+            tdsl::uint8_t has_null_length : 1;
+            // Field is a partially length-prefixed (PLP) stream of
+            // chunks ((max) types, TDS 7.2+)
+            tdsl::uint8_t is_plp : 1;
+            // Field is pushed to the stream sink in chunks instead of
+            // being delivered in the row (text, ntext, image & PLP)
+            tdsl::uint8_t is_streamed : 1;
+            tdsl::uint8_t reserved : 4;
+        } flags = {};
+
+        // Size of the field (fixed size types only)
+        tdsl::uint16_t fixed_size         = {0};
+
+        // Offset of the field from the start of the row (fixed-width rows only)
+        tdsl::uint16_t fixed_offset       = {0};
+
+        // Length value that represents NULL (only valid if has_null_length is set)
+        tdsl::uint32_t null_length        = {0};
+
+        // Bit N is set if N is a valid length for the field. Zero means
+        // that the type has no restrictions on the field length.
+        tdsl::uint32_t valid_length_mask  = {0};
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Check whether @p length is a valid field length for the column
+         */
+        inline TDSL_NODISCARD bool is_valid_length(tdsl::uint32_t length) const noexcept {
+            return valid_length_mask == 0 ||
+                   (length < 32 && ((valid_length_mask >> length) & tdsl::uint32_t{1}));
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Make a decode step for data type @p type
+         *
+         * @param [in] type Column data type
+         *
+         * @return tds_column_decode_step Decode step for the type
+         */
+        static inline TDSL_NODISCARD auto make(e_tds_data_type type) noexcept
+            -> tds_column_decode_step {
+            tds_column_decode_step step{};
+            const auto dprop        = get_data_type_props(type);
+            step.flags.has_textptr  = dprop.flags.has_textptr;
+
+            switch (dprop.size_type) {
+                case e_tds_data_size_type::fixed:
+                    step.fixed_size = dprop.length.fixed;
+                    // Fixed size types do not have a length prefix
+                    return step;
+                case e_tds_data_size_type::var_u8:
+                case e_tds_data_size_type::var_precision:
+                case e_tds_data_size_type::var_scale:
+                    step.length_prefix_size    = sizeof(tdsl::uint8_t);
+                    step.flags.has_null_length = dprop.flags.zero_represents_null;
+                    step.null_length           = 0;
+                    break;
+                case e_tds_data_size_type::var_u16:
+                    step.length_prefix_size    = sizeof(tdsl::uint16_t);
+                    step.flags.has_null_length = dprop.flags.maxlen_represents_null;
+                    step.null_length           = 0xFFFF;
+                    break;
+                case e_tds_data_size_type::var_u32:
+                    step.length_prefix_size    = sizeof(tdsl::uint32_t);
+                    step.flags.has_null_length = dprop.flags.maxlen_represents_null;
+                    step.null_length           = 0xFFFFFFFF;
+                    break;
+                case e_tds_data_size_type::unknown:
+                    TDSL_ASSERT_MSG(0, "unknown size_type");
+                    TDSL_UNREACHABLE;
+                    break;
+            }
+
+            // Fold the per-type length rules into a bitmask
+            tdsl::uint32_t mask = {0};
+            for (tdsl::uint32_t len = 0; len < 32; len++) {
+                if (is_valid_variable_length_for_type(type, len)) {
+                    mask |= (tdsl::uint32_t{1} << len);
+                }
+            }
+            // All lengths valid means there's no restriction
+            step.valid_length_mask = (mask == 0xFFFFFFFF) ? 0 : mask;
+            return step;
+        }
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Decode plan for the rows of a result set.
+     *
+     * Built once when the COLMETADATA token is received, and
+     * walked by the row parser for every row of the result set.
+     */
+    struct tds_row_decode_plan : public util::noncopyable {
+        using step_allocator_t = tds_allocator<tds_column_decode_step>;
+        using plp_allocator_t  = tds_allocator<tdsl::uint8_t>;
+
+        tdsl::span<tds_column_decode_step> steps = {};
+
+        // Size of a row in bytes, if all columns are fixed size
+        tdsl::uint32_t fixed_row_size            = {0};
+
+        // True if all columns are fixed size, which means
+        // every row of the result set has the same size.
+        bool is_fixed_width                      = {false};
+
+        // True if any of the columns is a PLP column
+        bool has_plp                             = {false};
+
+        // Scratch buffer for joining the chunks of the PLP
+        // fields. Grown on demand, reused for every row.
+        tdsl::uint8_t * plp_buffer               = {nullptr};
+        tdsl::uint32_t plp_buffer_size           = {0};
+
+        // Holds the fields of a row that precede a streamed field,
+        // since the network buffer is released while the streamed
+        // field is being received. Sized once for the largest row.
+        tdsl::uint8_t * spill_buffer             = {nullptr};
+        tdsl::uint32_t spill_buffer_size         = {0};
+
+        // --------------------------------------------------------------------------------
+
+        tds_row_decode_plan() noexcept           = default;
+
+        // --------------------------------------------------------------------------------
+
+        tds_row_decode_plan(tds_row_decode_plan && other) noexcept {
+            if (this != &other) {
+                maybe_release_resources();
+                steps                   = other.steps;
+                fixed_row_size          = other.fixed_row_size;
+                is_fixed_width          = other.is_fixed_width;
+                has_plp                 = other.has_plp;
+                plp_buffer              = other.plp_buffer;
+                plp_buffer_size         = other.plp_buffer_size;
+                spill_buffer            = other.spill_buffer;
+                spill_buffer_size       = other.spill_buffer_size;
+                other.steps             = {};
+                other.fixed_row_size    = {0};
+                other.is_fixed_width    = {false};
+                other.has_plp           = {false};
+                other.plp_buffer        = {nullptr};
+                other.plp_buffer_size   = {0};
+                other.spill_buffer      = {nullptr};
+                other.spill_buffer_size = {0};
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        tds_row_decode_plan & operator=(tds_row_decode_plan && other) noexcept {
+            if (this != &other) {
+                maybe_release_resources();
+                steps                   = other.steps;
+                fixed_row_size          = other.fixed_row_size;
+                is_fixed_width          = other.is_fixed_width;
+                has_plp                 = other.has_plp;
+                plp_buffer              = other.plp_buffer;
+                plp_buffer_size         = other.plp_buffer_size;
+                spill_buffer            = other.spill_buffer;
+                spill_buffer_size       = other.spill_buffer_size;
+                other.steps             = {};
+                other.fixed_row_size    = {0};
+                other.is_fixed_width    = {false};
+                other.has_plp           = {false};
+                other.plp_buffer        = {nullptr};
+                other.plp_buffer_size   = {0};
+                other.spill_buffer      = {nullptr};
+                other.spill_buffer_size = {0};
+            }
+            return *this;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        ~tds_row_decode_plan() noexcept {
+            maybe_release_resources();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Build the decode plan for @p columns
+         *
+         * @param [in] columns Columns of the result set
+         * @param [in] stream_large_fields Stream the text, ntext, image
+         *             and PLP fields instead of delivering them in the row
+         *
+         * @return true if successful, false if memory allocation failed
+         */
+        inline TDSL_NODISCARD bool build(const tdsl::span<tds_column_info> & columns,
+                                         bool stream_large_fields = false) noexcept {
+            maybe_release_resources();
+            auto alloc = step_allocator_t::create_n(static_cast<tdsl::uint32_t>(columns.size()));
+            if (nullptr == alloc) {
+                return false;
+            }
+            steps          = tdsl::span<tds_column_decode_step>{alloc, columns.size()};
+            is_fixed_width = {true};
+            // The largest possible size of the non-streamed fields of a row,
+            // plus the null bitmap of NBCROW tokens
+            tdsl::uint32_t max_spill_size = static_cast<tdsl::uint32_t>(columns.size() + 7) / 8;
+            bool has_streamed             = {false};
+            for (tdsl::size_t i = 0; i < columns.size(); i++) {
+                steps [i] = tds_column_decode_step::make(columns [i].type);
+                // (max) columns have 0xFFFF as their maximum length
+                // and their fields are sent as PLP streams.
+                if (steps [i].length_prefix_size == sizeof(tdsl::uint16_t) &&
+                    columns [i].typeprops.u16l.length == 0xFFFF) {
+                    steps [i].flags.is_plp          = {true};
+                    steps [i].flags.has_null_length = {false};
+                    steps [i].length_prefix_size    = sizeof(tdsl::uint64_t);
+                    steps [i].valid_length_mask     = {0};
+                    has_plp                         = {true};
+                }
+                if (steps [i].length_prefix_size || steps [i].flags.has_textptr) {
+                    is_fixed_width = {false};
+                }
+                const bool is_large = steps [i].flags.has_textptr || steps [i].flags.is_plp;
+                if (stream_large_fields && is_large) {
+                    steps [i].flags.is_streamed = {true};
+                    has_streamed                = {true};
+                }
+                else if (stream_large_fields) {
+                    max_spill_size += max_field_size(steps [i], columns [i]);
+                }
+                steps [i].fixed_offset = static_cast<tdsl::uint16_t>(fixed_row_size);
+                fixed_row_size += steps [i].fixed_size;
+            }
+
+            if (not is_fixed_width) {
+                fixed_row_size = {0};
+            }
+
+            if (has_streamed) {
+                spill_buffer = plp_allocator_t::allocate(max_spill_size);
+                if (nullptr == spill_buffer) {
+                    return false;
+                }
+                spill_buffer_size = max_spill_size;
+            }
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline TDSL_NODISCARD auto operator[](tdsl::size_t index) const noexcept
+            -> const tds_column_decode_step & {
+            return steps [index];
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline TDSL_NODISCARD auto size() const noexcept -> tdsl::size_t {
+            return steps.size();
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline explicit operator bool() const noexcept {
+            return steps;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Ensure that the PLP scratch buffer can hold at least @p size bytes
+         *
+         * @param [in] size Required size
+         *
+         * @return true if successful, false if memory allocation failed
+         */
+        inline TDSL_NODISCARD bool reserve_plp_buffer(tdsl::uint32_t size) noexcept {
+            if (size <= plp_buffer_size) {
+                return true;
+            }
+            if (plp_buffer) {
+                plp_allocator_t::deallocate(plp_buffer, plp_buffer_size);
+                plp_buffer      = {nullptr};
+                plp_buffer_size = {0};
+            }
+            plp_buffer = plp_allocator_t::allocate(size);
+            if (nullptr == plp_buffer) {
+                return false;
+            }
+            plp_buffer_size = size;
+            return true;
+        }
+
+    private:
+        /**
+         * The largest possible size of a field of column @p column
+         */
+        static inline TDSL_NODISCARD auto max_field_size(const tds_column_decode_step & step,
+                                                         const tds_column_info & column) noexcept
+            -> tdsl::uint32_t {
+            switch (step.length_prefix_size) {
+                case 0:
+                    return step.fixed_size;
+                case sizeof(tdsl::uint8_t):
+                    // The date & time types only carry the scale in COLMETADATA,
+                    // so their length is the largest one of any scale.
+                    switch (column.type) {
+                        case e_tds_data_type::DATENTYPE:
+                            return 3;
+                        case e_tds_data_type::TIMENTYPE:
+                            return 5;
+                        case e_tds_data_type::DATETIME2NTYPE:
+                            return 8;
+                        case e_tds_data_type::DATETIMEOFFSETNTYPE:
+                            return 10;
+                        default:
+                            return column.typeprops.u8l.length;
+                    }
+                case sizeof(tdsl::uint16_t):
+                    return column.typeprops.u16l.length;
+                default:
+                    return column.typeprops.u32l.length;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Release dynamically allocated resources, if any.
+         */
+        void maybe_release_resources() noexcept {
+            if (steps) {
+                step_allocator_t::destroy_n(steps.data(), static_cast<tdsl::uint32_t>(steps.size()));
+                steps = {};
+            }
+            if (plp_buffer) {
+                plp_allocator_t::deallocate(plp_buffer, plp_buffer_size);
+                plp_buffer      = {nullptr};
+                plp_buffer_size = {0};
+            }
+            if (spill_buffer) {
+                plp_allocator_t::deallocate(spill_buffer, spill_buffer_size);
+                spill_buffer      = {nullptr};
+                spill_buffer_size = {0};
+            }
+            fixed_row_size = {0};
+            is_fixed_width = {false};
+            has_plp        = {false};
+        }
+    };
+
+}} // namespace tdsl::detail
+
+#endif
@@ -14,10 +14,12 @@
 #define TDSL_DETAIL_TDSL_SQL_PARAMETER_HPP
 
 #include <tdslite/detail/tdsl_data_type.hpp>
+#include <tdslite/detail/tdsl_bulk_load.hpp>
 #include <tdslite/util/tdsl_span.hpp>
 #include <tdslite/util/tdsl_byte_swap.hpp>
 #include <tdslite/util/tdsl_string_view.hpp>
 #include <tdslite/util/tdsl_type_traits.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
 
 namespace tdsl { namespace detail {
 
@@ -43,6 +45,7 @@ namespace tdsl { namespace detail {
      * GUIDTYPE        - UNIQUEIDENTIFIER
      * BIGBINARYTYPE   - BINARY(N)
      * BIGVARBINTYPE   - VARBINARY(N)
+     * TVPTYPE         - Table type (see sql_parameter_tvp)
      * ------------------------------
      * NOTE: TEXTTYPE(TEXT), NTEXTTYPE(NTEXT) and IMAGETYPE(IMAGE)
      * are deprecated in favor of VARCHAR(MAX), NVARCHAR(MAX)
@@ -353,6 +356,71 @@ namespace tdsl { namespace detail {
     // TDSL_DATA_TYPE_DECL(NUMERICTYPE   , 0x3F) TDSL_DATA_TYPE_LIST_DELIM
     // TDSL_DATA_TYPE_DECL(NUMERICNTYPE  , 0x6C) TDSL_DATA_TYPE_LIST_DELIM
 
+    /**
+     * Table-valued parameter (TVP)
+     *
+     * The rows are not stored in the parameter. They are streamed into
+     * the RPC request as they are produced by the row producer, so a
+     * stored procedure can receive any amount of rows in a single call.
+     *
+     * The columns are described in the same way as a bulk load (see
+     * sql_bulk_column), and must match the columns of the table type
+     * in order. The column names are not sent.
+     *
+     * The parameter is declared as `@pN <type_name> READONLY`. The TVP
+     * object must outlive the execution, as the binding refers to it.
+     * TVPs require TDS 7.3 (SQL Server 2008) or newer.
+     */
+    struct sql_parameter_tvp {
+
+        /**
+         * Construct a TVP
+         *
+         * @param [in] type_name Name of the table type, e.g. `dbo.id_list`
+         * @param [in] columns Columns of the table type
+         * @param [in] producer Row producer function
+         * @param [in] producer_uptr Row producer user pointer (optional)
+         */
+        inline sql_parameter_tvp(tdsl::string_view type_name,
+                                 tdsl::span<sql_bulk_column> columns,
+                                 bulk_row_producer_fn_t producer,
+                                 void * producer_uptr = nullptr) noexcept :
+            type_name(type_name), columns(columns), producer(producer),
+            producer_uptr(producer_uptr) {}
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Cast operator to sql_paramater_binding
+         */
+        inline TDSL_NODISCARD operator sql_parameter_binding() const noexcept {
+            sql_parameter_binding param = {};
+            param.type                  = e_tds_data_type::TVPTYPE;
+            param.value = tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>(this),
+                                          sizeof(sql_parameter_tvp)};
+            return param;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Get the TVP that parameter binding @p pb refers to
+         */
+        static inline TDSL_NODISCARD const sql_parameter_tvp &
+        from_binding(const sql_parameter_binding & pb) noexcept {
+            TDSL_ASSERT(pb.type == e_tds_data_type::TVPTYPE &&
+                        pb.value.size_bytes() == sizeof(sql_parameter_tvp));
+            return *reinterpret_cast<const sql_parameter_tvp *>(pb.value.data());
+        }
+
+        tdsl::string_view type_name;
+        tdsl::span<sql_bulk_column> columns;
+        bulk_row_producer_fn_t producer;
+        void * producer_uptr;
+    };
+
+    // --------------------------------------------------------------------------------
+
     using sql_parameter_bit       = sql_parameter<e_tds_data_type::BITTYPE>;
     using sql_parameter_tinyint   = sql_parameter<e_tds_data_type::INT1TYPE>;
     using sql_parameter_smallint  = sql_parameter<e_tds_data_type::INT2TYPE>;
@@ -0,0 +1,350 @@
+/**
+ * ____________________________________________________
+ * Compile-time typed RPC statements
+ *
+ * @file   tdsl_statement.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#ifndef TDSL_DETAIL_TDSL_STATEMENT_HPP
+#define TDSL_DETAIL_TDSL_STATEMENT_HPP
+
+#include <tdslite/detail/tdsl_data_type.hpp>
+#include <tdslite/util/tdsl_span.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+#include <tdslite/util/tdsl_type_traits.hpp>
+#include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
+
+#include <string.h> // needed for memcpy
+
+namespace tdsl { namespace detail {
+
+    /**
+     * Compile-time byte sequence
+     *
+     * @tparam Bs The bytes
+     */
+    template <tdsl::uint8_t... Bs>
+    struct byte_seq {
+        static constexpr tdsl::uint32_t size = sizeof...(Bs);
+        // (+1 to avoid zero-sized arrays)
+        static constexpr tdsl::uint8_t data [sizeof...(Bs) + 1] = {Bs..., 0};
+
+        static inline TDSL_NODISCARD tdsl::byte_view view() noexcept {
+            return tdsl::byte_view{data, size};
+        }
+    };
+
+    template <tdsl::uint8_t... Bs>
+    constexpr tdsl::uint8_t byte_seq<Bs...>::data [];
+
+    // --------------------------------------------------------------------------------
+
+    template <typename... Seqs>
+    struct byte_seq_concat;
+
+    template <>
+    struct byte_seq_concat<> {
+        using type = byte_seq<>;
+    };
+
+    template <tdsl::uint8_t... Bs>
+    struct byte_seq_concat<byte_seq<Bs...>> {
+        using type = byte_seq<Bs...>;
+    };
+
+    template <tdsl::uint8_t... As, tdsl::uint8_t... Bs, typename... Rest>
+    struct byte_seq_concat<byte_seq<As...>, byte_seq<Bs...>, Rest...>
+        : byte_seq_concat<byte_seq<As..., Bs...>, Rest...> {};
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * UTF-16LE encoding of the ASCII string @p Cs, as a byte sequence
+     */
+    template <char... Cs>
+    using u16_seq =
+        typename byte_seq_concat<byte_seq<static_cast<tdsl::uint8_t>(Cs), 0>...>::type;
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Decimal representation of @p N as UTF-16LE byte sequence
+     */
+    template <tdsl::uint32_t N, char... Digits>
+    struct u16_decimal_seq : u16_decimal_seq<N / 10, static_cast<char>('0' + N % 10), Digits...> {
+    };
+
+    template <char... Digits>
+    struct u16_decimal_seq<0, Digits...> {
+        using type = u16_seq<Digits...>;
+    };
+
+    template <>
+    struct u16_decimal_seq<0> {
+        using type = u16_seq<'0'>;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * The SQL declaration & the RPC parameter encoding of the
+     * statement parameter type T. Supported types are:
+     * ------------------------------
+     * C++ TYPE          SQL TYPE
+     * ------------------------------
+     * bool            - BIT
+     * tdsl::uint8_t   - TINYINT
+     * tdsl::int16_t   - SMALLINT
+     * tdsl::int32_t   - INT
+     * tdsl::int64_t   - BIGINT
+     * float           - REAL
+     * string_view     - VARCHAR(8000)
+     * wstring_view    - NVARCHAR(4000)
+     * byte_view       - VARBINARY(8000)
+     * ------------------------------
+     * The string & binary types are declared with their maximum length,
+     * so the declaration does not depend on the value.
+     *
+     * Each specialization provides:
+     *  - decl: SQL type declaration (UTF-16LE)
+     *  - type_info: Parameter name length, status flags and TYPE_INFO
+     *  - is_valid(v): Whether the value fits to the declared type
+     *  - write_value(ctx, v): Write the (length prefixed) value
+     */
+    template <typename T>
+    struct statement_param;
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Fixed size value, sent as a nullable (e.g. INTNTYPE) type
+     */
+    template <typename T, e_tds_data_type Type, typename Decl>
+    struct fixed_statement_param {
+        using decl      = Decl;
+        // name length, status flags, type, max length, length
+        using type_info = byte_seq<0x00, 0x00, static_cast<tdsl::uint8_t>(Type), sizeof(T),
+                                   sizeof(T)>;
+
+        static constexpr inline bool is_valid(T) noexcept {
+            return true;
+        }
+
+        template <typename Ctx>
+        static inline void write_value(Ctx & ctx, T v) noexcept {
+            ctx.write_le(v);
+        }
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Variable size value with 16-bit length
+     */
+    template <typename T, e_tds_data_type Type, tdsl::uint16_t MaxBytes, bool HasCollation,
+              typename Decl>
+    struct varu16_statement_param {
+        using decl      = Decl;
+        // name length, status flags, type, max length, collation
+        using type_info = typename byte_seq_concat<
+            byte_seq<0x00, 0x00, static_cast<tdsl::uint8_t>(Type),
+                     static_cast<tdsl::uint8_t>(MaxBytes & 0xFF),
+                     static_cast<tdsl::uint8_t>(MaxBytes >> 8)>,
+            typename traits::conditional<HasCollation, byte_seq<0x00, 0x00, 0x00, 0x00, 0x00>,
+                                         byte_seq<>>::type>::type;
+
+        static inline bool is_valid(const T & v) noexcept {
+            return v.size_bytes() <= MaxBytes;
+        }
+
+        template <typename Ctx>
+        static inline void write_value(Ctx & ctx, const T & v) noexcept {
+            ctx.write_le(static_cast<tdsl::uint16_t>(v.size_bytes()));
+            if (v.size_bytes()) {
+                ctx.write(v.template rebind_cast<const tdsl::uint8_t>());
+            }
+        }
+    };
+
+    // --------------------------------------------------------------------------------
+
+    template <>
+    struct statement_param<bool>
+        : fixed_statement_param<bool, e_tds_data_type::BITNTYPE, u16_seq<'B', 'I', 'T'>> {
+        template <typename Ctx>
+        static inline void write_value(Ctx & ctx, bool v) noexcept {
+            ctx.write(v ? tdsl::uint8_t{1} : tdsl::uint8_t{0});
+        }
+    };
+
+    template <>
+    struct statement_param<tdsl::uint8_t>
+        : fixed_statement_param<tdsl::uint8_t, e_tds_data_type::INTNTYPE,
+                                u16_seq<'T', 'I', 'N', 'Y', 'I', 'N', 'T'>> {};
+
+    template <>
+    struct statement_param<tdsl::int16_t>
+        : fixed_statement_param<tdsl::int16_t, e_tds_data_type::INTNTYPE,
+                                u16_seq<'S', 'M', 'A', 'L', 'L', 'I', 'N', 'T'>> {};
+
+    template <>
+    struct statement_param<tdsl::int32_t>
+        : fixed_statement_param<tdsl::int32_t, e_tds_data_type::INTNTYPE,
+                                u16_seq<'I', 'N', 'T'>> {};
+
+    template <>
+    struct statement_param<tdsl::int64_t>
+        : fixed_statement_param<tdsl::int64_t, e_tds_data_type::INTNTYPE,
+                                u16_seq<'B', 'I', 'G', 'I', 'N', 'T'>> {};
+
+    template <>
+    struct statement_param<float>
+        : fixed_statement_param<float, e_tds_data_type::FLTNTYPE, u16_seq<'R', 'E', 'A', 'L'>> {
+        static_assert(sizeof(float) == 4,
+                      "The implementation assumes that float is 4 bytes in size!");
+
+        template <typename Ctx>
+        static inline void write_value(Ctx & ctx, float v) noexcept {
+            tdsl::uint32_t bits = {0};
+            memcpy(&bits, &v, sizeof(bits));
+            ctx.write_le(bits);
+        }
+    };
+
+    template <>
+    struct statement_param<tdsl::string_view>
+        : varu16_statement_param<
+              tdsl::string_view, e_tds_data_type::BIGVARCHRTYPE, 8000, true,
+              u16_seq<'V', 'A', 'R', 'C', 'H', 'A', 'R', '(', '8', '0', '0', '0', ')'>> {};
+
+    template <>
+    struct statement_param<tdsl::wstring_view>
+        : varu16_statement_param<
+              tdsl::wstring_view, e_tds_data_type::NVARCHARTYPE, 8000, true,
+              u16_seq<'N', 'V', 'A', 'R', 'C', 'H', 'A', 'R', '(', '4', '0', '0', '0', ')'>> {};
+
+    template <>
+    struct statement_param<tdsl::byte_view>
+        : varu16_statement_param<
+              tdsl::byte_view, e_tds_data_type::BIGVARBINTYPE, 8000, false,
+              u16_seq<'V', 'A', 'R', 'B', 'I', 'N', 'A', 'R', 'Y', '(', '8', '0', '0', '0', ')'>> {
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Parameter declarations of a statement, e.g. `@p0 INT,@p1 NVARCHAR(4000)`
+     *
+     * @tparam I Index of the first parameter
+     * @tparam Params Parameter types
+     */
+    template <tdsl::uint32_t I, typename... Params>
+    struct statement_decl {
+        using type = byte_seq<>;
+    };
+
+    template <tdsl::uint32_t I, typename P, typename... Rest>
+    struct statement_decl<I, P, Rest...> {
+        using type = typename byte_seq_concat<
+            typename traits::conditional<I == 0, byte_seq<>, u16_seq<','>>::type,
+            u16_seq<'@', 'p'>, typename u16_decimal_seq<I>::type, u16_seq<' '>,
+            typename statement_param<P>::decl,
+            typename statement_decl<I + 1, Rest...>::type>::type;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Parameter values of a statement
+     */
+    template <typename... Params>
+    struct statement_values {
+        inline bool is_valid() const noexcept {
+            return true;
+        }
+
+        template <typename Ctx>
+        inline void write(Ctx &) const noexcept {}
+    };
+
+    template <typename P, typename... Rest>
+    struct statement_values<P, Rest...> {
+        inline statement_values(const P & v, const Rest &... rest_values) noexcept :
+            value(v), rest(rest_values...) {}
+
+        inline bool is_valid() const noexcept {
+            return statement_param<P>::is_valid(value) && rest.is_valid();
+        }
+
+        template <typename Ctx>
+        inline void write(Ctx & ctx) const noexcept {
+            ctx.write(statement_param<P>::type_info::view());
+            statement_param<P>::write_value(ctx, value);
+            rest.write(ctx);
+        }
+
+        P value;
+        statement_values<Rest...> rest;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * A parameterized statement whose parameter types are known at
+     * compile time, e.g. statement<tdsl::int32_t, tdsl::wstring_view>.
+     *
+     * The parameter declaration string (`@p0 INT,@p1 NVARCHAR(4000)`) and
+     * the TYPE_INFO of each parameter are generated at compile time, so
+     * executing the statement only copies the values into the request.
+     *
+     * The parameters are named @p0, @p1, ... in declaration order. The
+     * string & binary values are referenced, not copied; they must outlive
+     * the execution.
+     *
+     * @tparam Params Parameter types (see statement_param)
+     */
+    template <typename... Params>
+    struct statement {
+        using declaration_type = typename statement_decl<0, Params...>::type;
+
+        static_assert(declaration_type::size <= 8000,
+                      "The parameter declarations do not fit into NVARCHAR(4000)!");
+
+        /**
+         * Construct a statement with parameter @p values
+         */
+        inline statement(const Params &... args) noexcept : values(args...) {}
+
+        /**
+         * Parameter declarations (UTF-16LE)
+         */
+        static inline TDSL_NODISCARD tdsl::byte_view declaration() noexcept {
+            return declaration_type::view();
+        }
+
+        /**
+         * Whether all values fit to their declared types
+         */
+        inline TDSL_NODISCARD bool is_valid() const noexcept {
+            return values.is_valid();
+        }
+
+        /**
+         * Write the parameter values (with their TYPE_INFO) to @p ctx
+         */
+        template <typename Ctx>
+        inline void write_values(Ctx & ctx) const noexcept {
+            values.write(ctx);
+        }
+
+        statement_values<Params...> values;
+    };
+}} // namespace tdsl::detail
+
+#endif
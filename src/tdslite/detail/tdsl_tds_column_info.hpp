@@ -17,11 +17,11 @@
 
 namespace tdsl {
 
-    // Packed into 12-byte layout to make
+    // Packed into 16-byte layout to make
     // most of the space useful.
     struct tds_column_info {
-        /* User-defined type value */
-        tdsl::uint16_t user_type              = {0};
+        /* User-defined type value (16 bits before TDS 7.2) */
+        tdsl::uint32_t user_type              = {0};
         tdsl::uint16_t flags                  = {0};
         /* Data type of the column */
         detail::e_tds_data_type type          = {static_cast<detail::e_tds_data_type>(0)};
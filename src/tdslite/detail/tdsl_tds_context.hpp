@@ -36,6 +36,9 @@
 #include <tdslite/detail/tdsl_net_rx_mixin.hpp>
 #include <tdslite/detail/tdsl_net_tx_mixin.hpp>
 #include <tdslite/detail/tdsl_tds_header.hpp>
+#include <tdslite/detail/tdsl_version.hpp>
+#include <tdslite/detail/tdsl_prelogin.hpp>
+#include <tdslite/detail/tdsl_prepared_statement_cache.hpp>
 #include <tdslite/detail/token/tds_envchange_token.hpp>
 #include <tdslite/detail/token/tds_info_token.hpp>
 #include <tdslite/detail/token/tds_loginack_token.hpp>
@@ -80,6 +83,8 @@ namespace tdsl { namespace detail {
         using subtoken_handler_callback_type = callback<void, sub_token_handler_fn_t>;
         using tx_mixin                       = detail::net_tx_mixin<tds_context_type>;
         using rx_mixin                       = detail::net_rx_mixin<tds_context_type>;
+        using statement_cache_type =
+            prepared_statement_cache<TDSL_PREPARED_STATEMENT_CACHE_CAPACITY>;
 
         // --------------------------------------------------------------------------------
 
@@ -101,10 +106,35 @@ namespace tdsl { namespace detail {
             // Indicates that the tds_context is authenticated against
             // the connected server.
             bool authenticated : 1;
-            bool reserved : 7;
+            // An ATTENTION is sent, but its acknowledgement
+            // is not received yet.
+            bool attention_pending : 1;
+            // A PRELOGIN message is sent, but its response
+            // is not received yet.
+            bool prelogin_pending : 1;
+            // A token is partially consumed by the sub token handler,
+            // and the next data is the rest of the `continued_token`.
+            bool token_continues : 1;
+            bool reserved : 4;
         } flags = {};
 
+        // The token that is partially consumed (see flags.token_continues)
+        e_tds_message_token_type continued_token = {};
+
+        // The TDS version in use. This is the version requested in the
+        // LOGIN7 message until the server's LOGINACK tells otherwise.
+        e_tds_version tds_version = {e_tds_version::sql_server_2000_sp1};
+
+        // Descriptor of the active transaction, 0 if there is none (TDS 7.2+)
+        tdsl::uint64_t transaction_descriptor = {0};
+
+        // The response to the last PRELOGIN message
+        prelogin::response prelogin_response = {};
+
     public:
+        // Handles of the statements prepared in this session
+        statement_cache_type prepared_statements = {};
+
         // --------------------------------------------------------------------------------
 
         /**
@@ -117,6 +147,74 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * The TDS version negotiated with the server
+         */
+        inline TDSL_NODISCARD e_tds_version negotiated_tds_version() const noexcept {
+            return tds_version;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Whether the negotiated TDS version is @p min or a later version
+         */
+        inline TDSL_NODISCARD bool tds_version_at_least(e_tds_version min) const noexcept {
+            return detail::tds_version_at_least(tds_version, min);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Descriptor of the transaction in progress, as announced by the
+         * server (TDS 7.2+). Zero when there is no active transaction.
+         */
+        inline TDSL_NODISCARD tdsl::uint64_t current_transaction_descriptor() const noexcept {
+            return transaction_descriptor;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Cancel the request in progress by sending an ATTENTION message
+         *
+         * The server stops executing the request and acknowledges the
+         * cancellation with a DONE token with the DONE_ATTN status bit.
+         * The response is received until the acknowledgement, so the
+         * connection stays usable afterwards. The rows received before
+         * the acknowledgement are still delivered.
+         *
+         * Can be called from the callbacks invoked while the response
+         * is being received (e.g. the row callback).
+         *
+         * @return true if the ATTENTION is sent, false if a cancellation
+         *         is already in progress or the implementation cannot
+         *         send the ATTENTION message
+         */
+        inline bool cancel() noexcept {
+            return cancel_impl(traits::integral_constant<bool, has_receive_status::value>{});
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Receive the response of the last request
+         *
+         * When the implementation supports receive timeouts and the server does
+         * not send anything for @p timeout_ms milliseconds, the request is
+         * cancelled (see cancel()). If the cancellation is not acknowledged in
+         * another @p timeout_ms, the connection is closed.
+         *
+         * @param [in] timeout_ms Receive timeout (0 = implementation default)
+         */
+        inline void receive_tds_response(tdsl::uint32_t timeout_ms = 0) noexcept {
+            flags.token_continues = {false};
+            receive_tds_response_impl(
+                timeout_ms, traits::integral_constant<bool, has_receive_status::value>{});
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Default constructor for tds_context
          */
@@ -152,6 +250,11 @@ namespace tdsl { namespace detail {
 
             switch (message_type) {
                 case msg_type::tabular_result: {
+                    // The PRELOGIN response has the same message
+                    // type, but it is not a token stream.
+                    if (self->flags.prelogin_pending) {
+                        return self->handle_prelogin_response_msg(nmsg_rdr);
+                    }
                     return self->handle_tabular_result_msg(nmsg_rdr);
                 } break;
                 default: {
@@ -167,6 +270,26 @@ namespace tdsl { namespace detail {
 
         // --------------------------------------------------------------------------------
 
+        /**
+         * Handler for the PRELOGIN response message
+         *
+         * @param [in] msg_rdr Reader to read from
+         * @returns
+         * Amount of needed bytes to read a complete PRELOGIN response, if any.
+         */
+        inline tdsl::uint32_t
+        handle_prelogin_response_msg(tdsl::binary_reader<tdsl::endian::little> & msg_rdr) noexcept {
+            const auto needed_bytes = prelogin::decode(
+                byte_view{msg_rdr.current(), msg_rdr.remaining_bytes()}, prelogin_response);
+            if (0 == needed_bytes) {
+                flags.prelogin_pending = {false};
+                msg_rdr.advance(static_cast<tdsl::ssize_t>(msg_rdr.remaining_bytes()));
+            }
+            return needed_bytes;
+        }
+
+        // --------------------------------------------------------------------------------
+
         /**
          * Handler for TDS tabular result message type.
          *
@@ -186,12 +309,16 @@ namespace tdsl { namespace detail {
 
             constexpr int k_min_token_need_bytes = 3;
             // start parsing tokens
-            while (msg_rdr.has_bytes(/*amount_of_bytes=*/k_min_token_need_bytes)) {
+            while (msg_rdr.has_bytes(flags.token_continues ? 1 : k_min_token_need_bytes)) {
 
                 // Put a checkpoint first
                 // we might need to revert (e.g. fragmented token).
-                auto checkpoint       = msg_rdr.checkpoint();
-                const auto token_type = static_cast<e_token_type>(msg_rdr.read<tdsl::uint8_t>());
+                auto checkpoint = msg_rdr.checkpoint();
+                auto token_type = continued_token;
+                // The rest of a partially consumed token has no token type
+                if (not flags.token_continues) {
+                    token_type = static_cast<e_token_type>(msg_rdr.read<tdsl::uint8_t>());
+                }
 
                 // Yet again, the protocol designers have decided to not to
                 // be consistent with their design. Some of the tokens
@@ -207,6 +334,13 @@ namespace tdsl { namespace detail {
 
                 if (callbacks.sub_token_handler) {
                     const auto sth_r = callbacks.sub_token_handler(token_type, msg_rdr);
+                    if (sth_r.status == token_handler_status::partially_consumed) {
+                        // Let the network layer discard the consumed part
+                        // of the token. The handler will receive the rest.
+                        flags.token_continues = {true};
+                        continued_token       = token_type;
+                        return sth_r.needed_bytes;
+                    }
                     if (not(sth_r.status == token_handler_status::unhandled)) {
                         if (sth_r.needed_bytes) {
                             // Restore message reader back to the checkpoint
@@ -215,16 +349,21 @@ namespace tdsl { namespace detail {
                             checkpoint.restore();
                             return sth_r.needed_bytes;
                         }
+                        flags.token_continues = {false};
                         continue;
                     }
                 }
 
-                auto is_fixed_token_size = [](e_token_type t) -> tdsl::uint32_t {
+                TDSL_ASSERT_MSG(not flags.token_continues,
+                                "The rest of a partially consumed token is unhandled!");
+
+                auto is_fixed_token_size = [this](e_token_type t) -> tdsl::uint32_t {
                     switch (t) {
                         case e_token_type::done:
                         case e_token_type::doneinproc:
                         case e_token_type::doneproc:
-                            return 8;
+                            // The row count is 64-bit since TDS 7.2
+                            return tds_version_at_least(e_tds_version::sql_server_2005) ? 12 : 8;
                         case e_token_type::offset:
                         case e_token_type::returnstatus:
                             return 4;
@@ -260,10 +399,10 @@ namespace tdsl { namespace detail {
                         subhandler_nb = handle_info_token(token_reader);
                     } break;
                     case e_token_type::done:
-                    case e_token_type::doneproc:   // FIXME: Distinguish
-                    case e_token_type::doneinproc: // FIXME: Distinguish
-                    {
-                        subhandler_nb = handle_done_token(token_reader);
+                    case e_token_type::doneproc:
+                    case e_token_type::doneinproc: {
+                        subhandler_nb = handle_done_token(
+                            token_reader, token_type == e_token_type::doneproc);
                     } break;
                     case e_token_type::loginack: {
                         subhandler_nb = handle_loginack_token(token_reader);
@@ -323,7 +462,10 @@ namespace tdsl { namespace detail {
                 case envchange_type::database:
                 case envchange_type::language:
                 case envchange_type::charset:
-                case envchange_type::packet_size: {
+                case envchange_type::packet_size:
+                // Sent in response to a request with RESETCONNECTION bit
+                // set, with empty old and new values.
+                case envchange_type::reset_completion_ack: {
                     // The reader must have at least 1 bytes
                     TDSL_RETIF_LESS_BYTES(rr, 1);
 
@@ -381,6 +523,25 @@ namespace tdsl { namespace detail {
                     callbacks.envinfochg(envchange_info);
                     return 0;
                 } break;
+                // Handle transaction envchange types in OLD = B_VARBYTE, NEW = B_VARBYTE
+                // form (TDS 7.2+). The new value is the descriptor of the transaction that
+                // has begun, and it is empty when the transaction is over.
+                case envchange_type::begin_transaction:
+                case envchange_type::commit_transaction:
+                case envchange_type::rollback_transaction:
+                case envchange_type::defect_transaction:
+                case envchange_type::transaction_ended: {
+                    TDSL_RETIF_LESS_BYTES(rr, 1);
+                    const auto nvlen = rr.read<tdsl::uint8_t>();
+                    TDSL_RETIF_LESS_BYTES(rr, nvlen);
+                    transaction_descriptor =
+                        (nvlen == sizeof(tdsl::uint64_t)) ? rr.read<tdsl::uint64_t>() : 0;
+                    TDSL_DEBUG_PRINTLN("received transaction change -> type [%d] | descriptor "
+                                       "[%lu]",
+                                       static_cast<int>(ect),
+                                       static_cast<unsigned long>(transaction_descriptor));
+                    return 0;
+                } break;
                 default: {
                     TDSL_DEBUG_PRINTLN("Unhandled ENVCHANGE type [%d]", static_cast<int>(ect));
                 } break;
@@ -418,7 +579,10 @@ namespace tdsl { namespace detail {
             TDSL_TRY_READ_U8_VARCHAR(server_name, rr);
             TDSL_TRY_READ_U8_VARCHAR(proc_name, rr);
 
-            info_msg.line_number = rr.read<tdsl::uint16_t>();
+            // The line number is 32-bit since TDS 7.2
+            info_msg.line_number = tds_version_at_least(e_tds_version::sql_server_2005)
+                                       ? rr.read<tdsl::uint32_t>()
+                                       : rr.read<tdsl::uint16_t>();
 
             info_msg.msgtext     = msgtext.rebind_cast<char16_t>();
             info_msg.server_name = server_name.rebind_cast<char16_t>();
@@ -482,6 +646,10 @@ namespace tdsl { namespace detail {
             token.prog_version.buildnum_hi = rr.read<tdsl::uint8_t>();
             token.prog_version.buildnum_lo = rr.read<tdsl::uint8_t>();
             token.prog_name                = progname.rebind_cast<char16_t>();
+            // The server may agree on an older version than the requested one
+            tds_version                    = static_cast<e_tds_version>(token.tds_version);
+            // A new session has no prepared statements
+            prepared_statements.clear();
 
             TDSL_DEBUG_PRINT("received login ack token -> interface [%d] | tds version [0x%x] | ",
                              +token.interface, token.tds_version);
@@ -504,32 +672,113 @@ namespace tdsl { namespace detail {
          * callback function, if a callback function is assigned.
          *
          * @param [in] rr Reader to read from
+         * @param [in] proc The token is a DONEPROC token
          *
          * @return tdsl::uint32_t Amount of needed bytes to read a complete DONE token, if any.
          *                        The return value would be non-zero only if the reader has
          *                        partial token data.
          */
-        inline tdsl::uint32_t handle_done_token(tdsl::binary_reader<tdsl::endian::little> & rr) {
+        inline tdsl::uint32_t handle_done_token(tdsl::binary_reader<tdsl::endian::little> & rr,
+                                                bool proc = false) {
             // fe
             // 02 00 e0 00 00 00 00 00
-            static constexpr auto k_min_done_bytes = 8;
-            if (not rr.has_bytes(k_min_done_bytes)) {
-                return k_min_done_bytes - rr.remaining_bytes();
+            // The row count is 64-bit since TDS 7.2
+            const bool wide_row_count = tds_version_at_least(e_tds_version::sql_server_2005);
+
+            const tdsl::uint32_t min_done_bytes = wide_row_count ? 12 : 8;
+            if (not rr.has_bytes(min_done_bytes)) {
+                return min_done_bytes - rr.remaining_bytes();
             }
 
             tds_done_token token = {};
+            token.proc           = proc;
 
             token.status.value   = rr.read<tdsl::uint16_t>();
             token.curcmd         = rr.read<tdsl::uint16_t>();
-            token.done_row_count = rr.read<tdsl::uint32_t>();
+            token.done_row_count =
+                wide_row_count ? rr.read<tdsl::uint64_t>() : rr.read<tdsl::uint32_t>();
 
             TDSL_DEBUG_PRINTLN(
-                "received done token -> status [%d] | cur_cmd [%d] | done_row_count [%d]",
-                token.status.value, token.curcmd, token.done_row_count);
+                "received done token -> status [%d] | cur_cmd [%d] | done_row_count [%lu]",
+                token.status.value, token.curcmd,
+                static_cast<unsigned long>(token.done_row_count));
+            if (token.status.attn()) {
+                // The server acknowledged the ATTENTION
+                flags.attention_pending = {false};
+            }
             callbacks.done(token);
             return 0;
         }
 
+        // --------------------------------------------------------------------------------
+
+        template <typename T>
+        using receive_status_member_fn_t = decltype(traits::declval<T>().receive_status());
+
+        // Whether the network implementation reports the receive status
+        // (i.e. supports receive timeouts & ATTENTION)
+        using has_receive_status =
+            traits::is_detected<receive_status_member_fn_t, tds_context_type>;
+
+        // --------------------------------------------------------------------------------
+
+        inline bool cancel_impl(traits::true_type) noexcept {
+            if (flags.attention_pending || not is_authenticated()) {
+                return false;
+            }
+            this->send_attention();
+            flags.attention_pending = {true};
+            return true;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline bool cancel_impl(traits::false_type) noexcept {
+            return false;
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void receive_tds_response_impl(tdsl::uint32_t timeout_ms,
+                                              traits::true_type) noexcept {
+            using rx_status = typename NetworkImplementation::e_receive_status;
+            this->set_receive_timeout(timeout_ms);
+            for (;;) {
+                this->receive_tds_pdu();
+                switch (this->receive_status()) {
+                    case rx_status::complete:
+                        if (not flags.attention_pending) {
+                            return;
+                        }
+                        // The response is complete, but the acknowledgement of
+                        // the ATTENTION comes in a separate message.
+                        continue;
+                    case rx_status::timed_out:
+                        if (cancel()) {
+                            continue;
+                        }
+                        // The server did not acknowledge the ATTENTION in time
+                        // either. Give up on the connection.
+                        TDSL_DEBUG_PRINTLN("tds_context::receive_tds_response(...) -> attention "
+                                           "is not acknowledged, disconnecting");
+                        this->do_disconnect();
+                        flags.authenticated = {false};
+                        break;
+                    case rx_status::failed:
+                        break;
+                }
+                flags.attention_pending = {false};
+                this->abandon_receive();
+                return;
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        inline void receive_tds_response_impl(tdsl::uint32_t, traits::false_type) noexcept {
+            this->receive_tds_pdu();
+        }
+
         friend struct detail::net_rx_mixin<tds_context<NetworkImplementation>>;
         friend struct detail::net_tx_mixin<tds_context<NetworkImplementation>>;
         friend struct tdsl::detail::tdsl_driver<NetworkImplementation>;
@@ -48,7 +48,14 @@ namespace tdsl { namespace detail {
 
     enum class e_rpc_error_code : tdsl::uint8_t
     {
-        invalid_mode = 1,
+        invalid_mode               = 1,
+        // A parameter value does not fit to its declared type
+        invalid_parameter_length   = 2,
+        // The RPC batch has no room for another call
+        batch_full                 = 3,
+        // A parameter type is not supported (e.g. a TVP before TDS 7.3, or a
+        // TVP column type that is not supported)
+        unsupported_parameter_type = 4,
     };
 }} // namespace tdsl::detail
 
@@ -24,7 +24,11 @@ namespace tdsl {
         not_enough_memory         = -3,
         unknown_column_size_type  = -4,
         missing_prior_colmetadata = -5,
-        invalid_field_length      = -6
+        invalid_field_length      = -6,
+        // The token is consumed partially. The rest of the token
+        // (without the token type) is to be handed to the same
+        // handler when more data arrives.
+        partially_consumed        = 1
     };
 
     // --------------------------------------------------------------------------------
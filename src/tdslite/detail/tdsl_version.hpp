@@ -13,6 +13,7 @@
 #define TDSL_DETAIL_TDS_VERSION_HPP
 
 #include <tdslite/util/tdsl_inttypes.hpp>
+#include <tdslite/util/tdsl_macrodef.hpp>
 
 namespace tdsl { namespace detail {
     enum class e_tds_version : tdsl::uint32_t
@@ -29,6 +30,22 @@ namespace tdsl { namespace detail {
         sql_server_2017     = sql_server_2012,
         sql_server_2019     = sql_server_2012,
     };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Check whether TDS version @p v is @p min or a later version
+     *
+     * Versions are compared by their major/minor byte (e.g. 0x72 for 7.2),
+     * revisions of the same version (e.g. 7.3A and 7.3B) compare equal.
+     *
+     * @param [in] v Version to check
+     * @param [in] min Minimum version
+     */
+    TDSL_NODISCARD inline constexpr bool tds_version_at_least(e_tds_version v,
+                                                              e_tds_version min) noexcept {
+        return (static_cast<tdsl::uint32_t>(v) & 0xFF) >= (static_cast<tdsl::uint32_t>(min) & 0xFF);
+    }
 }} // namespace tdsl::detail
 
 #endif
\ No newline at end of file
@@ -90,8 +90,11 @@ namespace tdsl {
         // application layer, which utilizes TDS. The TDS layer does not evaluate the value.
         tdsl::uint16_t curcmd         = {0};
         // The count of rows that were affected by the SQL statement. The value of DoneRowCount is
-        // valid if the value of Status includes DONE_COUNT.
-        tdsl::uint32_t done_row_count = {0};
+        // valid if the value of Status includes DONE_COUNT. (32-bit on the wire before TDS 7.2)
+        tdsl::uint64_t done_row_count = {0};
+        // The token is a DONEPROC, which marks the end of a stored
+        // procedure (RPC) call, rather than a DONE or DONEINPROC
+        bool proc                     = {false};
     };
 } // namespace tdsl
 
@@ -20,7 +20,7 @@ namespace tdsl {
         tdsl::uint32_t number                  = {0};
         tdsl::uint8_t state                    = {0};
         tdsl::uint8_t class_                   = {0};
-        tdsl::uint16_t line_number             = {0};
+        tdsl::uint32_t line_number             = {0};
         tdsl::span<const char16_t> msgtext     = {};
         tdsl::span<const char16_t> server_name = {};
         tdsl::span<const char16_t> proc_name   = {};
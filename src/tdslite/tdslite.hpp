@@ -44,9 +44,15 @@ namespace tdsl {
     using detail::sql_parameter_varchar;
 
     using detail::sql_parameter_binding;
+    using detail::sql_parameter_tvp;
 
-    using rpc_mode    = detail::e_rpc_mode;
-    using stored_proc = detail::e_proc_id;
+    using detail::statement;
+
+    using detail::sql_bulk_column;
+
+    using rpc_mode        = detail::e_rpc_mode;
+    using stored_proc     = detail::e_proc_id;
+    using bulk_load_error = detail::e_bulk_load_error_code;
 
 } // namespace tdsl
 
@@ -32,6 +32,14 @@ namespace tdsl {
      * The underlying buffer can be read through progressive_binary_reader
      * obtained via .get_reader() function call and can be modified through
      * progressive_binary_writer obtained via .get_writer().
+     *
+     * Committing a read does not move any data. Instead, the buffer keeps
+     * a head index that marks the start of the unconsumed region, and the
+     * readers always see [head, write offset) as a single contiguous view.
+     * The consumed prefix is reclaimed either for free when the readers
+     * drain the buffer completely (both indices go back to zero), or by a
+     * single compaction when a writer asks for more free space than the
+     * tail of the buffer can provide.
      */
     struct tdsl_buffer_object : private tdsl::binary_writer<tdsl::endian::little> {
         using binary_writer_type = tdsl::binary_writer<tdsl::endian::little>;
@@ -44,24 +52,24 @@ namespace tdsl {
          */
         struct progressive_binary_reader {
 
-            inline progressive_binary_reader(binary_writer_type & w, bool & mef) :
-                writer{w}, reader{w.data(), w.offset()}, in_use_flag(mef) {
+            inline progressive_binary_reader(tdsl_buffer_object & bo) :
+                owner{bo}, reader{bo.data() + bo.head, bo.offset() - bo.head} {
 
-                if (in_use_flag) {
+                if (owner.in_use) {
                     TDSL_ASSERT_MSG(false, "Buffer object is already in use!");
                     TDSL_TRAP;
                 }
-                in_use_flag = {true};
+                owner.in_use = {true};
             }
 
             inline ~progressive_binary_reader() noexcept {
-                writer.shift_left(reader.offset());
-                in_use_flag = {false};
+                owner.commit(reader.offset());
+                owner.in_use = {false};
                 TDSL_DEBUG_PRINTLN("netbuf: [consumed `" TDSL_SIZET_FORMAT_SPECIFIER
                                    "`, inuse `" TDSL_SIZET_FORMAT_SPECIFIER
                                    "`, free `" TDSL_SIZET_FORMAT_SPECIFIER "`]",
                                    reader.offset(), reader.remaining_bytes(),
-                                   writer.remaining_bytes());
+                                   owner.free_space());
             }
 
             inline TDSL_NODISCARD binary_reader_type * operator->() noexcept {
@@ -73,36 +81,38 @@ namespace tdsl {
             }
 
         private:
-            binary_writer_type & writer;
+            tdsl_buffer_object & owner;
             binary_reader_type reader{};
-            bool & in_use_flag;
         };
 
         /**
-         *
-         *
+         * Exclusive writer access to the buffer object. Writes are appended
+         * after the unconsumed region.
          */
         struct progressive_binary_writer {
-            inline progressive_binary_writer(binary_writer_type & w, bool & iuf) :
-                writer(w), in_use_flag(iuf) {
-                if (in_use_flag) {
+            inline progressive_binary_writer(tdsl_buffer_object & bo) : owner(bo) {
+                if (owner.in_use) {
                     TDSL_ASSERT_MSG(false, "Buffer object is already in use!");
                     TDSL_TRAP;
                 }
-                in_use_flag = {true};
+                owner.in_use = {true};
             }
 
             inline ~progressive_binary_writer() noexcept {
-                in_use_flag = {false};
+                // The writer might have been reset or rewound below the
+                // unconsumed region; clamp the head so it stays valid.
+                if (owner.head > owner.offset()) {
+                    owner.head = owner.offset();
+                }
+                owner.in_use = {false};
             }
 
             inline TDSL_NODISCARD binary_writer_type * operator->() noexcept {
-                return &writer;
+                return &owner;
             }
 
         private:
-            binary_writer_type & writer;
-            bool & in_use_flag;
+            tdsl_buffer_object & owner;
         };
 
         /**
@@ -111,16 +121,30 @@ namespace tdsl {
          * @return progressive_binary_reader
          */
         inline TDSL_NODISCARD auto get_reader() noexcept -> progressive_binary_reader {
-            return progressive_binary_reader{*this, in_use};
+            return progressive_binary_reader{*this};
         }
 
         /**
          * Get the writer object
          *
+         * The consumed region at the front of the buffer is reclaimed (i.e. the
+         * unconsumed bytes are moved to the beginning of the buffer) only when
+         * the free space at the tail is less than @p min_free_space. By default,
+         * the buffer is always compacted, so writer's remaining_bytes() reports
+         * all of the free space.
+         *
+         * @param [in] min_free_space Amount of contiguous free space the caller needs
+         *
          * @return progressive_binary_writer
          */
-        inline TDSL_NODISCARD auto get_writer() noexcept -> progressive_binary_writer {
-            return progressive_binary_writer{*this, in_use};
+        inline TDSL_NODISCARD auto
+        get_writer(tdsl::size_t min_free_space =
+                       tdsl::numeric_limits::max_value<tdsl::size_t>()) noexcept
+            -> progressive_binary_writer {
+            if (head && binary_writer_type::remaining_bytes() < min_free_space) {
+                compact();
+            }
+            return progressive_binary_writer{*this};
         }
 
         /**
@@ -132,8 +156,47 @@ namespace tdsl {
             return binary_writer_type::underlying_view();
         }
 
+        /**
+         * Total amount of free space, including the consumed
+         * region that is not yet reclaimed.
+         */
+        inline TDSL_NODISCARD auto free_space() const noexcept -> tdsl::size_t {
+            return binary_writer_type::remaining_bytes() + head;
+        }
+
+        /**
+         * Amount of unconsumed bytes in the buffer
+         */
+        inline TDSL_NODISCARD auto unconsumed_bytes() const noexcept -> tdsl::size_t {
+            return binary_writer_type::offset() - head;
+        }
+
     private:
-        bool in_use = {false};
+        /**
+         * Mark @p amount bytes as consumed.
+         *
+         * When everything is consumed, both indices are reset to
+         * the beginning of the buffer without moving any data.
+         */
+        inline void commit(tdsl::size_t amount) noexcept {
+            TDSL_ASSERT(amount <= unconsumed_bytes());
+            head += amount;
+            if (head == binary_writer_type::offset()) {
+                head = {0};
+                binary_writer_type::reset();
+            }
+        }
+
+        /**
+         * Move the unconsumed bytes to the beginning of the buffer
+         */
+        inline void compact() noexcept {
+            binary_writer_type::shift_left(static_cast<tdsl::uint32_t>(head));
+            head = {0};
+        }
+
+        bool in_use       = {false};
+        tdsl::size_t head = {0};
     };
 
 } // namespace tdsl
@@ -0,0 +1,114 @@
+/**
+ * _________________________________________________
+ * Loopback stand-in SQL server for the benchmarks
+ *
+ * @file   bm_loopback_server.hpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#ifndef TDSL_TESTS_BM_LOOPBACK_SERVER_HPP
+#define TDSL_TESTS_BM_LOOPBACK_SERVER_HPP
+
+#include <tdslite/detail/tdsl_message_type.hpp>
+#include <tdslite/util/tdsl_binary_reader.hpp>
+#include <tdslite/util/tdsl_inttypes.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+namespace tdsl { namespace bm {
+
+    /**
+     * Loopback stand-in for a SQL server. Answers every
+     * one-byte request with a pre-built TDS response message.
+     */
+    struct loopback_server {
+
+        loopback_server(std::vector<tdsl::uint8_t> response_message) :
+            response(std::move(response_message)) {
+            listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = 0;
+            socklen_t addr_len   = sizeof(addr);
+            ::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(listen_fd, 1);
+            ::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+            port   = ntohs(addr.sin_port);
+            worker = std::thread{[this] {
+                serve();
+            }};
+        }
+
+        ~loopback_server() {
+            worker.join();
+            ::close(listen_fd);
+        }
+
+        tdsl::uint16_t port = {0};
+
+    private:
+        void serve() {
+            const int fd = ::accept(listen_fd, nullptr, nullptr);
+            int one      = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            char request = {0};
+            while (::recv(fd, &request, 1, 0) == 1) {
+                for (tdsl::size_t sent = 0; sent < response.size();) {
+                    const auto r = ::send(fd, response.data() + sent, response.size() - sent, 0);
+                    if (r <= 0) {
+                        break;
+                    }
+                    sent += static_cast<tdsl::size_t>(r);
+                }
+            }
+            ::close(fd);
+        }
+
+        std::vector<tdsl::uint8_t> response;
+        int listen_fd = {-1};
+        std::thread worker;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Make a tabular result message that consists of
+     * @p packet_count packets of @p packet_size bytes
+     */
+    inline std::vector<tdsl::uint8_t> make_response(tdsl::uint16_t packet_size,
+                                                    tdsl::uint16_t packet_count) {
+        std::vector<tdsl::uint8_t> message;
+        for (tdsl::uint16_t i = 0; i < packet_count; i++) {
+            const bool eom = (i + 1) == packet_count;
+            message.insert(message.end(), {0x04, static_cast<tdsl::uint8_t>(eom),
+                                           static_cast<tdsl::uint8_t>(packet_size >> 8),
+                                           static_cast<tdsl::uint8_t>(packet_size & 0xFF), 0x00,
+                                           0x00, static_cast<tdsl::uint8_t>(i + 1), 0x00});
+            message.insert(message.end(), packet_size - 8, 0xFD);
+        }
+        return message;
+    }
+
+    // --------------------------------------------------------------------------------
+
+    inline tdsl::uint32_t consume_all(void *, tdsl::detail::e_tds_message_type,
+                                      tdsl::binary_reader<tdsl::endian::little> & rdr) {
+        rdr.advance(static_cast<tdsl::ssize_t>(rdr.remaining_bytes()));
+        return 0;
+    }
+
+}} // namespace tdsl::bm
+
+#endif
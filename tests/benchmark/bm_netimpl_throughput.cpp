@@ -0,0 +1,71 @@
+/**
+ * _________________________________________________
+ * Receive throughput of the network implementations
+ *
+ * Compares tdsl_netimpl_asio, tdsl_netimpl_epoll and
+ * tdsl_netimpl_uring receiving TDS messages of various sizes from a
+ * loopback stand-in server.
+ *
+ * @file   bm_netimpl_throughput.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/asio/tdsl_netimpl_asio.hpp>
+#include <tdslite-net/epoll/tdsl_netimpl_epoll.hpp>
+#include <tdslite-net/uring/tdsl_netimpl_uring.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include "bm_loopback_server.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    template <typename NetImpl>
+    void bm_netimpl_receive(benchmark::State & state) {
+        tdsl::bm::loopback_server server{
+            tdsl::bm::make_response(static_cast<tdsl::uint16_t>(state.range(0)),
+                                    static_cast<tdsl::uint16_t>(state.range(1)))};
+        NetImpl client{};
+        if (not client.do_connect(tdsl::string_view{"127.0.0.1"}, server.port)) {
+            state.SkipWithError("cannot connect to the loopback server");
+            return;
+        }
+        client.register_packet_data_callback(&tdsl::bm::consume_all, nullptr);
+
+        const tdsl::uint8_t request [1] = {0};
+        for (auto _ : state) {
+            client.do_send(tdsl::byte_view{}, tdsl::byte_view{request});
+            benchmark::DoNotOptimize(client.do_receive_tds_pdu());
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+        client.do_disconnect();
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(bm_netimpl_receive, tdsl::net::tdsl_netimpl_asio)
+    ->ArgNames({"packet_size", "packet_count"})
+    ->Args({512, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 16})
+    ->Args({32767, 16});
+
+BENCHMARK_TEMPLATE(bm_netimpl_receive, tdsl::net::tdsl_netimpl_epoll)
+    ->ArgNames({"packet_size", "packet_count"})
+    ->Args({512, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 16})
+    ->Args({32767, 16});
+
+BENCHMARK_TEMPLATE(bm_netimpl_receive, tdsl::net::tdsl_netimpl_uring)
+    ->ArgNames({"packet_size", "packet_count"})
+    ->Args({512, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 16})
+    ->Args({32767, 16});
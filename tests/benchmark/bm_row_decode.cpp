@@ -0,0 +1,160 @@
+/**
+ * _________________________________________________
+ * Benchmarks for the ROW & NBCROW token decoding
+ *
+ * Measures the parse cost of wide, mostly NULL rows
+ * sent as ROW and as NBCROW (null bitmap compressed
+ * row) tokens.
+ *
+ * @file   bm_row_decode.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_command_context.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+    /**
+     * Network implementation that discards everything sent
+     * and never receives anything. The tokens are fed to the
+     * command context's token handler directly.
+     */
+    struct null_netimpl {
+        template <typename T>
+        inline void do_write(tdsl::span<T>) noexcept {}
+
+        template <typename T>
+        inline void do_write(tdsl::size_t, tdsl::span<T>) noexcept {}
+
+        inline tdsl::size_t do_get_write_offset() noexcept {
+            return 0;
+        }
+
+        inline void do_send(void) noexcept {}
+
+        inline void do_send_tds_pdu(tdsl::detail::e_tds_message_type) noexcept {}
+
+        inline void do_receive_tds_pdu() {}
+
+        inline void set_tds_packet_size(tdsl::uint16_t) {}
+
+        using packet_data_cb_t = tdsl::uint32_t (*)(void *, tdsl::detail::e_tds_message_type,
+                                                    tdsl::binary_reader<tdsl::endian::little> &);
+
+        void register_packet_data_callback(packet_data_cb_t, void *) {}
+    };
+
+    using command_ctx_t = tdsl::detail::command_context<null_netimpl>;
+    using e_tok         = tdsl::detail::e_tds_message_token_type;
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * COLMETADATA for @p ncols INT NULL columns
+     */
+    std::vector<tdsl::uint8_t> make_colmetadata(tdsl::uint16_t ncols) {
+        std::vector<tdsl::uint8_t> colmetadata{static_cast<tdsl::uint8_t>(ncols),
+                                               static_cast<tdsl::uint8_t>(ncols >> 8)};
+        for (tdsl::uint16_t i = 0; i < ncols; i++) {
+            // user type, flags (nullable), type (INTNTYPE), length (4), column name (c)
+            const tdsl::uint8_t column [] = {0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x63, 0x00};
+            colmetadata.insert(colmetadata.end(), column, column + sizeof(column));
+        }
+        return colmetadata;
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Row data for @p ncols INT NULL columns, of which only every
+     * @p null_stride th column is not NULL.
+     *
+     * @param [in] nbc true for NBCROW, false for ROW token data
+     */
+    std::vector<tdsl::uint8_t> make_row(tdsl::uint16_t ncols, tdsl::uint16_t null_stride,
+                                        bool nbc) {
+        std::vector<tdsl::uint8_t> row(nbc ? (ncols + 7) / 8 : 0, 0x00);
+        for (tdsl::uint16_t i = 0; i < ncols; i++) {
+            const bool is_null = (i % null_stride) != 0;
+            if (is_null && nbc) {
+                row [i / 8] |= static_cast<tdsl::uint8_t>(1 << (i % 8));
+                continue;
+            }
+            row.push_back(is_null ? 0x00 : 0x04);
+            if (not is_null) {
+                row.insert(row.end(), {static_cast<tdsl::uint8_t>(i), 0x00, 0x00, 0x00});
+            }
+        }
+        return row;
+    }
+
+    // --------------------------------------------------------------------------------
+
+    void count_nulls(void * uptr, const tdsl::tds_colmetadata_token &,
+                     const tdsl::tdsl_row & row) {
+        auto & nulls = *static_cast<tdsl::size_t *>(uptr);
+        for (const auto & field : row) {
+            nulls += field.is_null();
+        }
+    }
+
+    // --------------------------------------------------------------------------------
+
+    template <bool NullBitmap>
+    void bm_decode_row(benchmark::State & state) {
+        const auto ncols       = static_cast<tdsl::uint16_t>(state.range(0));
+        const auto null_stride = static_cast<tdsl::uint16_t>(state.range(1));
+        const auto colmetadata = make_colmetadata(ncols);
+        const auto row         = make_row(ncols, null_stride, NullBitmap);
+
+        null_netimpl netimpl{};
+        command_ctx_t::tds_context_type tds_ctx{netimpl};
+        command_ctx_t command_ctx{tds_ctx};
+        tdsl::size_t nulls = {0};
+
+        command_ctx.execute_query(tdsl::string_view{"SELECT * FROM FOO;"}, &count_nulls, &nulls);
+        {
+            tdsl::binary_reader<tdsl::endian::little> rr{
+                tdsl::byte_view{colmetadata.data(), colmetadata.size()}};
+            if (not(command_ctx_t::token_handler(&command_ctx, e_tok::colmetadata, rr).status ==
+                    tdsl::token_handler_status::success)) {
+                state.SkipWithError("cannot decode COLMETADATA");
+                return;
+            }
+        }
+
+        const auto token_type = NullBitmap ? e_tok::nbcrow : e_tok::row;
+        for (auto _ : state) {
+            tdsl::binary_reader<tdsl::endian::little> rr{tdsl::byte_view{row.data(), row.size()}};
+            benchmark::DoNotOptimize(command_ctx_t::token_handler(&command_ctx, token_type, rr));
+        }
+
+        state.counters ["token_bytes"] = static_cast<double>(row.size());
+        state.counters ["nulls"]       = benchmark::Counter(static_cast<double>(nulls),
+                                                            benchmark::Counter::kAvgIterations);
+        state.SetBytesProcessed(state.iterations() * static_cast<tdsl::int64_t>(row.size()));
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(bm_decode_row, false)
+    ->ArgNames({"columns", "null_stride"})
+    ->Args({64, 1})
+    ->Args({64, 8})
+    ->Args({256, 8})
+    ->Args({256, 64});
+
+BENCHMARK_TEMPLATE(bm_decode_row, true)
+    ->ArgNames({"columns", "null_stride"})
+    ->Args({64, 1})
+    ->Args({64, 8})
+    ->Args({256, 8})
+    ->Args({256, 64});
@@ -0,0 +1,171 @@
+/**
+ * _________________________________________________
+ * Benchmarks for the TDS PDU receive path
+ *
+ * Measures the amount of recv() calls per TDS message
+ * in exact and batched receive modes, against a loopback
+ * stand-in server.
+ *
+ * @file   bm_tds_receive.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/base/network_io_base.hpp>
+
+#include "bm_loopback_server.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+    using tdsl::bm::consume_all;
+    using tdsl::bm::loopback_server;
+    using tdsl::bm::make_response;
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Minimal POSIX socket network implementation that
+     * counts the recv() calls it makes.
+     *
+     * @tparam Batched Whether the implementation provides do_recv_some()
+     */
+    template <bool Batched>
+    struct loopback_netimpl : public tdsl::net::network_io_base<loopback_netimpl<Batched>> {
+        using base_type         = tdsl::net::network_io_base<loopback_netimpl<Batched>>;
+        using network_io_result = typename base_type::network_io_result;
+
+        loopback_netimpl() {
+            this->network_buffer = tdsl::tdsl_buffer_object{buffer};
+        }
+
+        ~loopback_netimpl() {
+            do_disconnect();
+        }
+
+        tdsl::expected<tdsl::traits::true_type, int> do_connect(tdsl::char_view,
+                                                                tdsl::uint16_t port) {
+            fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = htons(port);
+            if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))) {
+                return tdsl::unexpected(-1);
+            }
+            return tdsl::traits::true_type{};
+        }
+
+        tdsl::int32_t do_disconnect() noexcept {
+            if (fd < 0) {
+                return -1;
+            }
+            ::close(fd);
+            fd = -1;
+            return 0;
+        }
+
+        tdsl::int32_t do_send(tdsl::byte_view header, tdsl::byte_view message) noexcept {
+            if (header.size_bytes()) {
+                ::send(fd, header.data(), header.size_bytes(), 0);
+            }
+            ::send(fd, message.data(), message.size_bytes(), 0);
+            return 0;
+        }
+
+        network_io_result do_recv(tdsl::uint32_t transfer_exactly) noexcept {
+            auto writer = this->network_buffer.get_writer(transfer_exactly);
+            auto result = do_recv(transfer_exactly, writer->free_span());
+            if (result) {
+                writer->advance(static_cast<tdsl::ssize_t>(transfer_exactly));
+            }
+            return result;
+        }
+
+        network_io_result do_recv(tdsl::uint32_t transfer_exactly, tdsl::byte_span dst_buf) {
+            for (tdsl::uint32_t received = 0; received < transfer_exactly;) {
+                const auto r = recv_call(dst_buf.data() + received, transfer_exactly - received);
+                if (r <= 0) {
+                    return tdsl::unexpected(-1);
+                }
+                received += static_cast<tdsl::uint32_t>(r);
+            }
+            return transfer_exactly;
+        }
+
+        template <bool B = Batched, typename tdsl::traits::enable_if<B, bool>::type = true>
+        network_io_result do_recv_some(tdsl::byte_span dst_buf) noexcept {
+            const auto r = recv_call(dst_buf.data(), dst_buf.size_bytes());
+            if (r <= 0) {
+                return tdsl::unexpected(-1);
+            }
+            return static_cast<tdsl::size_t>(r);
+        }
+
+        void send_request() noexcept {
+            const char request = {0};
+            ::send(fd, &request, sizeof(request), 0);
+        }
+
+        tdsl::size_t recv_calls = {0};
+
+    private:
+        ssize_t recv_call(tdsl::uint8_t * dst, tdsl::size_t amount) noexcept {
+            recv_calls++;
+            return ::recv(fd, dst, amount, 0);
+        }
+
+        int fd                       = {-1};
+        tdsl::uint8_t buffer [16384] = {};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    template <bool Batched>
+    void bm_receive_tds_pdu(benchmark::State & state) {
+        loopback_server server{make_response(static_cast<tdsl::uint16_t>(state.range(0)),
+                                             static_cast<tdsl::uint16_t>(state.range(1)))};
+        loopback_netimpl<Batched> client{};
+        if (not client.do_connect(tdsl::char_view{}, server.port)) {
+            state.SkipWithError("cannot connect to the loopback server");
+            return;
+        }
+        client.register_packet_data_callback(&consume_all, nullptr);
+
+        for (auto _ : state) {
+            client.send_request();
+            benchmark::DoNotOptimize(client.do_receive_tds_pdu());
+        }
+
+        state.counters ["recv_calls"] = benchmark::Counter(static_cast<double>(client.recv_calls),
+                                                           benchmark::Counter::kAvgIterations);
+        state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+        client.do_disconnect();
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(bm_receive_tds_pdu, false)
+    ->ArgNames({"packet_size", "packet_count"})
+    ->Args({512, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 4})
+    ->Args({4096, 16})
+    ->Args({512, 64});
+
+BENCHMARK_TEMPLATE(bm_receive_tds_pdu, true)
+    ->ArgNames({"packet_size", "packet_count"})
+    ->Args({512, 1})
+    ->Args({4096, 1})
+    ->Args({4096, 4})
+    ->Args({4096, 16})
+    ->Args({512, 64});
@@ -85,6 +85,7 @@ struct tds_command_ctx_it_fixture : public ::testing::Test {
         login_ctx_t login{tds_ctx};
         const auto & params = mssql_2022_creds();
         ASSERT_TRUE(tds_ctx.do_connect(params.server_name, /*port=*/1433));
+        ASSERT_EQ(login.do_prelogin(), login_ctx_t::e_login_status::success);
         ASSERT_EQ(login.do_login(params), login_ctx_t::e_login_status::success);
         ASSERT_TRUE(tds_ctx.is_authenticated());
     }
@@ -575,6 +576,213 @@ TEST_F(tds_command_ctx_it_fixture, test_rpc_inttype) {
 
 // --------------------------------------------------------------------------------
 
+TEST_F(tds_command_ctx_it_fixture, test_rpc_prepexec) {
+    tdsl::detail::sql_parameter_int p0{};
+    tdsl::detail::sql_parameter_binding params [] = {p0};
+
+    auto validator = +[](void * b, uut_t::column_metadata_cref, uut_t::row_cref r) {
+        validator_called(b);
+        ASSERT_EQ(r.size(), 1);
+        EXPECT_EQ(r [0].as<tdsl::sql_int>(), 42);
+    };
+
+    auto r1 = command_ctx.execute_query(tdsl::string_view{"CREATE TABLE #test_rpc(a int)"});
+    ASSERT_TRUE(r1);
+    auto r2 = command_ctx.execute_query(tdsl::string_view{"INSERT INTO #test_rpc VALUES(42)"});
+    ASSERT_TRUE(r2);
+
+    // The first execution prepares the statement, the rest reuse the handle
+    for (int i = 0; i < 3; i++) {
+        p0          = 42;
+        auto result = command_ctx.execute_rpc(
+            tdsl::string_view{"SELECT * FROM #test_rpc WHERE a=@p0"}, params,
+            tdsl::detail::e_rpc_mode::prepexec, validator, &validator_called_times);
+        ASSERT_TRUE(result);
+        ASSERT_TRUE(command_ctx.result());
+        ASSERT_EQ(tds_ctx.prepared_statements.size(), 1);
+    }
+    ASSERT_EQ(validator_called_times, 3);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_command_ctx_it_fixture, test_rpc_statement) {
+    auto validator = +[](void * b, uut_t::column_metadata_cref, uut_t::row_cref r) {
+        validator_called(b);
+        ASSERT_EQ(r.size(), 1);
+        EXPECT_EQ(r [0].as<tdsl::sql_int>(), 42);
+    };
+
+    auto r1 = command_ctx.execute_query(
+        tdsl::string_view{"CREATE TABLE #test_rpc_stmt(a int, b nvarchar(10))"});
+    ASSERT_TRUE(r1);
+    auto r2 = command_ctx.execute_query(
+        tdsl::string_view{"INSERT INTO #test_rpc_stmt VALUES(42, N'foo')"});
+    ASSERT_TRUE(r2);
+
+    tdsl::detail::statement<tdsl::int32_t, tdsl::wstring_view> stmt{42, u"foo"};
+    for (int i = 0; i < 2; i++) {
+        auto result = command_ctx.execute_rpc(
+            tdsl::string_view{"SELECT a FROM #test_rpc_stmt WHERE a=@p0 AND b=@p1"}, stmt,
+            tdsl::detail::e_rpc_mode::prepexec, validator, &validator_called_times);
+        ASSERT_TRUE(result);
+        ASSERT_TRUE(command_ctx.result());
+        ASSERT_EQ(tds_ctx.prepared_statements.size(), 1);
+    }
+    ASSERT_EQ(validator_called_times, 2);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_command_ctx_it_fixture, test_rpc_batch) {
+    auto r1 = command_ctx.execute_query(tdsl::string_view{"CREATE TABLE #test_rpc_batch(a int)"});
+    ASSERT_TRUE(r1);
+
+    tdsl::detail::sql_parameter_int p0{};
+    p0                                            = 1;
+    tdsl::detail::sql_parameter_binding params [] = {p0};
+
+    uut_t::query_result results [3];
+    command_ctx.begin_rpc_batch(results);
+    ASSERT_TRUE(
+        command_ctx.add_rpc(tdsl::string_view{"INSERT INTO #test_rpc_batch VALUES(@p0)"}, params));
+    ASSERT_TRUE(command_ctx.add_rpc(
+        tdsl::string_view{"INSERT INTO #test_rpc_batch VALUES(@p0),(@p0)"}, params));
+    // Fails, but does not prevent the execution of the others
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT * FROM #no_such_table"}));
+
+    auto result = command_ctx.execute_rpc_batch();
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, 3);
+    EXPECT_TRUE(results [0]);
+    EXPECT_EQ(results [0].affected_rows, 1);
+    EXPECT_TRUE(results [1]);
+    EXPECT_EQ(results [1].affected_rows, 2);
+    EXPECT_FALSE(results [2]);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_command_ctx_it_fixture, test_bulk_load) {
+    auto r1 = command_ctx.execute_query(
+        tdsl::string_view{"CREATE TABLE #test_bulk_load(a int, b nvarchar(30) NULL)"});
+    ASSERT_TRUE(r1);
+
+    struct row_source {
+        tdsl::int32_t next  = {0};
+        tdsl::int32_t count = {0};
+        tdsl::int32_t value = {0};
+    } source;
+    source.count                             = 5000;
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {"a", tdsl::detail::e_tds_data_type::INT4TYPE, 0, {}},
+        {"b", tdsl::detail::e_tds_data_type::NVARCHARTYPE, 30, {}}
+    };
+
+    auto producer = +[](void * uptr, tdsl::span<tdsl::detail::sql_bulk_column> cols) -> bool {
+        auto & src = *static_cast<row_source *>(uptr);
+        if (src.next == src.count) {
+            return false;
+        }
+        src.value      = src.next++;
+        cols [0].value = tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>(&src.value),
+                                         sizeof(src.value)};
+        // Every other row is NULL
+        cols [1].value = {};
+        if (src.value % 2 == 0) {
+            cols [1].value = tdsl::wstring_view{u"bulk"}.rebind_cast<const tdsl::uint8_t>();
+        }
+        return true;
+    };
+
+    auto result = command_ctx.execute_bulk_load(tdsl::string_view{"#test_bulk_load"}, columns,
+                                                producer, &source);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, 5000);
+
+    auto validator = +[](void * b, uut_t::column_metadata_cref, uut_t::row_cref r) {
+        validator_called(b);
+        ASSERT_EQ(r.size(), 2);
+        EXPECT_EQ(r [0].as<tdsl::int32_t>(), 5000);
+        EXPECT_EQ(r [1].as<tdsl::int32_t>(), 2500);
+    };
+    command_ctx.execute_query(
+        tdsl::string_view{"SELECT COUNT(*), COUNT(b) FROM #test_bulk_load"}, validator,
+        &validator_called_times);
+    ASSERT_EQ(1, validator_called_times);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_command_ctx_it_fixture, test_bulk_load_no_such_table) {
+    tdsl::detail::sql_bulk_column columns [] = {
+        {"a", tdsl::detail::e_tds_data_type::INT4TYPE, 0, {}}
+    };
+    auto producer = +[](void *, tdsl::span<tdsl::detail::sql_bulk_column>) -> bool {
+        return false;
+    };
+    auto result   = command_ctx.execute_bulk_load(tdsl::string_view{"#no_such_table"}, columns,
+                                                  producer);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_bulk_load_error_code::insert_bulk_failed);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_command_ctx_it_fixture, test_rpc_tvp) {
+    // Table types cannot be temporary
+    ASSERT_TRUE(command_ctx.execute_query(
+        tdsl::string_view{"IF TYPE_ID('dbo.tdsl_it_tvp') IS NULL "
+                          "CREATE TYPE dbo.tdsl_it_tvp AS TABLE(a int, b nvarchar(30) NULL)"}));
+
+    struct row_source {
+        tdsl::int32_t next  = {0};
+        tdsl::int32_t count = {0};
+        tdsl::int32_t value = {0};
+    } source;
+    source.count                             = 3000;
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {{}, tdsl::detail::e_tds_data_type::INT4TYPE,     0,  {}},
+        {{}, tdsl::detail::e_tds_data_type::NVARCHARTYPE, 30, {}}
+    };
+
+    auto producer = +[](void * uptr, tdsl::span<tdsl::detail::sql_bulk_column> cols) -> bool {
+        auto & src = *static_cast<row_source *>(uptr);
+        if (src.next == src.count) {
+            return false;
+        }
+        src.value      = src.next++;
+        cols [0].value = tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>(&src.value),
+                                         sizeof(src.value)};
+        // Every third row is not NULL
+        cols [1].value = {};
+        if (src.value % 3 == 0) {
+            cols [1].value = tdsl::wstring_view{u"tvp"}.rebind_cast<const tdsl::uint8_t>();
+        }
+        return true;
+    };
+
+    tdsl::detail::sql_parameter_tvp tvp{"dbo.tdsl_it_tvp", columns, producer, &source};
+    tdsl::detail::sql_parameter_binding params [] = {tvp};
+
+    auto validator = +[](void * b, uut_t::column_metadata_cref, uut_t::row_cref r) {
+        validator_called(b);
+        ASSERT_EQ(r.size(), 3);
+        EXPECT_EQ(r [0].as<tdsl::int32_t>(), 3000);
+        EXPECT_EQ(r [1].as<tdsl::int32_t>(), 1000);
+        EXPECT_EQ(r [2].as<tdsl::int32_t>(), 2999);
+    };
+    auto result = command_ctx.execute_rpc(
+        tdsl::string_view{"SELECT COUNT(*), COUNT(b), MAX(a) FROM @p0"}, params,
+        tdsl::detail::e_rpc_mode::executesql, validator, &validator_called_times);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(1, validator_called_times);
+}
+
+// --------------------------------------------------------------------------------
+
 TEST_F(tds_command_ctx_it_fixture, test_rpc_varchar) {
     tdsl::detail::sql_parameter_varchar p1{};
     p1                                            = tdsl::string_view{"abc"};
@@ -960,3 +1168,96 @@ TEST_F(tds_command_ctx_it_fixture, utf16_query_string) {
         &called);
     ASSERT_TRUE(called);
 }
+
+// --------------------------------------------------------------------------------
+TEST_F(tds_command_ctx_it_fixture, nvarchar_max) {
+    ASSERT_TRUE(tds_ctx.tds_version_at_least(tdsl::detail::e_tds_version::sql_server_2005));
+
+    // Larger than a single packet, so that the value arrives in multiple chunks
+    bool called = false;
+    command_ctx.execute_query(
+        tdsl::string_view{"SELECT REPLICATE(CAST(N'a' AS NVARCHAR(MAX)), 5000), "
+                          "CAST(NULL AS NVARCHAR(MAX)), CAST(N'' AS NVARCHAR(MAX))"},
+        [](void * u, const tdsl::tds_colmetadata_token & colmd, const tdsl::tdsl_row & row) {
+            *static_cast<bool *>(u) = true;
+            ASSERT_EQ(colmd.columns.size(), 3);
+            ASSERT_EQ(row [0].size_bytes(), 10000);
+            for (tdsl::size_t i = 0; i < row [0].size_bytes(); i += 2) {
+                ASSERT_EQ(row [0].data() [i], 'a');
+            }
+            ASSERT_TRUE(row [1].is_null());
+            ASSERT_FALSE(row [2].is_null());
+            ASSERT_EQ(row [2].size_bytes(), 0);
+        },
+        &called);
+    ASSERT_TRUE(called);
+}
+
+// --------------------------------------------------------------------------------
+TEST_F(tds_command_ctx_it_fixture, stream_large_fields) {
+    struct context {
+        tdsl::size_t streamed_bytes;
+        int completed;
+        bool row_called;
+    } ctx{0, 0, false};
+
+    command_ctx.set_stream_sink(
+        [](void * u, const tdsl::tds_colmetadata_token &, tdsl::uint32_t cidx,
+           tdsl::byte_view chunk, bool last) {
+            auto & c = *static_cast<context *>(u);
+            ASSERT_EQ(cidx, 1);
+            c.streamed_bytes += chunk.size_bytes();
+            c.completed += last;
+        },
+        &ctx);
+
+    // A value much larger than the network buffer
+    command_ctx.execute_query(
+        tdsl::string_view{"SELECT 1, REPLICATE(CAST(N'a' AS NVARCHAR(MAX)), 1000000), 2"},
+        [](void * u, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row & row) {
+            auto & c     = *static_cast<context *>(u);
+            c.row_called = true;
+            ASSERT_EQ(c.completed, 1);
+            ASSERT_EQ(row [0].as<tdsl::int32_t>(), 1);
+            ASSERT_FALSE(row [1].is_null());
+            ASSERT_EQ(row [1].size_bytes(), 0);
+            ASSERT_EQ(row [2].as<tdsl::int32_t>(), 2);
+        },
+        &ctx);
+    ASSERT_TRUE(ctx.row_called);
+    ASSERT_EQ(ctx.streamed_bytes, 2000000);
+}
+
+// --------------------------------------------------------------------------------
+TEST_F(tds_command_ctx_it_fixture, date_time_types) {
+    bool called = false;
+    command_ctx.execute_query(
+        tdsl::string_view{"SELECT CAST('2022-10-05' AS DATE), CAST('12:34:56' AS TIME(0)), "
+                          "CAST(NULL AS DATETIME2(7))"},
+        [](void * u, const tdsl::tds_colmetadata_token & colmd, const tdsl::tdsl_row & row) {
+            *static_cast<bool *>(u) = true;
+            ASSERT_EQ(colmd.columns.size(), 3);
+            ASSERT_EQ(colmd.columns [0].type, tdsl::detail::e_tds_data_type::DATENTYPE);
+            ASSERT_EQ(colmd.columns [1].type, tdsl::detail::e_tds_data_type::TIMENTYPE);
+            ASSERT_EQ(colmd.columns [1].typeprops.ps.scale, 0);
+            ASSERT_EQ(row [0].size_bytes(), 3);
+            ASSERT_EQ(row [1].size_bytes(), 3);
+            ASSERT_TRUE(row [2].is_null());
+        },
+        &called);
+    ASSERT_TRUE(called);
+}
+
+// --------------------------------------------------------------------------------
+TEST_F(tds_command_ctx_it_fixture, transaction) {
+    command_ctx.execute_query(tdsl::string_view{"CREATE TABLE #test_txn(a int)"});
+    ASSERT_EQ(tds_ctx.current_transaction_descriptor(), 0);
+    ASSERT_TRUE(command_ctx.execute_query(tdsl::string_view{"BEGIN TRANSACTION"}));
+    ASSERT_NE(tds_ctx.current_transaction_descriptor(), 0);
+    // The commands in the transaction must carry the transaction descriptor
+    ASSERT_EQ(command_ctx.execute_query(tdsl::string_view{"INSERT INTO #test_txn VALUES(1)"})
+                  .affected_rows,
+              1);
+    ASSERT_TRUE(command_ctx.execute_query(tdsl::string_view{"COMMIT TRANSACTION"}));
+    ASSERT_EQ(tds_ctx.current_transaction_descriptor(), 0);
+}
@@ -85,3 +85,84 @@ TEST_F(tds_driver_it_fixture, execute_query_char16_str) {
     ASSERT_FALSE(r2.status.srverror());
     ASSERT_EQ(1, r2.affected_rows);
 }
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_it_fixture, reconnect) {
+    // The cached login message and the cached endpoints are used
+    for (int i = 0; i < 3; i++) {
+        uut.disconnect();
+        ASSERT_EQ(uut_t::e_driver_error_code::success, uut.connect(mssql_2022_creds()));
+        ASSERT_TRUE(uut.execute_query("SELECT 1"));
+    }
+
+    // Login with different parameters must not reuse the cached message
+    auto params     = mssql_2022_creds();
+    params.password = "wrong-password";
+    uut.disconnect();
+    ASSERT_EQ(uut_t::e_driver_error_code::login_failed, uut.connect(params));
+    uut.disconnect();
+    ASSERT_EQ(uut_t::e_driver_error_code::success, uut.connect(mssql_2022_creds()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_it_fixture, command_timeout) {
+    uut.option_set_command_timeout(500);
+    auto r1 = uut.execute_query("WAITFOR DELAY '00:00:05'");
+    // The server acknowledges the ATTENTION
+    ASSERT_TRUE(r1.status.attn());
+
+    // The connection is usable afterwards
+    uut.option_set_command_timeout(0);
+    auto r2 = uut.execute_query("SELECT 1");
+    ASSERT_TRUE(r2);
+    ASSERT_FALSE(r2.status.attn());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_it_fixture, cancel_from_row_callback) {
+    tdsl::uint32_t row_count = {0};
+    struct ctx_t {
+        uut_t * driver;
+        tdsl::uint32_t * row_count;
+    } ctx{&uut, &row_count};
+
+    auto r1 = uut.execute_query(
+        "SELECT a.object_id FROM sys.all_objects a CROSS JOIN sys.all_objects b",
+        +[](void * uptr, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row &) {
+            auto & c = *static_cast<ctx_t *>(uptr);
+            if (++*c.row_count == 10) {
+                ASSERT_TRUE(c.driver->cancel());
+                // Already pending
+                ASSERT_FALSE(c.driver->cancel());
+            }
+        },
+        &ctx);
+    ASSERT_TRUE(r1.status.attn());
+    ASSERT_GE(row_count, 10u);
+
+    auto r2 = uut.execute_query("SELECT 1");
+    ASSERT_TRUE(r2);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_it_fixture, execute_rpc_batch) {
+    ASSERT_TRUE(uut.execute_query("CREATE TABLE #test_rpc_batch(a int)"));
+
+    tdsl::detail::sql_parameter_int p0{};
+    p0                                            = 7;
+    tdsl::detail::sql_parameter_binding params [] = {p0};
+
+    uut_t::sql_command_query_result results [2];
+    auto r = uut.execute_rpc_batch(results, [&](uut_t::sql_command_type & batch) {
+        batch.add_rpc(tdsl::string_view{"INSERT INTO #test_rpc_batch VALUES(@p0)"}, params);
+        batch.add_rpc(tdsl::string_view{"UPDATE #test_rpc_batch SET a=a+1"});
+    });
+    ASSERT_TRUE(r);
+    EXPECT_EQ(*r, 2);
+    EXPECT_EQ(results [0].affected_rows, 1);
+    EXPECT_EQ(results [1].affected_rows, 1);
+}
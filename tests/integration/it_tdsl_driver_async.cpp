@@ -0,0 +1,132 @@
+/**
+ * ____________________________________________________
+ * tdsl_driver asynchronous API integration tests
+ *
+ * @file   it_tdsl_driver_async.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_driver.hpp>
+#include <tdslite-net/asio/tdsl_netimpl_asio_async.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using uut_t = tdsl::detail::tdsl_driver<tdsl::net::tdsl_netimpl_asio_async>;
+
+/**
+ * Credentials for internal mssql 2022
+ *
+ * @return const uut_t::connection_parameters&
+ */
+static inline auto mssql_2022_creds() -> const uut_t::connection_parameters & {
+    static uut_t::connection_parameters params = [] {
+        uut_t::connection_parameters p;
+        p.server_name  = "mssql-2022";
+        p.user_name    = "sa";
+        p.password     = "2022-tds-lite-test!";
+        p.client_name  = "tdslite integration test case";
+        p.app_name     = "tdslite integration test";
+        p.library_name = "tdslite";
+        p.db_name      = "master";
+        return p;
+    }();
+
+    return params;
+}
+
+/**
+ * tdsl_driver asynchronous API integration tests.
+ *
+ * NOTE: Prefix all table names with single `#` so
+ * the table becomes a session-specific temporary table.
+ * Otherwise, concurrent tests running in parallel can step
+ * each other's feet.
+ */
+struct tds_driver_async_it_fixture : public ::testing::Test {
+
+    virtual void SetUp() override {
+        uut_t::e_driver_error_code r = uut_t::e_driver_error_code::connection_failed;
+        uut.async_connect(mssql_2022_creds(), [&r](uut_t::e_driver_error_code ec) { r = ec; });
+        io_context.run();
+        io_context.restart();
+        ASSERT_EQ(r, uut_t::e_driver_error_code::success);
+    }
+
+public:
+    boost::asio::io_context io_context{};
+    uut_t uut{io_context};
+};
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_async_it_fixture, async_execute_query) {
+    tdsl::int32_t net_error = {-1};
+    uut_t::sql_command_query_result result{};
+    std::vector<tdsl::int32_t> rows{};
+
+    uut.async_execute_query(
+        tdsl::string_view{"SELECT * FROM (VALUES (1), (2), (3)) AS t(x)"},
+        +[](void * uptr, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row & row) {
+            auto & rows = *static_cast<std::vector<tdsl::int32_t> *>(uptr);
+            rows.push_back(row [0].as<tdsl::int32_t>());
+        },
+        &rows, [&](tdsl::int32_t ec, const uut_t::sql_command_query_result & r) {
+            net_error = ec;
+            result    = r;
+        });
+
+    // Nothing happens until the io_context runs
+    ASSERT_TRUE(rows.empty());
+    io_context.run();
+
+    ASSERT_EQ(0, net_error);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(3, result.affected_rows);
+    ASSERT_THAT(rows, testing::ElementsAre(1, 2, 3));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_async_it_fixture, async_execute_rpc) {
+    tdsl::int32_t net_error = {-1};
+    uut_t::sql_command_rpc_result result{tdsl::uint32_t{0}};
+    std::vector<tdsl::int32_t> rows{};
+
+    tdsl::int32_t value = 42;
+    tdsl::detail::sql_parameter_int p{};
+    p = value;
+    tdsl::detail::sql_parameter_binding params [] = {p};
+
+    uut.async_execute_rpc(
+        tdsl::string_view{"SELECT @p0"}, params, uut_t::sql_command_rpc_mode::executesql,
+        +[](void * uptr, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row & row) {
+            auto & rows = *static_cast<std::vector<tdsl::int32_t> *>(uptr);
+            rows.push_back(row [0].as<tdsl::int32_t>());
+        },
+        &rows, [&](tdsl::int32_t ec, uut_t::sql_command_rpc_result r) {
+            net_error = ec;
+            result    = TDSL_MOVE(r);
+        });
+    io_context.run();
+
+    ASSERT_EQ(0, net_error);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(1, *result);
+    ASSERT_THAT(rows, testing::ElementsAre(42));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tds_driver_async_it_fixture, async_connect_invalid_params) {
+    uut_t::connection_parameters p{};
+    uut_t::e_driver_error_code r = uut_t::e_driver_error_code::success;
+    uut.async_connect(p, [&r](uut_t::e_driver_error_code ec) { r = ec; });
+    ASSERT_EQ(r, uut_t::e_driver_error_code::connection_param_server_name_empty);
+}
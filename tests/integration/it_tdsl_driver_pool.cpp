@@ -0,0 +1,109 @@
+/**
+ * ____________________________________________________
+ * tdsl_driver_pool integration tests
+ *
+ * @file   it_tdsl_driver_pool.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_driver_pool.hpp>
+#include <tdslite-net/asio/tdsl_netimpl_asio.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using uut_t    = tdsl::driver_pool<tdsl::net::tdsl_netimpl_asio>;
+using driver_t = uut_t::driver_type;
+
+/**
+ * Credentials for internal mssql 2022
+ *
+ * @return const driver_t::connection_parameters&
+ */
+static inline auto mssql_2022_creds() -> const driver_t::connection_parameters & {
+    static driver_t::connection_parameters params = [] {
+        driver_t::connection_parameters p;
+        p.server_name  = "mssql-2022";
+        p.user_name    = "sa";
+        p.password     = "2022-tds-lite-test!";
+        p.client_name  = "tdslite integration test case";
+        p.app_name     = "tdslite integration test";
+        p.library_name = "tdslite";
+        p.db_name      = "master";
+        return p;
+    }();
+
+    return params;
+}
+
+static inline auto pool_options() -> uut_t::pool_options {
+    uut_t::pool_options o{};
+    o.max_connections = 4;
+    o.min_connections = 4;
+    return o;
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(tds_driver_pool_it, warm_up) {
+    uut_t uut{pool_options(), mssql_2022_creds()};
+    ASSERT_EQ(4, uut.warm_up());
+    ASSERT_EQ(4, uut.idle_connections());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(tds_driver_pool_it, concurrent_queries) {
+    uut_t uut{pool_options(), mssql_2022_creds()};
+    ASSERT_EQ(4, uut.warm_up());
+
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> workers{};
+    for (int i = 0; i < 8; i++) {
+        workers.emplace_back([&] {
+            for (int j = 0; j < 10; j++) {
+                auto lease = uut.acquire();
+                if (not lease) {
+                    continue;
+                }
+                if (lease->execute_query("SELECT 1")) {
+                    succeeded++;
+                }
+            }
+        });
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+
+    ASSERT_EQ(80, succeeded.load());
+    // All of the work is done with the warmed up connections
+    ASSERT_EQ(4, uut.open_connections());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(tds_driver_pool_it, health_check_after_disconnect) {
+    auto o               = pool_options();
+    o.min_connections    = 1;
+    o.health_check_after = std::chrono::milliseconds{0};
+    uut_t uut{o, mssql_2022_creds()};
+    {
+        auto lease = uut.acquire();
+        ASSERT_TRUE(lease);
+        // Kill the connection behind the pool's back
+        lease->disconnect();
+    }
+
+    auto lease = uut.acquire();
+    ASSERT_TRUE(lease);
+    ASSERT_TRUE(lease->execute_query("SELECT 1"));
+}
@@ -34,6 +34,7 @@ struct tds_login_ctx_it_fixture : public ::testing::Test {
 
     virtual void SetUp() override {
         ASSERT_TRUE(tds_ctx.do_connect("mssql-2022", /*port=*/1433));
+        ASSERT_EQ(login.do_prelogin(), uut_t::e_login_status::success);
     }
 
     virtual void TearDown() override {}
@@ -54,6 +55,7 @@ TEST_F(tds_login_ctx_it_fixture, login) {
     params.library_name = "tdslite";
     params.db_name      = "master";
     EXPECT_EQ(login.do_login(params), uut_t::e_login_status::success);
+    EXPECT_EQ(tds_ctx.negotiated_tds_version(), tdsl::detail::e_tds_version::sql_server_2012);
 }
 
 // --------------------------------------------------------------------------------
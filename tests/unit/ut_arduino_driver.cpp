@@ -10,7 +10,9 @@
  * _________________________________________________
  */
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 std::function<void(int)> delay = [](int ms) {
     (void) ms;
@@ -166,14 +168,28 @@ TEST(test, connect) {
 
 TEST(test, connect_retry) {
     auto delay_original = delay;
-    testing::MockFunction<void(int)> mock_delay;
-    EXPECT_CALL(mock_delay, Call(1234)).Times(15);
-    delay = mock_delay.AsStdFunction();
+    std::vector<int> delays;
+    delay = [&delays](int ms) {
+        delays.push_back(ms);
+    };
     uut_t<my_client> the_client{buf};
     the_client.set_connection_timeout_params(/*attempts=*/15, /*delay_ms=*/1234);
     auto r = the_client.connect(/*host=*/tdsl::string_view{/*str=*/"a"}, /*port=*/105);
     ASSERT_FALSE(r);
     delay = delay_original;
+
+    // No delay after the last attempt
+    ASSERT_EQ(14, delays.size());
+    // The delay doubles after each attempt (100, 200, 400, 800, 1234, 1234...)
+    // and a random amount of up to half of it is subtracted as the jitter
+    const int expected_backoff [] = {100, 200, 400, 800};
+    for (std::size_t i = 0; i < delays.size(); i++) {
+        const int backoff = i < 4 ? expected_backoff [i] : 1234;
+        EXPECT_GE(delays [i], backoff / 2);
+        EXPECT_LE(delays [i], backoff);
+    }
+    // The jitter must vary between the attempts
+    ASSERT_NE(delays [4], delays [5]);
 }
 
 TEST(test, write) {
@@ -194,4 +210,425 @@ TEST(test, receive_tds_pdu_chunked) {
 TEST(test, send_tds_pdu) {
     uut_t<my_client> the_client{buf};
     the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::login);
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------------------------
+
+/**
+ * The TDS packets served by my_client_stream
+ */
+struct tds_stream {
+    std::vector<tdsl::uint8_t> data{};
+    tdsl::size_t read_offset = {0};
+    tdsl::size_t max_read    = {7};
+    tdsl::size_t read_calls  = {0};
+    tdsl::uint8_t seq        = {0};
+
+    /**
+     * Append a tabular result packet that contains @p record_count
+     * records of @p record_size bytes each. Each byte of a record
+     * is equal to the record's sequence number.
+     */
+    void add_packet(tdsl::uint8_t record_size, tdsl::uint8_t record_count, bool eom) {
+        const auto length = static_cast<tdsl::uint16_t>(8 + record_size * record_count);
+        data.insert(data.end(), {0x04, static_cast<tdsl::uint8_t>(eom),
+                                 static_cast<tdsl::uint8_t>(length >> 8),
+                                 static_cast<tdsl::uint8_t>(length & 0xFF), 0x00, 0x00, 0x01,
+                                 0x00});
+        for (tdsl::uint8_t i = 0; i < record_count; i++, seq++) {
+            data.insert(data.end(), record_size, seq);
+        }
+    }
+} stream;
+
+// --------------------------------------------------------------------------------
+
+/**
+ * Client that serves the TDS packets in `stream`,
+ * at most `stream.max_read` bytes per read() call.
+ */
+struct my_client_stream : public my_client {
+    virtual int read(unsigned char * buf, unsigned long amount) override {
+        amount = std::min<unsigned long>(
+            {amount, static_cast<unsigned long>(stream.max_read),
+             static_cast<unsigned long>(stream.data.size() - stream.read_offset)});
+        stream.read_calls++;
+        memcpy(buf, stream.data.data() + stream.read_offset, amount);
+        stream.read_offset += amount;
+        return static_cast<int>(amount);
+    }
+
+    int available() {
+        return static_cast<int>(stream.data.size() - stream.read_offset);
+    }
+};
+
+// --------------------------------------------------------------------------------
+
+/**
+ * Packet data callback that consumes fixed size records
+ */
+struct record_collector {
+    tdsl::uint32_t record_size = {9};
+    std::vector<tdsl::uint8_t> records{};
+    bool corrupt = {false};
+
+    static tdsl::uint32_t handle(void * uptr, tdsl::detail::e_tds_message_type,
+                                 tdsl::binary_reader<tdsl::endian::little> & rdr) {
+        auto & self = *static_cast<record_collector *>(uptr);
+        while (rdr.has_bytes(self.record_size)) {
+            const auto record = rdr.read(self.record_size);
+            for (auto b : record) {
+                self.corrupt |= (b != record [0]);
+            }
+            self.records.push_back(record [0]);
+        }
+        return static_cast<tdsl::uint32_t>(self.record_size - rdr.remaining_bytes());
+    }
+};
+
+// --------------------------------------------------------------------------------
+
+/**
+ * Network implementation that does not provide do_recv_some(),
+ * so the TDS packets are received with exact reads. Serves the
+ * TDS packets in `stream`.
+ */
+struct exact_read_netimpl : public tdsl::net::network_io_base<exact_read_netimpl> {
+    template <tdsl::uint32_t BufSize>
+    explicit exact_read_netimpl(tdsl::uint8_t (&network_io_buffer) [BufSize]) {
+        network_buffer = tdsl::tdsl_buffer_object{network_io_buffer};
+    }
+
+    template <typename T>
+    auto do_connect(T, tdsl::uint16_t) -> tdsl::expected<tdsl::traits::true_type, int> {
+        return tdsl::traits::true_type{};
+    }
+
+    tdsl::int32_t do_disconnect() noexcept {
+        return 0;
+    }
+
+    void do_send(tdsl::byte_view, tdsl::byte_view) noexcept {}
+
+    network_io_result do_recv(tdsl::uint32_t transfer_exactly, tdsl::byte_span dst) noexcept {
+        if (transfer_exactly > dst.size_bytes() ||
+            transfer_exactly > stream.data.size() - stream.read_offset) {
+            return tdsl::unexpected(-1);
+        }
+        stream.read_calls++;
+        memcpy(dst.data(), stream.data.data() + stream.read_offset, transfer_exactly);
+        stream.read_offset += transfer_exactly;
+        return transfer_exactly;
+    }
+
+    network_io_result do_recv(tdsl::uint32_t transfer_exactly) noexcept {
+        auto writer = network_buffer.get_writer(transfer_exactly);
+        if (transfer_exactly > writer->remaining_bytes()) {
+            return tdsl::unexpected(-2);
+        }
+        auto result = do_recv(transfer_exactly, writer->free_span());
+        if (result) {
+            writer->advance(static_cast<tdsl::int32_t>(transfer_exactly));
+        }
+        return result;
+    }
+};
+
+// --------------------------------------------------------------------------------
+
+template <typename Uut>
+static void receive_tds_pdu_larger_than_buffer() {
+    tdsl::uint8_t small_buf [32] = {0};
+    Uut the_client{small_buf};
+    stream = {};
+    stream.add_packet(/*record_size=*/9, /*record_count=*/27, /*eom=*/false);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/27, /*eom=*/true);
+
+    record_collector rc{};
+    the_client.register_packet_data_callback(&record_collector::handle, &rc);
+    ASSERT_EQ(2, the_client.do_receive_tds_pdu());
+    ASSERT_FALSE(rc.corrupt);
+    ASSERT_EQ(54, rc.records.size());
+    for (tdsl::uint8_t i = 0; i < 54; i++) {
+        ASSERT_EQ(i, rc.records [i]);
+    }
+    ASSERT_EQ(stream.data.size(), stream.read_offset);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_larger_than_buffer) {
+    receive_tds_pdu_larger_than_buffer<uut_t<my_client_stream>>();
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_larger_than_buffer_exact_read) {
+    receive_tds_pdu_larger_than_buffer<exact_read_netimpl>();
+}
+
+// --------------------------------------------------------------------------------
+
+template <typename Uut>
+static void receive_tds_pdu_token_larger_than_buffer() {
+    tdsl::uint8_t small_buf [32] = {0};
+    Uut the_client{small_buf};
+    stream = {};
+    // A record that can never fit into the buffer
+    stream.add_packet(/*record_size=*/40, /*record_count=*/3, /*eom=*/false);
+    stream.add_packet(/*record_size=*/40, /*record_count=*/3, /*eom=*/true);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/10, /*eom=*/true);
+
+    record_collector rc{};
+    rc.record_size = 40;
+    the_client.register_packet_data_callback(&record_collector::handle, &rc);
+    // The message must be discarded as a whole
+    the_client.do_receive_tds_pdu();
+    ASSERT_TRUE(rc.records.empty());
+
+    // .. and the connection must stay in sync
+    rc.record_size = 9;
+    ASSERT_EQ(1, the_client.do_receive_tds_pdu());
+    ASSERT_FALSE(rc.corrupt);
+    ASSERT_EQ(10, rc.records.size());
+    ASSERT_EQ(6, rc.records [0]);
+    ASSERT_EQ(stream.data.size(), stream.read_offset);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_token_larger_than_buffer) {
+    receive_tds_pdu_token_larger_than_buffer<uut_t<my_client_stream>>();
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_token_larger_than_buffer_exact_read) {
+    receive_tds_pdu_token_larger_than_buffer<exact_read_netimpl>();
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_batched) {
+    uut_t<my_client_stream> the_client{buf};
+    stream          = {};
+    stream.max_read = sizeof(buf);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/10, /*eom=*/false);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/10, /*eom=*/false);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/10, /*eom=*/true);
+
+    record_collector rc{};
+    the_client.register_packet_data_callback(&record_collector::handle, &rc);
+    ASSERT_EQ(3, the_client.do_receive_tds_pdu());
+    // All three packets must be received with a single read
+    ASSERT_EQ(1, stream.read_calls);
+    ASSERT_FALSE(rc.corrupt);
+    ASSERT_EQ(30, rc.records.size());
+    for (tdsl::uint8_t i = 0; i < 30; i++) {
+        ASSERT_EQ(i, rc.records [i]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, receive_tds_pdu_keeps_data_after_eom) {
+    uut_t<my_client_stream> the_client{buf};
+    stream          = {};
+    stream.max_read = sizeof(buf);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/4, /*eom=*/false);
+    stream.add_packet(/*record_size=*/9, /*record_count=*/4, /*eom=*/true);
+    // The next message arrives in the same read
+    stream.add_packet(/*record_size=*/9, /*record_count=*/3, /*eom=*/true);
+
+    record_collector rc{};
+    the_client.register_packet_data_callback(&record_collector::handle, &rc);
+    ASSERT_EQ(2, the_client.do_receive_tds_pdu());
+    ASSERT_EQ(1, stream.read_calls);
+    ASSERT_EQ(8, rc.records.size());
+
+    // The second message is received without reading from the client
+    ASSERT_EQ(1, the_client.do_receive_tds_pdu());
+    ASSERT_EQ(1, stream.read_calls);
+    ASSERT_FALSE(rc.corrupt);
+    ASSERT_EQ(11, rc.records.size());
+    for (tdsl::uint8_t i = 0; i < 11; i++) {
+        ASSERT_EQ(i, rc.records [i]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+/**
+ * Client that records every write() call
+ */
+struct my_client_capture : public my_client {
+    static std::vector<std::vector<tdsl::uint8_t>> writes;
+
+    tdsl::size_t write(const unsigned char * buf, tdsl::size_t len) {
+        writes.emplace_back(buf, buf + len);
+        return len;
+    }
+};
+
+std::vector<std::vector<tdsl::uint8_t>> my_client_capture::writes{};
+
+// --------------------------------------------------------------------------------
+
+/**
+ * Check that @p packet is a TDS packet with the given properties
+ * and append its payload to @p payload
+ */
+static void expect_packet(const std::vector<tdsl::uint8_t> & packet, bool eom,
+                          std::vector<tdsl::uint8_t> & payload) {
+    ASSERT_GE(packet.size(), 8);
+    ASSERT_EQ(0x01, packet [0]); // sql_batch
+    ASSERT_EQ(eom, packet [1]);
+    ASSERT_EQ(packet.size(), static_cast<tdsl::size_t>((packet [2] << 8) | packet [3]));
+    payload.insert(payload.end(), packet.begin() + 8, packet.end());
+}
+
+// --------------------------------------------------------------------------------
+
+static std::vector<tdsl::uint8_t> make_message(tdsl::size_t size) {
+    std::vector<tdsl::uint8_t> message(size);
+    for (tdsl::size_t i = 0; i < size; i++) {
+        message [i] = static_cast<tdsl::uint8_t>(i * 7);
+    }
+    return message;
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, send_tds_pdu_coalesced) {
+    tdsl::uint8_t large_buf [2048] = {0};
+    uut_t<my_client_capture> the_client{large_buf};
+    my_client_capture::writes.clear();
+    the_client.set_tds_packet_size(512);
+    auto message = make_message(1000);
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), message.size()});
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+
+    // One write per packet, header and payload together
+    ASSERT_EQ(2, my_client_capture::writes.size());
+    std::vector<tdsl::uint8_t> payload;
+    expect_packet(my_client_capture::writes [0], false, payload);
+    expect_packet(my_client_capture::writes [1], true, payload);
+    ASSERT_EQ(512, my_client_capture::writes [0].size());
+    ASSERT_EQ(message, payload);
+    ASSERT_EQ(0, the_client.do_get_write_offset());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, send_tds_pdu_coalesced_full_buffer) {
+    uut_t<my_client_capture> the_client{buf};
+    my_client_capture::writes.clear();
+    the_client.set_tds_packet_size(512);
+    // No room in front of the message for the first header
+    auto message = make_message(sizeof(buf));
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), message.size()});
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+
+    ASSERT_EQ(3, my_client_capture::writes.size());
+    // First header is sent separately
+    ASSERT_EQ(8, my_client_capture::writes [0].size());
+    auto first_packet = my_client_capture::writes [0];
+    first_packet.insert(first_packet.end(), my_client_capture::writes [1].begin(),
+                        my_client_capture::writes [1].end());
+    std::vector<tdsl::uint8_t> payload;
+    expect_packet(first_packet, false, payload);
+    expect_packet(my_client_capture::writes [2], true, payload);
+    ASSERT_EQ(message, payload);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, flush_tds_pdu) {
+    tdsl::uint8_t large_buf [2048] = {0};
+    uut_t<my_client_capture> the_client{large_buf};
+    my_client_capture::writes.clear();
+    the_client.set_tds_packet_size(512);
+    auto message = make_message(1300);
+    // Two complete packets are sent, the rest is kept
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), 1200});
+    the_client.do_flush_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    ASSERT_EQ(4, my_client_capture::writes.size());
+    ASSERT_EQ(sizeof(large_buf) - (1200 - 2 * 504), the_client.do_get_free_space());
+    // The rest of the message completes it
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data() + 1200, 100});
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+
+    std::vector<tdsl::uint8_t> stream;
+    for (const auto & w : my_client_capture::writes) {
+        stream.insert(stream.end(), w.begin(), w.end());
+    }
+    std::vector<tdsl::uint8_t> payload;
+    tdsl::size_t offset = {0};
+    for (int i = 0; i < 3; i++) {
+        ASSERT_GE(stream.size() - offset, 8);
+        const tdsl::size_t size = (stream [offset + 2] << 8) | stream [offset + 3];
+        ASSERT_LE(offset + size, stream.size());
+        expect_packet({stream.begin() + offset, stream.begin() + offset + size}, i == 2,
+                      payload);
+        offset += size;
+    }
+    ASSERT_EQ(stream.size(), offset);
+    ASSERT_EQ(message, payload);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, flush_tds_pdu_short_packet) {
+    uut_t<my_client_capture> the_client{buf};
+    my_client_capture::writes.clear();
+    the_client.set_tds_packet_size(512);
+    auto message = make_message(100);
+    // No complete packet, nothing is sent (TDS 7.3+ does not
+    // allow a short packet unless it is the last one)
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), message.size()});
+    the_client.do_flush_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    ASSERT_EQ(sizeof(buf) - message.size(), the_client.do_get_free_space());
+    ASSERT_TRUE(my_client_capture::writes.empty());
+
+    // The message is sent as a single packet when completed
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    std::vector<tdsl::uint8_t> packet;
+    for (const auto & w : my_client_capture::writes) {
+        packet.insert(packet.end(), w.begin(), w.end());
+    }
+    std::vector<tdsl::uint8_t> payload;
+    expect_packet(packet, true, payload);
+    ASSERT_EQ(message, payload);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(test, ignore_message_status_bit) {
+    tdsl::uint8_t large_buf [2048] = {0};
+    uut_t<my_client_capture> the_client{large_buf};
+    my_client_capture::writes.clear();
+    the_client.set_tds_packet_size(512);
+    auto message = make_message(600);
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), message.size()});
+    the_client.do_flush_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    the_client.set_ignore_message();
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+
+    std::vector<tdsl::uint8_t> stream;
+    for (const auto & w : my_client_capture::writes) {
+        stream.insert(stream.end(), w.begin(), w.end());
+    }
+    // The flushed packet is sent as usual, the last one
+    // carries the IGNORE bit along with the EOM
+    ASSERT_EQ(512 + 8 + 96, stream.size());
+    ASSERT_EQ(0x00, stream [1]);
+    ASSERT_EQ(0x03, stream [512 + 1]);
+
+    // Only the message being written is ignored
+    my_client_capture::writes.clear();
+    the_client.do_write(tdsl::span<const tdsl::uint8_t>{message.data(), 100});
+    the_client.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    ASSERT_FALSE(my_client_capture::writes.empty());
+    ASSERT_EQ(0x01, my_client_capture::writes [0] [1]);
+}
@@ -0,0 +1,274 @@
+/**
+ * _________________________________________________
+ * Unit tests for the C++20 coroutine adapters of
+ * the asynchronous driver operations
+ *
+ * @file   ut_asio_awaitable.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/asio/tdsl_asio_awaitable.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#ifdef TDSL_HAS_COROUTINES
+
+#include <boost/asio/io_context.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+using driver_t = tdsl::detail::tdsl_driver<tdsl::net::tdsl_netimpl_asio_async>;
+
+namespace {
+
+    using bytes_t = std::vector<tdsl::uint8_t>;
+
+    bytes_t operator+(bytes_t a, const bytes_t & b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+    }
+
+    // VERSION, ENCRYPTION (not supported), TERMINATOR
+    const bytes_t prelogin_response{0x00, 0x00, 0x0B, 0x00, 0x06, 0x01, 0x00, 0x11, 0x00,
+                                    0x01, 0xFF, 0x0F, 0x00, 0x07, 0xD0, 0x00, 0x00, 0x02};
+
+    const bytes_t loginack{0xAD, 0x0A, 0x00, 0x01, 0x71, 0x00, 0x00,
+                           0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    // COLMETADATA, one column: a INT NOT NULL
+    const bytes_t colmetadata_int{0x81, 0x01, 0x00, 0x00, 0x00, 0x00,
+                                  0x00, 0x38, 0x01, 0x61, 0x00};
+
+    bytes_t row_int(tdsl::int32_t v) {
+        return bytes_t{0xD1, static_cast<tdsl::uint8_t>(v), static_cast<tdsl::uint8_t>(v >> 8),
+                       static_cast<tdsl::uint8_t>(v >> 16), static_cast<tdsl::uint8_t>(v >> 24)};
+    }
+
+    bytes_t done(tdsl::uint32_t row_count) {
+        return bytes_t{0xFD,
+                       0x10,
+                       0x00,
+                       0xC1,
+                       0x00,
+                       static_cast<tdsl::uint8_t>(row_count),
+                       static_cast<tdsl::uint8_t>(row_count >> 8),
+                       0x00,
+                       0x00};
+    }
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * A loopback server that answers the requests of a single
+     * client with canned responses, from its own thread.
+     */
+    struct fake_tds_server {
+        fake_tds_server() {
+            listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addr_len   = sizeof(addr);
+            ::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(listen_fd, 1);
+            ::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+            port   = ntohs(addr.sin_port);
+            thread = std::thread{[this] {
+                serve();
+            }};
+        }
+
+        ~fake_tds_server() {
+            wait_for_disconnect();
+            ::close(listen_fd);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Wait until the client disconnects
+         */
+        void wait_for_disconnect() {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Receive a complete message from the client
+         *
+         * @return false if the client is disconnected
+         */
+        bool receive_message(tdsl::uint8_t & mtype) {
+            for (;;) {
+                tdsl::uint8_t hdr [8] = {};
+                if (not(::recv(peer_fd, hdr, sizeof(hdr), MSG_WAITALL) == sizeof(hdr))) {
+                    return false;
+                }
+                bytes_t data(static_cast<tdsl::size_t>((hdr [2] << 8) | hdr [3]) - sizeof(hdr));
+                if (not(::recv(peer_fd, data.data(), data.size(), MSG_WAITALL) ==
+                        static_cast<ssize_t>(data.size()))) {
+                    return false;
+                }
+                mtype = hdr [0];
+                if (hdr [1] & 0x01) {
+                    return true;
+                }
+            }
+        }
+
+        // --------------------------------------------------------------------------------
+
+        void send_response(const bytes_t & data) {
+            bytes_t packet{0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00};
+            packet     = packet + data;
+            packet [2] = static_cast<tdsl::uint8_t>(packet.size() >> 8);
+            packet [3] = static_cast<tdsl::uint8_t>(packet.size());
+            ::send(peer_fd, packet.data(), packet.size(), 0);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        void serve() {
+            peer_fd             = ::accept(listen_fd, nullptr, nullptr);
+            tdsl::uint8_t mtype = {0};
+            while (receive_message(mtype)) {
+                requests.push_back(mtype);
+                switch (mtype) {
+                    case 0x12: // PRELOGIN
+                        send_response(prelogin_response);
+                        break;
+                    case 0x10: // LOGIN7
+                        send_response(loginack + done(0));
+                        break;
+                    case 0x01: // SQL batch
+                        send_response(colmetadata_int + row_int(1) + row_int(2) + row_int(3) +
+                                      done(3));
+                        break;
+                    case 0x03: // RPC
+                        send_response(colmetadata_int + row_int(42) + done(1));
+                        break;
+                }
+            }
+            ::close(peer_fd);
+        }
+
+        int listen_fd       = {-1};
+        int peer_fd         = {-1};
+        tdsl::uint16_t port = {0};
+        // Types of the messages received, in order
+        std::vector<tdsl::uint8_t> requests;
+        std::thread thread;
+    };
+
+    // --------------------------------------------------------------------------------
+
+    /**
+     * Coroutine type that starts eagerly and runs to completion
+     * on the io_context
+     */
+    struct eager_task {
+        struct promise_type {
+            eager_task get_return_object() noexcept {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                std::terminate();
+            }
+        };
+    };
+
+    void collect_int(void * uptr, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row & row) {
+        static_cast<std::vector<tdsl::int32_t> *>(uptr)->push_back(row [0].as<tdsl::int32_t>());
+    }
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(asio_awaitable, co_connect_co_execute) {
+    fake_tds_server server{};
+    boost::asio::io_context io_context{};
+    driver_t driver{io_context};
+
+    driver_t::connection_parameters params{};
+    params.server_name = "127.0.0.1";
+    params.port        = server.port;
+    params.user_name   = "sa";
+    params.password    = "pw";
+
+    driver_t::e_driver_error_code connect_result = driver_t::e_driver_error_code::login_failed;
+    tdsl::net::tdsl_async_result<driver_t::sql_command_query_result> query_result{-1, {}};
+    tdsl::net::tdsl_async_result<driver_t::sql_command_rpc_result> rpc_result{
+        -1, driver_t::sql_command_rpc_result{tdsl::uint32_t{0}}};
+    std::vector<tdsl::int32_t> query_rows{};
+    std::vector<tdsl::int32_t> rpc_rows{};
+    bool finished = {false};
+
+    tdsl::detail::sql_parameter_int p{};
+    p                                            = 42;
+    tdsl::detail::sql_parameter_binding binds [] = {p};
+
+    auto coro = [&]() -> eager_task {
+        connect_result = co_await tdsl::net::co_connect(driver, params);
+        if (not(connect_result == driver_t::e_driver_error_code::success)) {
+            co_return;
+        }
+        query_result = co_await tdsl::net::co_execute_query(
+            driver, tdsl::string_view{"SELECT * FROM (VALUES (1), (2), (3)) AS t(x)"},
+            &collect_int, &query_rows);
+        rpc_result = co_await tdsl::net::co_execute_rpc(
+            driver, tdsl::string_view{"SELECT @p0"},
+            tdsl::span<tdsl::detail::sql_parameter_binding>{binds},
+            driver_t::sql_command_rpc_mode::executesql, &collect_int, &rpc_rows);
+        finished = {true};
+    };
+
+    coro();
+    // Nothing happens until the io_context runs
+    ASSERT_FALSE(finished);
+    io_context.run();
+    ASSERT_TRUE(finished);
+
+    ASSERT_EQ(driver_t::e_driver_error_code::success, connect_result);
+
+    ASSERT_EQ(0, query_result.error);
+    ASSERT_TRUE(query_result.result);
+    ASSERT_EQ(3, query_result.result.affected_rows);
+    ASSERT_THAT(query_rows, testing::ElementsAre(1, 2, 3));
+
+    ASSERT_EQ(0, rpc_result.error);
+    ASSERT_TRUE(rpc_result.result);
+    ASSERT_EQ(1, *rpc_result.result);
+    ASSERT_THAT(rpc_rows, testing::ElementsAre(42));
+
+    driver.disconnect();
+    server.wait_for_disconnect();
+    // PRELOGIN, LOGIN7, SQL batch, RPC
+    ASSERT_THAT(server.requests, testing::ElementsAre(0x12, 0x10, 0x01, 0x03));
+}
+
+#endif
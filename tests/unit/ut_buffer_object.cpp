@@ -193,6 +193,79 @@ TEST_F(buffer_object_fixture, write_read_buf) {
 
 // --------------------------------------------------------------------------------
 
+/**
+ * Partial reads must not move the unconsumed data around
+ */
+TEST_F(buffer_object_fixture, commit_does_not_move_data) {
+    {
+        auto writer = bo.get_writer();
+        for (tdsl::uint32_t i = 0; i < 64; i++) {
+            ASSERT_TRUE(writer->write(i));
+        }
+    }
+
+    for (tdsl::uint32_t i = 0; i < 63; i++) {
+        auto reader = bo.get_reader();
+        // The unconsumed region always starts where we left it
+        ASSERT_EQ(reader->current(), &buf [(i + 1) * sizeof(tdsl::uint32_t)] - 4);
+        ASSERT_EQ(reader->read<tdsl::uint32_t>(), i);
+    }
+
+    ASSERT_EQ(bo.unconsumed_bytes(), 4);
+    ASSERT_EQ(bo.free_space(), sizeof(buf) - 4);
+
+    // Draining the buffer resets it without any data movement
+    {
+        auto reader = bo.get_reader();
+        ASSERT_EQ(reader->read<tdsl::uint32_t>(), 63);
+    }
+    ASSERT_EQ(bo.unconsumed_bytes(), 0);
+    ASSERT_EQ(bo.get_writer(0)->offset(), 0);
+}
+
+// --------------------------------------------------------------------------------
+
+/**
+ * The writer only compacts the buffer when it is asked for
+ * more space than the tail of the buffer can provide
+ */
+TEST_F(buffer_object_fixture, writer_compacts_on_demand) {
+    {
+        auto writer = bo.get_writer();
+        ASSERT_TRUE(writer->advance(sizeof(buf) - 16));
+        ASSERT_TRUE(writer->write(tdsl::uint32_t{0xdeadbeef}));
+    }
+
+    {
+        auto reader = bo.get_reader();
+        ASSERT_TRUE(reader->advance(sizeof(buf) - 16));
+    }
+
+    // 12 bytes of space at the tail, enough for a small write
+    {
+        auto writer = bo.get_writer(8);
+        ASSERT_EQ(writer->remaining_bytes(), 12);
+        ASSERT_TRUE(writer->write(tdsl::uint32_t{0xcafebabe}));
+    }
+    ASSERT_EQ(bo.unconsumed_bytes(), 8);
+
+    // Not enough space at the tail, the writer must compact
+    {
+        auto writer = bo.get_writer(128);
+        ASSERT_EQ(writer->offset(), 8);
+        ASSERT_EQ(writer->remaining_bytes(), sizeof(buf) - 8);
+    }
+
+    {
+        auto reader = bo.get_reader();
+        ASSERT_EQ(reader->current(), &buf [0]);
+        ASSERT_EQ(reader->read<tdsl::uint32_t>(), 0xdeadbeef);
+        ASSERT_EQ(reader->read<tdsl::uint32_t>(), 0xcafebabe);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
 /**
  * Test reader-writer exclusivity.
  *
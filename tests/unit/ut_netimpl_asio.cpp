@@ -0,0 +1,354 @@
+/**
+ * _________________________________________________
+ * Unit tests for the boost::asio network implementation
+ *
+ * @file   ut_netimpl_asio.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/asio/tdsl_netimpl_asio.hpp>
+#include <tdslite-net/asio/tdsl_asio_connect_race.hpp>
+#include <tdslite/detail/tdsl_driver.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+using uut_t      = tdsl::net::tdsl_netimpl_asio;
+using driver_t   = tdsl::detail::tdsl_driver<tdsl::net::tdsl_netimpl_asio>;
+using endpoint_t = boost::asio::ip::tcp::endpoint;
+using bytes_t    = std::vector<tdsl::uint8_t>;
+namespace ip     = boost::asio::ip;
+
+namespace {
+
+    /**
+     * A listening loopback socket
+     *
+     * A listener with a full accept queue drops the SYN's of the
+     * further connection attempts, so they neither succeed nor fail
+     * until the OS connect timeout.
+     */
+    struct loopback_listener {
+        explicit loopback_listener(bool blackhole = false) {
+            listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addr_len   = sizeof(addr);
+            ::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(listen_fd, blackhole ? 0 : 1);
+            ::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+            port = ntohs(addr.sin_port);
+            if (blackhole) {
+                // Fill the accept queue
+                for (auto & fd : fillers) {
+                    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                    ::fcntl(fd, F_SETFL, O_NONBLOCK);
+                    ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+                }
+            }
+        }
+
+        ~loopback_listener() {
+            for (auto fd : fillers) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+            if (peer_fd >= 0) {
+                ::close(peer_fd);
+            }
+            ::close(listen_fd);
+        }
+
+        void accept() {
+            peer_fd = ::accept(listen_fd, nullptr, nullptr);
+        }
+
+        endpoint_t endpoint() const {
+            return endpoint_t{ip::address_v4::loopback(), port};
+        }
+
+        int listen_fd       = {-1};
+        int peer_fd         = {-1};
+        int fillers [2]     = {-1, -1};
+        tdsl::uint16_t port = {0};
+    };
+
+    // --------------------------------------------------------------------------------
+
+    // VERSION, ENCRYPTION (not supported), TERMINATOR
+    const bytes_t prelogin_response{0x00, 0x00, 0x0B, 0x00, 0x06, 0x01, 0x00, 0x11, 0x00,
+                                    0x01, 0xFF, 0x0F, 0x00, 0x07, 0xD0, 0x00, 0x00, 0x02};
+
+    const bytes_t loginack_done{0xAD, 0x0A, 0x00, 0x01, 0x71, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+                                0x00, 0x00, 0xFD, 0x00, 0x00, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    // DONE (count), one row affected
+    const bytes_t done_count{0xFD, 0x10, 0x00, 0xC1, 0x00, 0x01, 0x00, 0x00, 0x00};
+
+    // DONE (attention acknowledged)
+    const bytes_t done_attn{0xFD, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    /**
+     * A loopback server that answers the requests of a single client
+     * from its own thread. The first SQL batch is left unanswered
+     * until the client sends an ATTENTION.
+     */
+    struct stalling_tds_server {
+        stalling_tds_server() {
+            thread = std::thread{[this] {
+                serve();
+            }};
+        }
+
+        ~stalling_tds_server() {
+            wait_for_disconnect();
+        }
+
+        /**
+         * Wait until the client disconnects
+         */
+        void wait_for_disconnect() {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+
+        bool receive_message(tdsl::uint8_t & mtype) {
+            for (;;) {
+                tdsl::uint8_t hdr [8] = {};
+                if (not(::recv(listener.peer_fd, hdr, sizeof(hdr), MSG_WAITALL) == sizeof(hdr))) {
+                    return false;
+                }
+                bytes_t data(static_cast<tdsl::size_t>((hdr [2] << 8) | hdr [3]) - sizeof(hdr));
+                // A zero-length recv() would wait for the next message (ATTENTION)
+                if (not data.empty() &&
+                    not(::recv(listener.peer_fd, data.data(), data.size(), MSG_WAITALL) ==
+                        static_cast<ssize_t>(data.size()))) {
+                    return false;
+                }
+                mtype = hdr [0];
+                if (hdr [1] & 0x01) {
+                    return true;
+                }
+            }
+        }
+
+        void send_response(const bytes_t & data) {
+            bytes_t packet{0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00};
+            packet.insert(packet.end(), data.begin(), data.end());
+            packet [2] = static_cast<tdsl::uint8_t>(packet.size() >> 8);
+            packet [3] = static_cast<tdsl::uint8_t>(packet.size());
+            ::send(listener.peer_fd, packet.data(), packet.size(), 0);
+        }
+
+        void serve() {
+            listener.accept();
+            tdsl::uint8_t mtype = {0};
+            bool stalled        = {false};
+            while (receive_message(mtype)) {
+                switch (mtype) {
+                    case 0x12: // PRELOGIN
+                        send_response(prelogin_response);
+                        break;
+                    case 0x10: // LOGIN7
+                        send_response(loginack_done);
+                        break;
+                    case 0x01: // SQL batch
+                        if (not stalled) {
+                            stalled = {true};
+                            break;
+                        }
+                        send_response(done_count);
+                        break;
+                    case 0x06: // ATTENTION
+                        attention_count++;
+                        send_response(done_attn);
+                        break;
+                }
+            }
+        }
+
+        loopback_listener listener{};
+        int attention_count = {0};
+        std::thread thread;
+    };
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, interleave_address_families) {
+    const endpoint_t a4{ip::make_address("10.0.0.1"), 1433};
+    const endpoint_t b4{ip::make_address("10.0.0.2"), 1433};
+    const endpoint_t c4{ip::make_address("10.0.0.3"), 1433};
+    const endpoint_t a6{ip::make_address("fd00::1"), 1433};
+    const endpoint_t b6{ip::make_address("fd00::2"), 1433};
+
+    std::vector<endpoint_t> eps{a6, b6, a4, b4, c4};
+    tdsl::net::detail::interleave_address_families(eps);
+    ASSERT_THAT(eps, testing::ElementsAre(a6, a4, b6, b4, c4));
+
+    // Starts with the family of the first endpoint
+    eps = {a4, b4, c4, a6};
+    tdsl::net::detail::interleave_address_families(eps);
+    ASSERT_THAT(eps, testing::ElementsAre(a4, a6, b4, c4));
+
+    // Single family, the order is preserved
+    eps = {c4, a4, b4};
+    tdsl::net::detail::interleave_address_families(eps);
+    ASSERT_THAT(eps, testing::ElementsAre(c4, a4, b4));
+
+    eps.clear();
+    tdsl::net::detail::interleave_address_families(eps);
+    ASSERT_TRUE(eps.empty());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, connect_race_skips_blackholed_endpoint) {
+    loopback_listener blackhole{true};
+    loopback_listener good{};
+    const std::vector<endpoint_t> eps{blackhole.endpoint(), good.endpoint()};
+
+    boost::asio::io_context ctx{1};
+    auto guard = boost::asio::make_work_guard(ctx);
+
+    // The same io_context must be reusable for the consecutive races
+    for (int i = 0; i < 2; i++) {
+        tdsl::net::detail::connect_race race{ctx, eps, std::chrono::milliseconds{20},
+                                             std::chrono::milliseconds{0}};
+        auto sock = race.run();
+        ASSERT_TRUE(sock);
+        ASSERT_EQ(good.endpoint(), sock->remote_endpoint());
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, connect_race_restarts_stopped_context) {
+    loopback_listener good{};
+    const std::vector<endpoint_t> eps{good.endpoint()};
+
+    boost::asio::io_context ctx{1};
+    auto guard = boost::asio::make_work_guard(ctx);
+    ctx.stop();
+
+    tdsl::net::detail::connect_race race{ctx, eps, std::chrono::milliseconds{20},
+                                         std::chrono::milliseconds{0}};
+    auto sock = race.run();
+    ASSERT_TRUE(sock);
+    ASSERT_EQ(good.endpoint(), sock->remote_endpoint());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, connect_race_abandoned_on_stop) {
+    loopback_listener blackhole{true};
+    const std::vector<endpoint_t> eps{blackhole.endpoint()};
+
+    boost::asio::io_context ctx{1};
+    auto guard = boost::asio::make_work_guard(ctx);
+    // Stop the context in the middle of the race
+    boost::asio::post(ctx, [&ctx] {
+        ctx.stop();
+    });
+
+    tdsl::net::detail::connect_race race{ctx, eps, std::chrono::milliseconds{20},
+                                         std::chrono::milliseconds{0}};
+    ASSERT_FALSE(race.run());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, connect_race_all_blackholed) {
+    loopback_listener blackhole{true};
+    const std::vector<endpoint_t> eps{blackhole.endpoint()};
+
+    boost::asio::io_context ctx{1};
+    auto guard = boost::asio::make_work_guard(ctx);
+
+    tdsl::net::detail::connect_race race{ctx, eps, std::chrono::milliseconds{20},
+                                         std::chrono::milliseconds{50}};
+    ASSERT_FALSE(race.run());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, connect_twice) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    auto r = uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(r.error(), -1);
+    ASSERT_EQ(0, uut.do_disconnect());
+    ASSERT_EQ(-1, uut.do_disconnect());
+    // Reconnect, from the resolve cache
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    ASSERT_EQ(0, uut.do_disconnect());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, reconnect_drops_timed_out_receive) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+
+    uut.set_receive_timeout(10);
+    uut.do_receive_tds_pdu();
+    ASSERT_EQ(uut_t::e_receive_status::timed_out, uut.receive_status());
+
+    // The interrupted receive must not be resumed on the new connection
+    ASSERT_EQ(0, uut.do_disconnect());
+    ASSERT_TRUE(uut.connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    ASSERT_EQ(uut_t::e_receive_status::complete, uut.receive_status());
+    ASSERT_EQ(0, uut.do_disconnect());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_asio, driver_command_timeout) {
+    stalling_tds_server server{};
+    driver_t driver{};
+
+    driver_t::connection_parameters params{};
+    params.server_name = "127.0.0.1";
+    params.port        = server.listener.port;
+    params.user_name   = "sa";
+    params.password    = "pw";
+    ASSERT_EQ(driver_t::e_driver_error_code::success, driver.connect(params));
+
+    driver.option_set_command_timeout(50);
+    // The server does not respond until the ATTENTION
+    auto r = driver.execute_query(tdsl::string_view{"WAITFOR DELAY '00:01'"});
+    ASSERT_TRUE(r.status.attn());
+
+    // The connection stays usable afterwards
+    r = driver.execute_query(tdsl::string_view{"SELECT 1"});
+    ASSERT_FALSE(r.status.attn());
+    ASSERT_EQ(1, r.affected_rows);
+
+    driver.disconnect();
+    server.wait_for_disconnect();
+    ASSERT_EQ(1, server.attention_count);
+}
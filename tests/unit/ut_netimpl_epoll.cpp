@@ -0,0 +1,225 @@
+/**
+ * _________________________________________________
+ * Unit tests for the epoll network implementation
+ *
+ * @file   ut_netimpl_epoll.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/epoll/tdsl_netimpl_epoll.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using uut_t = tdsl::net::tdsl_netimpl_epoll;
+
+namespace {
+
+    /**
+     * A listening loopback socket that accepts a single connection
+     */
+    struct loopback_listener {
+        loopback_listener() {
+            listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addr_len   = sizeof(addr);
+            ::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(listen_fd, 1);
+            ::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+            port = ntohs(addr.sin_port);
+        }
+
+        ~loopback_listener() {
+            if (peer_fd >= 0) {
+                ::close(peer_fd);
+            }
+            ::close(listen_fd);
+        }
+
+        void accept() {
+            peer_fd = ::accept(listen_fd, nullptr, nullptr);
+        }
+
+        int listen_fd       = {-1};
+        int peer_fd         = {-1};
+        tdsl::uint16_t port = {0};
+    };
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, connect_refused) {
+    tdsl::uint16_t port = {0};
+    {
+        // Grab a free port and release it
+        loopback_listener l{};
+        port = l.port;
+    }
+    uut_t uut{};
+    auto r = uut.do_connect(tdsl::string_view{"127.0.0.1"}, port);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(r.error(), -3);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, connect_twice) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    auto r = uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(r.error(), -1);
+    ASSERT_EQ(0, uut.do_disconnect());
+    ASSERT_EQ(-1, uut.do_disconnect());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, sendv_recv) {
+    loopback_listener l{};
+    uut_t::socket_options opts{};
+    opts.rcvbuf_size = 65536;
+    opts.sndbuf_size = 65536;
+    uut_t uut{opts};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"localhost"}, l.port));
+    l.accept();
+
+    const tdsl::uint8_t a []      = {1, 2, 3};
+    const tdsl::uint8_t b []      = {4, 5};
+    const tdsl::byte_view bufs [] = {tdsl::byte_view{a}, tdsl::byte_view{}, tdsl::byte_view{b}};
+    ASSERT_EQ(0, uut.do_sendv(tdsl::span<const tdsl::byte_view>{bufs}));
+
+    tdsl::uint8_t rbuf [5] = {};
+    ASSERT_EQ(5, ::recv(l.peer_fd, rbuf, sizeof(rbuf), MSG_WAITALL));
+    const tdsl::uint8_t expected [] = {1, 2, 3, 4, 5};
+    ASSERT_EQ(0, memcmp(rbuf, expected, sizeof(expected)));
+
+    // Exact receive must wait for all of the bytes
+    ASSERT_EQ(2, ::send(l.peer_fd, expected, 2, 0));
+    ASSERT_EQ(3, ::send(l.peer_fd, expected + 2, 3, 0));
+    tdsl::uint8_t dst [5] = {};
+    auto rr               = uut.do_recv(5, tdsl::byte_span{dst});
+    ASSERT_TRUE(rr);
+    ASSERT_EQ(5, *rr);
+    ASSERT_EQ(0, memcmp(dst, expected, sizeof(expected)));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, recv_timeout) {
+    loopback_listener l{};
+    uut_t::socket_options opts{};
+    opts.io_timeout_ms = 10;
+    uut_t uut{opts};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+
+    tdsl::uint8_t dst [1] = {};
+    auto rr               = uut.do_recv_some(tdsl::byte_span{dst});
+    ASSERT_FALSE(rr);
+    ASSERT_EQ(-3, rr.error());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, recv_peer_closed) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+    ::close(l.peer_fd);
+    l.peer_fd = -1;
+
+    tdsl::uint8_t dst [1] = {};
+    auto rr               = uut.do_recv_some(tdsl::byte_span{dst});
+    ASSERT_FALSE(rr);
+    ASSERT_EQ(-1, rr.error());
+    // The socket is closed upon error
+    ASSERT_EQ(-1, uut.do_disconnect());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, reset_connection_status_bit) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+
+    const tdsl::uint8_t payload [] = {0xAA, 0xBB};
+    tdsl::uint8_t rbuf [10]        = {};
+    auto send_and_read_status      = [&](tdsl::detail::e_tds_message_type mtype) {
+        uut.do_write(tdsl::byte_view{payload});
+        uut.do_send_tds_pdu(mtype);
+        EXPECT_EQ(10, ::recv(l.peer_fd, rbuf, sizeof(rbuf), MSG_WAITALL));
+        return rbuf [1];
+    };
+
+    uut.set_reset_connection();
+    ASSERT_TRUE(uut.is_reset_connection_pending());
+    // Not a request; the reset stays pending
+    ASSERT_EQ(0x01, send_and_read_status(tdsl::detail::e_tds_message_type::login));
+    ASSERT_TRUE(uut.is_reset_connection_pending());
+    // EOM | RESETCONNECTION
+    ASSERT_EQ(0x09, send_and_read_status(tdsl::detail::e_tds_message_type::sql_batch));
+    ASSERT_FALSE(uut.is_reset_connection_pending());
+    // Only the next request is marked
+    ASSERT_EQ(0x01, send_and_read_status(tdsl::detail::e_tds_message_type::sql_batch));
+
+    uut.set_reset_connection(/*keep_transaction=*/true);
+    // EOM | RESETCONNECTIONSKIPTRAN
+    ASSERT_EQ(0x11, send_and_read_status(tdsl::detail::e_tds_message_type::rpc));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, receive_timeout_resumes) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+    uut.set_receive_timeout(20);
+
+    // TABULAR_RESULT, EOM, 10 bytes
+    const tdsl::uint8_t packet [] = {0x04, 0x01, 0x00, 0x0A, 0x00, 0x00, 0x01, 0x00, 0xAA, 0xBB};
+
+    // Nothing is sent
+    uut.do_receive_tds_pdu();
+    ASSERT_EQ(uut_t::e_receive_status::timed_out, uut.receive_status());
+    // The connection is still alive
+    ASSERT_EQ(4, ::send(l.peer_fd, packet, 4, 0));
+    uut.do_receive_tds_pdu();
+    ASSERT_EQ(uut_t::e_receive_status::timed_out, uut.receive_status());
+    // The receive is resumed with the rest of the packet
+    ASSERT_EQ(6, ::send(l.peer_fd, packet + 4, 6, 0));
+    ASSERT_EQ(1, uut.do_receive_tds_pdu());
+    ASSERT_EQ(uut_t::e_receive_status::complete, uut.receive_status());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_epoll, send_attention) {
+    loopback_listener l{};
+    uut_t uut{};
+    ASSERT_TRUE(uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port));
+    l.accept();
+
+    uut.send_attention();
+    tdsl::uint8_t rbuf [8] = {};
+    ASSERT_EQ(8, ::recv(l.peer_fd, rbuf, sizeof(rbuf), MSG_WAITALL));
+    // ATTENTION, EOM, header only
+    const tdsl::uint8_t expected [] = {0x06, 0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(0, memcmp(rbuf, expected, sizeof(expected)));
+}
@@ -0,0 +1,495 @@
+/**
+ * _________________________________________________
+ * Unit tests for the SMP (MARS) network layer
+ *
+ * @file   ut_netimpl_smp.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/smp/tdsl_netimpl_smp.hpp>
+#include <tdslite/detail/tdsl_driver.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <vector>
+
+namespace {
+
+    using bytes_t = std::vector<tdsl::uint8_t>;
+
+    /**
+     * A stand-in server that speaks PRELOGIN and SMP
+     */
+    struct fake_server {
+        struct smp_packet {
+            tdsl::net::smp_header header;
+            bytes_t payload;
+        };
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Queue a TDS tabular result packet carried in an SMP DATA packet
+         */
+        void send_data(tdsl::uint16_t sid, const bytes_t & tds_data, bool eom = true) {
+            auto & seq = server_seqnum [sid];
+            bytes_t tds{0x04, static_cast<tdsl::uint8_t>(eom ? 0x01 : 0x00), 0, 0, 0, 0, 1, 0};
+            tds.insert(tds.end(), tds_data.begin(), tds_data.end());
+            tds [2] = static_cast<tdsl::uint8_t>(tds.size() >> 8);
+            tds [3] = static_cast<tdsl::uint8_t>(tds.size());
+            send_smp(tdsl::net::smp_header::data, sid, ++seq, tds);
+        }
+
+        // --------------------------------------------------------------------------------
+
+        void send_smp(tdsl::uint8_t flags, tdsl::uint16_t sid, tdsl::uint32_t seqnum,
+                      const bytes_t & payload = {}) {
+            tdsl::net::smp_header h{};
+            h.flags  = flags;
+            h.sid    = sid;
+            h.length = static_cast<tdsl::uint32_t>(16 + payload.size());
+            h.seqnum = seqnum;
+            h.wndw   = window [sid];
+            tdsl::uint8_t hbuf [16];
+            h.encode(hbuf);
+            to_client.insert(to_client.end(), hbuf, hbuf + 16);
+            to_client.insert(to_client.end(), payload.begin(), payload.end());
+        }
+
+        // --------------------------------------------------------------------------------
+
+        /**
+         * Consume the complete packets sent by the client
+         */
+        void process() {
+            for (;;) {
+                if (not prelogin_done) {
+                    if (from_client.size() < 8) {
+                        return;
+                    }
+                    const tdsl::size_t len = (from_client [2] << 8) | from_client [3];
+                    if (from_client.size() < len) {
+                        return;
+                    }
+                    prelogin.assign(from_client.begin() + 8, from_client.begin() + len);
+                    from_client.erase(from_client.begin(), from_client.begin() + len);
+                    prelogin_done = true;
+                    // ENCRYPTION, MARS, TERMINATOR
+                    bytes_t rsp{0x04, 0x01, 0, 0, 0, 0, 1, 0, 0x01, 0x00, 0x0B, 0x00, 0x01,
+                                0x04, 0x00, 0x0C, 0x00, 0x01, 0xFF, encryption, mars};
+                    rsp [3] = static_cast<tdsl::uint8_t>(rsp.size());
+                    to_client.insert(to_client.end(), rsp.begin(), rsp.end());
+                    continue;
+                }
+
+                if (from_client.size() < 16) {
+                    return;
+                }
+                tdsl::uint8_t hbuf [16];
+                std::copy(from_client.begin(), from_client.begin() + 16, hbuf);
+                smp_packet p{};
+                EXPECT_TRUE(p.header.decode(hbuf));
+                if (from_client.size() < p.header.length) {
+                    return;
+                }
+                p.payload.assign(from_client.begin() + 16, from_client.begin() + p.header.length);
+                from_client.erase(from_client.begin(), from_client.begin() + p.header.length);
+                received.push_back(p);
+                if (on_packet) {
+                    on_packet(received.back());
+                }
+            }
+        }
+
+        tdsl::uint8_t mars       = {0x01};
+        tdsl::uint8_t encryption = {0x02};
+        bool prelogin_done       = {false};
+        // Maximum amount of bytes per read (to split the headers)
+        tdsl::size_t max_read    = {65536};
+        bytes_t prelogin;
+        bytes_t from_client;
+        bytes_t to_client;
+        std::vector<smp_packet> received;
+        std::function<void(const smp_packet &)> on_packet;
+        tdsl::uint32_t server_seqnum [16] = {};
+        tdsl::uint32_t window [16]        = {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+    };
+
+    /**
+     * Physical connection to the fake_server
+     */
+    struct fake_physical : public tdsl::net::network_io_base<fake_physical> {
+        explicit fake_physical(fake_server & s) : server(s) {
+            network_buffer = tdsl::tdsl_buffer_object{buf};
+        }
+
+        template <typename T>
+        auto do_connect(T, tdsl::uint16_t) -> tdsl::expected<tdsl::traits::true_type, int> {
+            return tdsl::traits::true_type{};
+        }
+
+        tdsl::int32_t do_disconnect() noexcept {
+            disconnects++;
+            return 0;
+        }
+
+        tdsl::int32_t do_sendv(tdsl::span<const tdsl::byte_view> bufs) noexcept {
+            for (const auto & b : bufs) {
+                server.from_client.insert(server.from_client.end(), b.begin(), b.end());
+            }
+            server.process();
+            return 0;
+        }
+
+        tdsl::int32_t do_send(tdsl::byte_view header, tdsl::byte_view message) noexcept {
+            const tdsl::byte_view bufs [] = {header, message};
+            return do_sendv(tdsl::span<const tdsl::byte_view>{bufs});
+        }
+
+        network_io_result do_recv_some(tdsl::byte_span dst) noexcept {
+            if (server.to_client.empty()) {
+                // Nothing will ever arrive
+                return tdsl::unexpected(-1);
+            }
+            tdsl::size_t n = server.to_client.size();
+            n              = n < dst.size_bytes() ? n : dst.size_bytes();
+            n              = n < server.max_read ? n : server.max_read;
+            std::copy(server.to_client.begin(), server.to_client.begin() + n, dst.data());
+            server.to_client.erase(server.to_client.begin(), server.to_client.begin() + n);
+            return n;
+        }
+
+        network_io_result do_recv(tdsl::uint32_t, tdsl::byte_span) noexcept {
+            return tdsl::unexpected(-1);
+        }
+
+        network_io_result do_recv(tdsl::uint32_t) noexcept {
+            return tdsl::unexpected(-1);
+        }
+
+        fake_server & server;
+        int disconnects          = {0};
+        tdsl::uint8_t buf [4096] = {};
+    };
+
+    using link_t    = tdsl::net::smp_link<fake_physical>;
+    using session_t = tdsl::net::tdsl_netimpl_smp<fake_physical>;
+    using tds_ctx_t = tdsl::detail::tds_context<session_t>;
+    using command_t = tdsl::detail::command_context<session_t>;
+
+    // COLMETADATA, one column: a INT NOT NULL
+    const bytes_t colmetadata_int{0x81, 0x01, 0x00, 0x00, 0x00, 0x00,
+                                  0x00, 0x38, 0x01, 0x61, 0x00};
+
+    bytes_t row_int(tdsl::int32_t v) {
+        return bytes_t{0xD1, static_cast<tdsl::uint8_t>(v), static_cast<tdsl::uint8_t>(v >> 8),
+                       static_cast<tdsl::uint8_t>(v >> 16), static_cast<tdsl::uint8_t>(v >> 24)};
+    }
+
+    bytes_t done(tdsl::uint32_t row_count) {
+        return bytes_t{0xFD,
+                       0x10,
+                       0x00,
+                       0xC1,
+                       0x00,
+                       static_cast<tdsl::uint8_t>(row_count),
+                       static_cast<tdsl::uint8_t>(row_count >> 8),
+                       0x00,
+                       0x00};
+    }
+
+    bytes_t operator+(bytes_t a, const bytes_t & b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+    }
+
+    struct smp_fixture : public ::testing::Test {
+        fake_server server{};
+        link_t link{server};
+    };
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, prelogin_enables_mars) {
+    ASSERT_TRUE(link.connect(tdsl::string_view{"localhost"}, 1433));
+    ASSERT_TRUE(link.is_connected());
+    ASSERT_EQ(39, server.prelogin.size());
+    // ENCRYPT_NOT_SUP
+    ASSERT_EQ(0x02, server.prelogin [32]);
+    // MARS on
+    ASSERT_EQ(0x01, server.prelogin [38]);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, prelogin_mars_refused) {
+    server.mars = 0x00;
+    auto r      = link.connect(tdsl::string_view{"localhost"}, 1433);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(-3, r.error());
+    ASSERT_FALSE(link.is_connected());
+    ASSERT_EQ(1, link.physical().disconnects);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, prelogin_encryption_required) {
+    // ENCRYPT_REQ
+    server.encryption = 0x03;
+    auto r            = link.connect(tdsl::string_view{"localhost"}, 1433);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(-3, r.error());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, sessions_syn_data_fin) {
+    session_t s0{link}, s1{link};
+    ASSERT_TRUE(s0.do_connect(tdsl::string_view{"localhost"}, 1433));
+    ASSERT_TRUE(s1.do_connect(tdsl::string_view{"localhost"}, 1433));
+    ASSERT_EQ(2, link.session_count());
+    ASSERT_EQ(0, s0.session_id());
+    ASSERT_EQ(1, s1.session_id());
+    // Only the sessions after the first one share the login
+    ASSERT_FALSE(s0.joins_existing_login());
+    ASSERT_TRUE(s1.joins_existing_login());
+
+    ASSERT_EQ(2, server.received.size());
+    for (tdsl::uint16_t sid = 0; sid < 2; sid++) {
+        const auto & h = server.received [sid].header;
+        ASSERT_EQ(tdsl::net::smp_header::syn, h.flags);
+        ASSERT_EQ(sid, h.sid);
+        ASSERT_EQ(16, h.length);
+        ASSERT_EQ(0, h.seqnum);
+        ASSERT_EQ(4, h.wndw);
+    }
+
+    const tdsl::uint8_t payload [] = {0xAA, 0xBB};
+    s1.do_write(tdsl::byte_view{payload});
+    s1.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+    ASSERT_EQ(3, server.received.size());
+    const auto & d = server.received [2];
+    ASSERT_EQ(tdsl::net::smp_header::data, d.header.flags);
+    ASSERT_EQ(1, d.header.sid);
+    ASSERT_EQ(1, d.header.seqnum);
+    ASSERT_EQ(16 + 10, d.header.length);
+    ASSERT_EQ(10, d.payload.size());
+    ASSERT_EQ(0x01, d.payload [0]);
+    ASSERT_EQ(0xAA, d.payload [8]);
+
+    ASSERT_EQ(0, s1.do_disconnect());
+    ASSERT_EQ(tdsl::net::smp_header::fin, server.received.back().header.flags);
+    ASSERT_EQ(1, server.received.back().header.sid);
+    ASSERT_EQ(1, server.received.back().header.seqnum);
+    ASSERT_EQ(1, link.session_count());
+
+    // SID 1 is not reused until the server's FIN arrives
+    session_t s2{link};
+    ASSERT_TRUE(s2.do_connect(tdsl::string_view{"localhost"}, 1433));
+    ASSERT_EQ(2, s2.session_id());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, send_waits_for_window) {
+    session_t s0{link};
+    ASSERT_TRUE(s0.do_connect(tdsl::string_view{"localhost"}, 1433));
+    s0.set_tds_packet_size(512);
+
+    // The server opens the window when the fourth packet arrives
+    server.on_packet = [this](const fake_server::smp_packet & p) {
+        if (p.header.seqnum == 4) {
+            server.window [0] = 8;
+            server.send_smp(tdsl::net::smp_header::ack, 0, 0);
+        }
+    };
+
+    // 6 TDS packets
+    bytes_t payload(504 * 6, 0x5A);
+    s0.do_write(tdsl::byte_view{payload.data(), payload.size()});
+    s0.do_send_tds_pdu(tdsl::detail::e_tds_message_type::sql_batch);
+
+    // SYN + 6 DATA
+    ASSERT_EQ(7, server.received.size());
+    for (tdsl::uint32_t i = 1; i < 7; i++) {
+        ASSERT_EQ(tdsl::net::smp_header::data, server.received [i].header.flags);
+        ASSERT_EQ(i, server.received [i].header.seqnum);
+        ASSERT_EQ(512, server.received [i].payload.size());
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, receive_acknowledges_consumed_packets) {
+    session_t s0{link};
+    ASSERT_TRUE(s0.do_connect(tdsl::string_view{"localhost"}, 1433));
+    // Split the SMP headers between the reads
+    server.max_read = 5;
+
+    server.send_data(0, bytes_t{0x01, 0x02}, false);
+    server.send_data(0, bytes_t{0x03, 0x04}, false);
+    server.send_data(0, bytes_t{0x05, 0x06}, true);
+
+    bytes_t rx;
+    for (int i = 0; i < 3; i++) {
+        tdsl::uint8_t tds [10] = {};
+        ASSERT_EQ(10, s0.do_recv(10, tdsl::byte_span{tds}).get());
+        rx.insert(rx.end(), tds + 8, tds + 10);
+    }
+    ASSERT_EQ((bytes_t{1, 2, 3, 4, 5, 6}), rx);
+
+    // The window is advanced by two packets at a time
+    ASSERT_EQ(2, server.received.size());
+    const auto & ack = server.received [1].header;
+    ASSERT_EQ(tdsl::net::smp_header::ack, ack.flags);
+    ASSERT_EQ(6, ack.wndw);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, peer_fin_closes_session) {
+    session_t s0{link};
+    ASSERT_TRUE(s0.do_connect(tdsl::string_view{"localhost"}, 1433));
+    server.send_smp(tdsl::net::smp_header::fin, 0, 0);
+    tdsl::uint8_t dst [4] = {};
+    ASSERT_FALSE(s0.do_recv_some(tdsl::byte_span{dst}));
+    // The link stays up
+    ASSERT_TRUE(link.is_connected());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, interleaved_commands) {
+    tds_ctx_t a{link}, b{link};
+    ASSERT_TRUE(a.do_connect(tdsl::string_view{"localhost"}, 1433));
+    ASSERT_TRUE(b.do_connect(tdsl::string_view{"localhost"}, 1433));
+
+    // The first packet of A's result arrives right away. The rest of it
+    // arrives after B's command is sent, before B's result.
+    server.on_packet = [this](const fake_server::smp_packet & p) {
+        if (not(p.header.flags == tdsl::net::smp_header::data)) {
+            return;
+        }
+        if (p.header.sid == 0) {
+            server.send_data(0, colmetadata_int + row_int(1), false);
+        }
+        else {
+            server.send_data(0, row_int(2) + done(2), true);
+            server.send_data(1, colmetadata_int + row_int(42) + done(1), true);
+        }
+    };
+
+    struct ctx_t {
+        tds_ctx_t * b;
+        std::vector<tdsl::int32_t> a_rows;
+        std::vector<tdsl::int32_t> b_rows;
+        tdsl::uint64_t b_affected;
+    } ctx{&b, {}, {}, 0};
+
+    command_t cmd_a{a};
+    auto ra = cmd_a.execute_query(
+        tdsl::string_view{"SELECT a FROM x"},
+        +[](void * uptr, const tdsl::tds_colmetadata_token &, const tdsl::tdsl_row & row) {
+            auto & c = *static_cast<ctx_t *>(uptr);
+            c.a_rows.push_back(row [0].as<tdsl::int32_t>());
+            if (c.a_rows.size() == 1) {
+                // Execute a command on B while A's result is being read
+                command_t cmd_b{*c.b};
+                auto rb = cmd_b.execute_query(
+                    tdsl::string_view{"SELECT 42"},
+                    +[](void * uptr, const tdsl::tds_colmetadata_token &,
+                        const tdsl::tdsl_row & row) {
+                        static_cast<ctx_t *>(uptr)->b_rows.push_back(
+                            row [0].as<tdsl::int32_t>());
+                    },
+                    uptr);
+                c.b_affected = rb.affected_rows;
+            }
+        },
+        &ctx);
+
+    ASSERT_EQ(2, ra.affected_rows);
+    ASSERT_EQ((std::vector<tdsl::int32_t>{1, 2}), ctx.a_rows);
+    ASSERT_EQ((std::vector<tdsl::int32_t>{42}), ctx.b_rows);
+    ASSERT_EQ(1, ctx.b_affected);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, driver_second_session_skips_login) {
+    using driver_t = tdsl::detail::tdsl_driver<session_t>;
+
+    // LOGINACK + DONE in response to the LOGIN7
+    server.on_packet = [this](const fake_server::smp_packet & p) {
+        if (p.header.flags == tdsl::net::smp_header::data && p.payload [0] == 0x10) {
+            const bytes_t loginack{0xAD, 0x0A, 0x00, 0x01, 0x71, 0x00, 0x00,
+                                   0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+            server.send_data(p.header.sid, loginack + done(0));
+        }
+    };
+
+    driver_t::connection_parameters params{};
+    params.server_name = "localhost";
+    params.user_name   = "sa";
+    params.password    = "pw";
+
+    driver_t d1{link}, d2{link};
+    ASSERT_EQ(driver_t::e_driver_error_code::success, d1.connect(params));
+    const auto packets_after_login = server.received.size();
+    ASSERT_EQ(driver_t::e_driver_error_code::success, d2.connect(params));
+    // SYN only
+    ASSERT_EQ(packets_after_login + 1, server.received.size());
+    ASSERT_EQ(tdsl::net::smp_header::syn, server.received.back().header.flags);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(smp_fixture, driver_second_session_inherits_tds_version) {
+    using driver_t = tdsl::detail::tdsl_driver<session_t>;
+
+    // LOGINACK (TDS 7.4) + DONE in response to the LOGIN7, DONE to the SQL batches
+    std::vector<bytes_t> batches{};
+    server.on_packet = [this, &batches](const fake_server::smp_packet & p) {
+        if (not(p.header.flags == tdsl::net::smp_header::data)) {
+            return;
+        }
+        // DONE with the 64-bit row count of TDS 7.2+
+        const bytes_t done_wide{0xFD, 0x00, 0x00, 0xC1, 0x00, 0x00, 0x00,
+                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        switch (p.payload [0]) {
+            case 0x10: {
+                const bytes_t loginack{0xAD, 0x0A, 0x00, 0x01, 0x74, 0x00, 0x00,
+                                       0x04, 0x00, 0x00, 0x00, 0x00, 0x00};
+                server.send_data(p.header.sid, loginack + done_wide);
+            } break;
+            case 0x01:
+                batches.push_back(p.payload);
+                server.send_data(p.header.sid, done_wide);
+                break;
+        }
+    };
+
+    driver_t::connection_parameters params{};
+    params.server_name = "localhost";
+    params.user_name   = "sa";
+    params.password    = "pw";
+
+    driver_t d1{link}, d2{link};
+    ASSERT_EQ(driver_t::e_driver_error_code::success, d1.connect(params));
+    ASSERT_EQ(driver_t::e_driver_error_code::success, d2.connect(params));
+    d2.execute_query(tdsl::string_view{"SELECT 1"});
+
+    // The batch of the second session starts with ALL_HEADERS (TDS 7.2+),
+    // total length 22, one transaction descriptor header of 18 bytes
+    ASSERT_EQ(1, batches.size());
+    ASSERT_LE(8 + 22, batches [0].size());
+    ASSERT_THAT(bytes_t(batches [0].begin() + 8, batches [0].begin() + 18),
+                testing::ElementsAre(0x16, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x02, 0x00));
+}
@@ -0,0 +1,190 @@
+/**
+ * _________________________________________________
+ * Unit tests for the io_uring network implementation
+ *
+ * @file   ut_netimpl_uring.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite-net/uring/tdsl_netimpl_uring.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+using uut_t = tdsl::net::tdsl_netimpl_uring;
+
+namespace {
+
+    /**
+     * A listening loopback socket that accepts a single connection
+     */
+    struct loopback_listener {
+        loopback_listener() {
+            listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addr_len   = sizeof(addr);
+            ::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(listen_fd, 1);
+            ::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+            port = ntohs(addr.sin_port);
+        }
+
+        ~loopback_listener() {
+            if (peer_fd >= 0) {
+                ::close(peer_fd);
+            }
+            ::close(listen_fd);
+        }
+
+        void accept() {
+            peer_fd = ::accept(listen_fd, nullptr, nullptr);
+        }
+
+        int listen_fd       = {-1};
+        int peer_fd         = {-1};
+        tdsl::uint16_t port = {0};
+    };
+
+    /**
+     * Connect @p uut to @p l, skipping the test when io_uring
+     * is not available (e.g. disabled by seccomp)
+     */
+#define CONNECT_OR_SKIP(uut, l)                                                                    \
+    do {                                                                                           \
+        auto cr = uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port);                          \
+        if (not cr && cr.error() == -4) {                                                          \
+            GTEST_SKIP() << "io_uring is not available";                                           \
+        }                                                                                          \
+        ASSERT_TRUE(cr);                                                                           \
+        l.accept();                                                                                \
+    } while (0)
+
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_uring, connect_twice) {
+    loopback_listener l{};
+    uut_t uut{};
+    CONNECT_OR_SKIP(uut, l);
+    auto r = uut.do_connect(tdsl::string_view{"127.0.0.1"}, l.port);
+    ASSERT_FALSE(r);
+    ASSERT_EQ(r.error(), -1);
+    ASSERT_EQ(0, uut.do_disconnect());
+    ASSERT_EQ(-1, uut.do_disconnect());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_uring, sendv_recv) {
+    loopback_listener l{};
+    uut_t uut{};
+    CONNECT_OR_SKIP(uut, l);
+
+    const tdsl::uint8_t a []      = {1, 2, 3};
+    const tdsl::uint8_t b []      = {4, 5};
+    const tdsl::byte_view bufs [] = {tdsl::byte_view{a}, tdsl::byte_view{}, tdsl::byte_view{b}};
+    ASSERT_EQ(0, uut.do_sendv(tdsl::span<const tdsl::byte_view>{bufs}));
+
+    tdsl::uint8_t rbuf [5] = {};
+    ASSERT_EQ(5, ::recv(l.peer_fd, rbuf, sizeof(rbuf), MSG_WAITALL));
+    const tdsl::uint8_t expected [] = {1, 2, 3, 4, 5};
+    ASSERT_EQ(0, memcmp(rbuf, expected, sizeof(expected)));
+
+    // Exact receive must wait for all of the bytes
+    ASSERT_EQ(2, ::send(l.peer_fd, expected, 2, 0));
+    ASSERT_EQ(3, ::send(l.peer_fd, expected + 2, 3, 0));
+    tdsl::uint8_t dst [5] = {};
+    auto rr               = uut.do_recv(5, tdsl::byte_span{dst});
+    ASSERT_TRUE(rr);
+    ASSERT_EQ(5, *rr);
+    ASSERT_EQ(0, memcmp(dst, expected, sizeof(expected)));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_uring, recv_large_in_small_pieces) {
+    loopback_listener l{};
+    uut_t uut{};
+    CONNECT_OR_SKIP(uut, l);
+
+    // More than the provided buffers can hold at once
+    std::vector<tdsl::uint8_t> data(512 * 1024);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data [i] = static_cast<tdsl::uint8_t>(i * 7);
+    }
+
+    std::vector<tdsl::uint8_t> received(data.size());
+    std::size_t sent = {0}, read = {0};
+    while (read < data.size()) {
+        if (sent < data.size()) {
+            const auto r = ::send(l.peer_fd, data.data() + sent, data.size() - sent, MSG_DONTWAIT);
+            if (r > 0) {
+                sent += static_cast<std::size_t>(r);
+            }
+        }
+        const auto chunk = std::min<std::size_t>(1000, sent - read);
+        if (chunk == 0) {
+            continue;
+        }
+        auto rr = uut.do_recv(static_cast<tdsl::uint32_t>(chunk),
+                              tdsl::byte_span{received.data() + read, chunk});
+        ASSERT_TRUE(rr);
+        ASSERT_EQ(chunk, *rr);
+        read += chunk;
+    }
+    ASSERT_EQ(data, received);
+
+    // The connection must still be usable in both ways
+    const tdsl::uint8_t ping [] = {0xAA};
+    ASSERT_EQ(0, uut.do_send(tdsl::byte_view{}, tdsl::byte_view{ping}));
+    tdsl::uint8_t pong [1] = {};
+    ASSERT_EQ(1, ::recv(l.peer_fd, pong, 1, MSG_WAITALL));
+    ASSERT_EQ(0xAA, pong [0]);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_uring, recv_into_network_buffer) {
+    loopback_listener l{};
+    uut_t uut{};
+    CONNECT_OR_SKIP(uut, l);
+
+    const tdsl::uint8_t data [] = {9, 8, 7, 6};
+    ASSERT_EQ(4, ::send(l.peer_fd, data, sizeof(data), 0));
+    auto rr = uut.do_recv(4);
+    ASSERT_TRUE(rr);
+    ASSERT_EQ(4, *rr);
+    ASSERT_GT(uut.enter_count(), 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(netimpl_uring, recv_peer_closed) {
+    loopback_listener l{};
+    uut_t uut{};
+    CONNECT_OR_SKIP(uut, l);
+    ::close(l.peer_fd);
+    l.peer_fd = -1;
+
+    tdsl::uint8_t dst [1] = {};
+    auto rr               = uut.do_recv_some(tdsl::byte_span{dst});
+    ASSERT_FALSE(rr);
+    ASSERT_EQ(-1, rr.error());
+    // The socket is closed upon error
+    ASSERT_EQ(-1, uut.do_disconnect());
+    ASSERT_EQ(uut_t::e_recv_mode::plain, uut.recv_mode());
+}
@@ -10,6 +10,10 @@
  * ____________________________________________________
  */
 
+// Allocation statistics are used to verify that
+// row delivery does not allocate memory
+#define TDSL_ALLOCATION_STATS_ENABLED 1
+
 #include <tdslite/detail/tdsl_command_context.hpp>
 #include <tdslite/util/tdsl_hex_dump.hpp>
 
@@ -19,6 +23,8 @@
 #include <vector>
 #include <cstring>
 #include <array>
+#include <memory>
+#include <algorithm>
 
 namespace {
 
@@ -50,18 +56,53 @@ namespace {
 
         inline void do_send(void) noexcept {}
 
-        inline void do_send_tds_pdu(tdsl::detail::e_tds_message_type) noexcept {}
+        inline void do_send_tds_pdu(tdsl::detail::e_tds_message_type) noexcept {
+            if (ignore_message) {
+                ignored_message_count++;
+                ignore_message = {false};
+            }
+        }
+
+        inline void set_ignore_message() noexcept {
+            ignore_message = {true};
+        }
+
+        inline void do_flush_tds_pdu(tdsl::detail::e_tds_message_type) noexcept {
+            flushed_buffer.insert(flushed_buffer.end(), send_buffer.begin(), send_buffer.end());
+            send_buffer.clear();
+            flush_count++;
+        }
+
+        inline tdsl::size_t do_get_free_space() noexcept {
+            return send_buffer.size() < send_buffer_capacity
+                       ? send_buffer_capacity - send_buffer.size()
+                       : 0;
+        }
 
         inline void do_receive_tds_pdu() {}
 
         inline void set_tds_packet_size(tdsl::uint16_t) {}
 
-        void register_packet_data_callback(
-            tdsl::uint32_t (*)(void *, tdsl::detail::e_tds_message_type,
-                               tdsl::binary_reader<tdsl::endian::little> &),
-            void *) {}
+        using packet_data_cb_t = tdsl::uint32_t (*)(void *, tdsl::detail::e_tds_message_type,
+                                                    tdsl::binary_reader<tdsl::endian::little> &);
+
+        void register_packet_data_callback(packet_data_cb_t cb, void * uptr) {
+            packet_data_cb      = cb;
+            packet_data_cb_uptr = uptr;
+        }
 
         std::vector<uint8_t> send_buffer;
+        packet_data_cb_t packet_data_cb = {nullptr};
+        void * packet_data_cb_uptr      = {nullptr};
+
+        // The bytes sent by do_flush_tds_pdu()
+        std::vector<uint8_t> flushed_buffer;
+        tdsl::size_t flush_count           = {0};
+        tdsl::size_t send_buffer_capacity  = {4096};
+
+        // Amount of messages sent with the IGNORE bit
+        tdsl::size_t ignored_message_count = {0};
+        bool ignore_message                = {false};
     };
 } // namespace
 
@@ -80,13 +121,152 @@ struct tdsl_command_ctx_ut_fixture : public ::testing::Test {
         tdsl::util::hexdump(tds_ctx.send_buffer.data(), tds_ctx.send_buffer.size());
     }
 
+    /**
+     * Feed @p data to command context's token handler as token @p token_type
+     *
+     * @param [in] token_type Token type
+     * @param [in] data Token data (excluding the token type)
+     *
+     * @return Token handler result
+     */
+    template <typename T>
+    tdsl::token_handler_result feed(tdsl::detail::e_tds_message_token_type token_type,
+                                    const T & data) {
+        tdsl::binary_reader<tdsl::endian::little> rr{
+            tdsl::byte_view{data.data(), static_cast<tdsl::size_t>(data.size())}};
+        auto result = uut_t::token_handler(&command_ctx, token_type, rr);
+        consumed    = rr.offset();
+        return result;
+    }
+
+    /**
+     * Feed @p msg to the TDS context as a tabular result message
+     *
+     * @param [in] msg Message data (tokens)
+     */
+    template <typename T>
+    void feed_message(const T & msg) {
+        tdsl::binary_reader<tdsl::endian::little> rr{
+            tdsl::byte_view{msg.data(), static_cast<tdsl::size_t>(msg.size())}};
+        tds_ctx.packet_data_cb(tds_ctx.packet_data_cb_uptr,
+                               tdsl::detail::e_tds_message_type::tabular_result, rr);
+    }
+
+    /**
+     * Feed @p msg to the TDS context as a tabular result message,
+     * @p piece_size bytes at a time. Mimics the network buffer: the
+     * consumed bytes are discarded, the rest is kept for the next piece.
+     *
+     * @param [in] msg Message data (tokens)
+     * @param [in] piece_size Amount of bytes that arrive at a time
+     *
+     * @return The largest amount of bytes kept in the buffer
+     */
+    template <typename T>
+    tdsl::size_t feed_message_in_pieces(const T & msg, tdsl::size_t piece_size) {
+        std::vector<tdsl::uint8_t> buffer;
+        tdsl::size_t high_watermark = {0};
+        for (tdsl::size_t pos = 0; pos < msg.size(); pos += piece_size) {
+            const auto end = std::min<tdsl::size_t>(pos + piece_size, msg.size());
+            buffer.insert(buffer.end(), msg.begin() + pos, msg.begin() + end);
+            high_watermark = std::max(high_watermark, buffer.size());
+            tdsl::binary_reader<tdsl::endian::little> rr{
+                tdsl::byte_view{buffer.data(), static_cast<tdsl::size_t>(buffer.size())}};
+            tds_ctx.packet_data_cb(tds_ctx.packet_data_cb_uptr,
+                                   tdsl::detail::e_tds_message_type::tabular_result, rr);
+            buffer.erase(buffer.begin(), buffer.begin() + rr.offset());
+        }
+        EXPECT_TRUE(buffer.empty());
+        return high_watermark;
+    }
+
+    /**
+     * Mimic a LOGINACK token that acknowledges TDS 7.4
+     */
+    void negotiate_tds74() {
+        constexpr std::array<tdsl::uint8_t, 13> loginack{
+            // LOGINACK, length (10)
+            0xAD, 0x0A, 0x00,
+            // interface, TDS version (7.4)
+            0x01, 0x74, 0x00, 0x00, 0x04,
+            // program name (empty), program version
+            0x00, 0x10, 0x00, 0x00, 0x00};
+        feed_message(loginack);
+        ASSERT_EQ(tds_ctx.negotiated_tds_version(), tdsl::detail::e_tds_version::sql_server_2012);
+    }
+
     tds_ctx_t tds_ctx;
 
     uut_t command_ctx{tds_ctx};
+
+    tdsl::size_t consumed = {0};
 };
 
 // --------------------------------------------------------------------------------
 
+namespace {
+
+    // COLMETADATA for two columns:
+    // a INT NOT NULL, b INT NULL
+    constexpr std::array<tdsl::uint8_t, 19> colmetadata_int_intn{
+        // column count
+        0x02, 0x00,
+        // user type, flags, type (INT4TYPE), column name (a)
+        0x00, 0x00, 0x00, 0x00, 0x38, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (b)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x62, 0x00};
+
+    struct row_collector {
+        std::vector<std::pair<tdsl::int32_t, tdsl::int32_t>> rows;
+        std::vector<const tdsl::tdsl_field *> field_addresses;
+        // User types of the two columns, as of the last row
+        std::pair<tdsl::uint32_t, tdsl::uint32_t> user_types;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token & colmd,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<row_collector *>(uptr);
+            self.rows.emplace_back(row [0].as<tdsl::int32_t>(),
+                                   row [1].is_null() ? -1 : row [1].as<tdsl::int32_t>());
+            self.field_addresses.push_back(&row [0]);
+            self.user_types = {colmd.columns [0].user_type, colmd.columns [1].user_type};
+        }
+    };
+
+    /**
+     * Collects the rows of INT columns, NULL fields as -1
+     */
+    struct int_row_collector {
+        std::vector<std::vector<tdsl::int32_t>> rows;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token &,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<int_row_collector *>(uptr);
+            std::vector<tdsl::int32_t> values;
+            for (const auto & field : row) {
+                values.push_back(field.is_null() ? -1 : field.as<tdsl::int32_t>());
+            }
+            self.rows.push_back(values);
+        }
+    };
+
+    std::vector<tdsl::uint8_t> make_int_intn_row(tdsl::int32_t a, tdsl::int32_t b, bool b_null) {
+        std::vector<tdsl::uint8_t> row;
+        auto put = [&row](tdsl::int32_t v) {
+            for (int i = 0; i < 4; i++) {
+                row.push_back(static_cast<tdsl::uint8_t>(v >> (i * 8)));
+            }
+        };
+        put(a);
+        row.push_back(b_null ? 0x00 : 0x04);
+        if (not b_null) {
+            put(b);
+        }
+        return row;
+    }
+} // namespace
+
+// --------------------------------------------------------------------------------
+
 TEST_F(tdsl_command_ctx_ut_fixture, test_01) {
     command_ctx.execute_query(tdsl::string_view{"SELECT * FROM FOO;"});
 
@@ -186,4 +366,1254 @@ TEST_F(tdsl_command_ctx_ut_fixture, test_rpc) {
     EXPECT_THAT(tds_ctx.send_buffer, testing::ElementsAreArray(expected_packet_bytes));
     // Expected
     tdsl::util::hexdump(expected_packet_bytes.data(), expected_packet_bytes.size());
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, row_storage_is_reused) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &row_collector::callback,
+                              &rc);
+
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata_int_intn).status,
+              tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, colmetadata_int_intn.size());
+
+    constexpr int k_row_count                 = 1000;
+    tdsl::tdslite_allocation_stats() = {};
+    for (int i = 0; i < k_row_count; i++) {
+        const auto row = make_int_intn_row(i, i * 2, (i % 3) == 0);
+        ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+        ASSERT_EQ(consumed, row.size());
+    }
+
+    // Steady-state row delivery must not allocate
+    EXPECT_EQ(tdsl::tdslite_allocation_stats().malloc_calls, 0);
+    EXPECT_EQ(tdsl::tdslite_allocation_stats().free_calls, 0);
+
+    ASSERT_EQ(rc.rows.size(), k_row_count);
+    for (int i = 0; i < k_row_count; i++) {
+        EXPECT_EQ(rc.rows [i].first, i);
+        EXPECT_EQ(rc.rows [i].second, (i % 3) == 0 ? -1 : i * 2);
+        // Every row is delivered through the same field storage
+        EXPECT_EQ(rc.field_addresses [i], rc.field_addresses [0]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, row_invalid_field_length) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &row_collector::callback,
+                              &rc);
+
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata_int_intn).status,
+              tdsl::token_handler_status::success);
+
+    // INTNTYPE field with length 3
+    constexpr std::array<tdsl::uint8_t, 8> row{0x01, 0x00, 0x00, 0x00, 0x03, 0x01, 0x02, 0x03};
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::invalid_field_length);
+    ASSERT_TRUE(rc.rows.empty());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, fixed_width_rows) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+
+    // COLMETADATA for three columns:
+    // a INT NOT NULL, b BIGINT NOT NULL, c BIT NOT NULL
+    constexpr std::array<tdsl::uint8_t, 26> colmetadata{
+        // column count
+        0x03, 0x00,
+        // user type, flags, type (INT4TYPE), column name (a)
+        0x00, 0x00, 0x00, 0x00, 0x38, 0x01, 0x61, 0x00,
+        // user type, flags, type (INT8TYPE), column name (b)
+        0x00, 0x00, 0x00, 0x00, 0x7F, 0x01, 0x62, 0x00,
+        // user type, flags, type (BITTYPE), column name (c)
+        0x00, 0x00, 0x00, 0x00, 0x32, 0x01, 0x63, 0x00};
+
+    struct collector {
+        std::vector<std::tuple<tdsl::int32_t, tdsl::int64_t, tdsl::uint8_t>> rows;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token &,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<collector *>(uptr);
+            ASSERT_EQ(row.size(), 3);
+            ASSERT_EQ(row [0].size_bytes(), 4);
+            ASSERT_EQ(row [1].size_bytes(), 8);
+            ASSERT_EQ(row [2].size_bytes(), 1);
+            self.rows.emplace_back(row [0].as<tdsl::int32_t>(), row [1].as<tdsl::int64_t>(),
+                                   row [2].as<tdsl::uint8_t>());
+        }
+    } rc;
+
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b, c FROM FOO;"}, &collector::callback,
+                              &rc);
+
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+
+    constexpr std::array<tdsl::uint8_t, 13> row{0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+                                                0x00, 0x00, 0x00, 0x00, 0x80, 0x01};
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, row.size());
+    ASSERT_EQ(rc.rows.size(), 1);
+    EXPECT_EQ(std::get<0>(rc.rows [0]), 1);
+    EXPECT_EQ(std::get<1>(rc.rows [0]), static_cast<tdsl::int64_t>(0x8000000000000002));
+    EXPECT_EQ(std::get<2>(rc.rows [0]), 1);
+
+    // Partial row must fall back to the general path and report
+    // the exact amount of missing bytes.
+    const std::vector<tdsl::uint8_t> partial{row.begin(), row.begin() + 6};
+    const auto r = feed(e_tok::row, partial);
+    ASSERT_EQ(r.status, tdsl::token_handler_status::not_enough_bytes);
+    ASSERT_EQ(r.needed_bytes, 6);
+    ASSERT_EQ(rc.rows.size(), 1);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, row_parser_resumes) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+
+    // COLMETADATA for two columns:
+    // a INT NULL, b INT NULL
+    constexpr std::array<tdsl::uint8_t, 20> colmetadata{
+        // column count
+        0x02, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (a)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (b)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x62, 0x00};
+
+    row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &row_collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+
+    std::vector<tdsl::uint8_t> row{0x04, 0x0a, 0x00, 0x00, 0x00, 0x04, 0x0b, 0x00, 0x00, 0x00};
+
+    // First column and the length prefix of the second column
+    {
+        const std::vector<tdsl::uint8_t> partial{row.begin(), row.begin() + 7};
+        const auto r = feed(e_tok::row, partial);
+        ASSERT_EQ(r.status, tdsl::token_handler_status::not_enough_bytes);
+        ASSERT_EQ(r.needed_bytes, 3);
+        ASSERT_TRUE(rc.rows.empty());
+    }
+
+    // Deliver the complete row from a different memory location to simulate
+    // the data being moved in the receive buffer. The length prefix of the
+    // first column is altered to an invalid value, which must not matter
+    // since the first column is already decoded.
+    {
+        std::vector<tdsl::uint8_t> moved{row};
+        moved [0] = 0x03;
+        const auto r = feed(e_tok::row, moved);
+        ASSERT_EQ(r.status, tdsl::token_handler_status::success);
+        ASSERT_EQ(consumed, row.size());
+    }
+
+    ASSERT_EQ(rc.rows.size(), 1);
+    EXPECT_EQ(rc.rows [0].first, 0x0a);
+    EXPECT_EQ(rc.rows [0].second, 0x0b);
+
+    // The parser state must be reset after a complete row
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(rc.rows.size(), 2);
+    EXPECT_EQ(rc.rows [1].first, 0x0a);
+    EXPECT_EQ(rc.rows [1].second, 0x0b);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, all_headers_tds74) {
+    negotiate_tds74();
+    command_ctx.execute_query(tdsl::string_view{"SELECT 1"});
+
+    constexpr std::array<tdsl::uint8_t, 38> expected_packet_bytes{
+        // ALL_HEADERS total length (22)
+        0x16, 0x00, 0x00, 0x00,
+        // Header length (18), header type (transaction descriptor)
+        0x12, 0x00, 0x00, 0x00, 0x02, 0x00,
+        // Transaction descriptor, outstanding request count
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+        // SELECT 1
+        0x53, 0x00, 0x45, 0x00, 0x4c, 0x00, 0x45, 0x00, 0x43, 0x00, 0x54, 0x00, 0x20, 0x00,
+        0x31, 0x00};
+
+    ASSERT_THAT(tds_ctx.send_buffer, testing::ElementsAreArray(expected_packet_bytes));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, all_headers_transaction_descriptor) {
+    negotiate_tds74();
+
+    // ENVCHANGE (begin transaction) with descriptor 0x0102030405060708
+    constexpr std::array<tdsl::uint8_t, 14> envchange{
+        // ENVCHANGE, length (11), type (begin transaction)
+        0xE3, 0x0B, 0x00, 0x08,
+        // new value (8 bytes), old value (empty)
+        0x08, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00};
+    feed_message(envchange);
+    ASSERT_EQ(tds_ctx.current_transaction_descriptor(), 0x0102030405060708);
+
+    command_ctx.execute_query(tdsl::string_view{"SELECT 1"});
+    ASSERT_GT(tds_ctx.send_buffer.size(), 18);
+    const std::vector<tdsl::uint8_t> descriptor{tds_ctx.send_buffer.begin() + 10,
+                                                tds_ctx.send_buffer.begin() + 18};
+    EXPECT_THAT(descriptor,
+                testing::ElementsAre(0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, colmetadata_tds74) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    negotiate_tds74();
+
+    // COLMETADATA for two columns with 4-byte user types:
+    // a INT NOT NULL, b INT NULL
+    constexpr std::array<tdsl::uint8_t, 23> colmetadata{
+        // column count
+        0x02, 0x00,
+        // user type (0x00012345), flags, type (INT4TYPE), column name (a)
+        0x45, 0x23, 0x01, 0x00, 0x00, 0x00, 0x38, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (b)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x62, 0x00};
+
+    row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &row_collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, colmetadata.size());
+
+    const auto row = make_int_intn_row(1, 2, false);
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(rc.rows.size(), 1);
+    EXPECT_EQ(rc.rows [0].first, 1);
+    EXPECT_EQ(rc.rows [0].second, 2);
+    EXPECT_EQ(rc.user_types.first, 0x00012345);
+    EXPECT_EQ(rc.user_types.second, 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, done_tds74) {
+    negotiate_tds74();
+    command_ctx.execute_query(tdsl::string_view{"DELETE FROM FOO;"});
+
+    // DONE token with 8-byte row count
+    constexpr std::array<tdsl::uint8_t, 13> done{
+        // DONE, status (count valid), current command
+        0xFD, 0x10, 0x00, 0xC1, 0x00,
+        // row count
+        0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    feed_message(done);
+    EXPECT_EQ(command_ctx.result().affected_rows, 5);
+
+    // Row counts beyond 32 bits are clamped, not truncated
+    command_ctx.execute_query(tdsl::string_view{"DELETE FROM FOO;"});
+    constexpr std::array<tdsl::uint8_t, 13> done_large{
+        // DONE, status (count valid), current command
+        0xFD, 0x10, 0x00, 0xC1, 0x00,
+        // row count (0x100000005)
+        0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
+    feed_message(done_large);
+    EXPECT_EQ(command_ctx.result().affected_rows, 0xFFFFFFFF);
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+
+    // COLMETADATA for a single column:
+    // a NVARCHAR(MAX) NULL
+    constexpr std::array<tdsl::uint8_t, 19> colmetadata_nvarchar_max{
+        // column count
+        0x01, 0x00,
+        // user type, flags (nullable), type (NVARCHARTYPE), max length (0xFFFF)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xE7, 0xFF, 0xFF,
+        // collation
+        0x09, 0x04, 0xD0, 0x00, 0x34,
+        // column name (a)
+        0x01, 0x61, 0x00};
+
+    struct bytes_collector {
+        // Field bytes of the rows, nullptr for NULL fields
+        std::vector<std::unique_ptr<std::vector<tdsl::uint8_t>>> rows;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token &,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<bytes_collector *>(uptr);
+            if (row [0].is_null()) {
+                self.rows.emplace_back(nullptr);
+                return;
+            }
+            self.rows.emplace_back(
+                new std::vector<tdsl::uint8_t>{row [0].data(), row [0].data() + row [0].size()});
+        }
+    };
+} // namespace
+
+TEST_F(tdsl_command_ctx_ut_fixture, plp_rows) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    negotiate_tds74();
+
+    bytes_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a FROM FOO;"}, &bytes_collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata_nvarchar_max).status,
+              tdsl::token_handler_status::success);
+
+    // Single chunk
+    constexpr std::array<tdsl::uint8_t, 20> single_chunk{
+        // total length (4)
+        0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // chunk (4)
+        0x04, 0x00, 0x00, 0x00, 0x61, 0x00, 0x62, 0x00,
+        // terminator
+        0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::row, single_chunk).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, single_chunk.size());
+
+    // Multiple chunks, with unknown total length
+    constexpr std::array<tdsl::uint8_t, 26> multi_chunk{
+        // total length (unknown)
+        0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        // chunk (2)
+        0x02, 0x00, 0x00, 0x00, 0x61, 0x00,
+        // chunk (4)
+        0x04, 0x00, 0x00, 0x00, 0x62, 0x00, 0x63, 0x00,
+        // terminator
+        0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::row, multi_chunk).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, multi_chunk.size());
+
+    // Empty (no chunks)
+    constexpr std::array<tdsl::uint8_t, 12> empty{0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                                  0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::row, empty).status, tdsl::token_handler_status::success);
+
+    // NULL
+    constexpr std::array<tdsl::uint8_t, 8> null{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    ASSERT_EQ(feed(e_tok::row, null).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, null.size());
+
+    ASSERT_EQ(rc.rows.size(), 4);
+    ASSERT_TRUE(rc.rows [0]);
+    EXPECT_THAT(*rc.rows [0], testing::ElementsAre(0x61, 0x00, 0x62, 0x00));
+    ASSERT_TRUE(rc.rows [1]);
+    EXPECT_THAT(*rc.rows [1], testing::ElementsAre(0x61, 0x00, 0x62, 0x00, 0x63, 0x00));
+    ASSERT_TRUE(rc.rows [2]);
+    EXPECT_TRUE(rc.rows [2]->empty());
+    EXPECT_FALSE(rc.rows [3]);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, plp_row_resumes) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    negotiate_tds74();
+
+    bytes_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a FROM FOO;"}, &bytes_collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata_nvarchar_max).status,
+              tdsl::token_handler_status::success);
+
+    const std::vector<tdsl::uint8_t> row{// total length (6)
+                                         0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                         // chunk (2)
+                                         0x02, 0x00, 0x00, 0x00, 0x61, 0x00,
+                                         // chunk (4)
+                                         0x04, 0x00, 0x00, 0x00, 0x62, 0x00, 0x63, 0x00,
+                                         // terminator
+                                         0x00, 0x00, 0x00, 0x00};
+
+    // The second chunk is incomplete
+    const std::vector<tdsl::uint8_t> partial{row.begin(), row.begin() + 20};
+    const auto r = feed(e_tok::row, partial);
+    ASSERT_EQ(r.status, tdsl::token_handler_status::not_enough_bytes);
+    ASSERT_EQ(r.needed_bytes, 2);
+    ASSERT_TRUE(rc.rows.empty());
+
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(rc.rows.size(), 1);
+    ASSERT_TRUE(rc.rows [0]);
+    EXPECT_THAT(*rc.rows [0], testing::ElementsAre(0x61, 0x00, 0x62, 0x00, 0x63, 0x00));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, date_time_types) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+    negotiate_tds74();
+
+    // COLMETADATA for two columns:
+    // a DATE NULL, b DATETIME2(7) NULL
+    constexpr std::array<tdsl::uint8_t, 23> colmetadata{
+        // column count
+        0x02, 0x00,
+        // user type, flags (nullable), type (DATENTYPE), column name (a)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x28, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (DATETIME2NTYPE), scale (7), column name (b)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x2A, 0x07, 0x01, 0x62, 0x00};
+
+    struct collector {
+        std::vector<std::pair<std::vector<tdsl::uint8_t>, std::vector<tdsl::uint8_t>>> rows;
+        tdsl::uint8_t scale = {0};
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token & colmd,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<collector *>(uptr);
+            self.scale  = colmd.columns [1].typeprops.ps.scale;
+            self.rows.emplace_back(
+                std::vector<tdsl::uint8_t>{row [0].data(), row [0].data() + row [0].size()},
+                std::vector<tdsl::uint8_t>{row [1].data(), row [1].data() + row [1].size()});
+            if (row [1].is_null()) {
+                self.rows.back().second = {0xFF};
+            }
+        }
+    } rc;
+
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, colmetadata.size());
+
+    constexpr std::array<tdsl::uint8_t, 13> row{// DATE (3 bytes)
+                                                0x03, 0x01, 0x02, 0x03,
+                                                // DATETIME2(7) (8 bytes)
+                                                0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                                                0x07, 0x08};
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, row.size());
+
+    constexpr std::array<tdsl::uint8_t, 2> null_row{0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::row, null_row).status, tdsl::token_handler_status::success);
+
+    // Invalid length for DATE
+    constexpr std::array<tdsl::uint8_t, 6> invalid_row{0x04, 0x01, 0x02, 0x03, 0x04, 0x00};
+    ASSERT_EQ(feed(e_tok::row, invalid_row).status,
+              tdsl::token_handler_status::invalid_field_length);
+
+    ASSERT_EQ(rc.rows.size(), 2);
+    EXPECT_EQ(rc.scale, 7);
+    EXPECT_THAT(rc.rows [0].first, testing::ElementsAre(0x01, 0x02, 0x03));
+    EXPECT_THAT(rc.rows [0].second,
+                testing::ElementsAre(0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08));
+    EXPECT_TRUE(rc.rows [1].first.empty());
+    EXPECT_THAT(rc.rows [1].second, testing::ElementsAre(0xFF));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, nbcrow_rows) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+
+    row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b FROM FOO;"}, &row_collector::callback,
+                              &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata_int_intn).status,
+              tdsl::token_handler_status::success);
+
+    // null bitmap (b is NULL), a
+    constexpr std::array<tdsl::uint8_t, 5> b_null{0x02, 0x01, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::nbcrow, b_null).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, b_null.size());
+
+    // null bitmap (none), a, b
+    constexpr std::array<tdsl::uint8_t, 10> no_null{0x00, 0x02, 0x00, 0x00, 0x00,
+                                                    0x04, 0x03, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::nbcrow, no_null).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, no_null.size());
+
+    // ROW tokens must still be decoded as usual after an NBCROW token
+    const auto row = make_int_intn_row(4, 5, false);
+    ASSERT_EQ(feed(e_tok::row, row).status, tdsl::token_handler_status::success);
+
+    ASSERT_EQ(rc.rows.size(), 3);
+    EXPECT_EQ(rc.rows [0], std::make_pair(1, -1));
+    EXPECT_EQ(rc.rows [1], std::make_pair(2, 3));
+    EXPECT_EQ(rc.rows [2], std::make_pair(4, 5));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, nbcrow_wide) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+
+    // COLMETADATA for ten columns, all INT NULL
+    std::vector<tdsl::uint8_t> colmetadata{0x0A, 0x00};
+    for (tdsl::uint8_t i = 0; i < 10; i++) {
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name
+        const tdsl::uint8_t column [] = {0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01,
+                                         static_cast<tdsl::uint8_t>('a' + i), 0x00};
+        colmetadata.insert(colmetadata.end(), column, column + sizeof(column));
+    }
+
+    int_row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT * FROM FOO;"},
+                              &int_row_collector::callback, &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+
+    // Two bytes of null bitmap, only the first and the last columns are not NULL
+    constexpr std::array<tdsl::uint8_t, 12> sparse{0xFE, 0x01, 0x04, 0x07, 0x00, 0x00,
+                                                   0x00, 0x04, 0x09, 0x00, 0x00, 0x00};
+    ASSERT_EQ(feed(e_tok::nbcrow, sparse).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, sparse.size());
+
+    // All NULL, no column data at all
+    constexpr std::array<tdsl::uint8_t, 2> all_null{0xFF, 0x03};
+    ASSERT_EQ(feed(e_tok::nbcrow, all_null).status, tdsl::token_handler_status::success);
+    ASSERT_EQ(consumed, all_null.size());
+
+    ASSERT_EQ(rc.rows.size(), 2);
+    EXPECT_EQ(rc.rows [0], (std::vector<tdsl::int32_t>{7, -1, -1, -1, -1, -1, -1, -1, -1, 9}));
+    EXPECT_EQ(rc.rows [1], (std::vector<tdsl::int32_t>(10, -1)));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, nbcrow_parser_resumes) {
+    using e_tok = tdsl::detail::e_tds_message_token_type;
+
+    // COLMETADATA for three columns:
+    // a INT NULL, b INT NULL, c INT NULL
+    constexpr std::array<tdsl::uint8_t, 29> colmetadata{
+        // column count
+        0x03, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (a)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (b)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x62, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (c)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x63, 0x00};
+
+    int_row_collector rc;
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b, c FROM FOO;"},
+                              &int_row_collector::callback, &rc);
+    ASSERT_EQ(feed(e_tok::colmetadata, colmetadata).status, tdsl::token_handler_status::success);
+
+    // null bitmap (b is NULL), a, c
+    const std::vector<tdsl::uint8_t> row{0x02, 0x04, 0x0a, 0x00, 0x00,
+                                         0x00, 0x04, 0x0c, 0x00, 0x00, 0x00};
+
+    // Not even the null bitmap
+    {
+        const std::vector<tdsl::uint8_t> partial{};
+        const auto r = feed(e_tok::nbcrow, partial);
+        ASSERT_EQ(r.status, tdsl::token_handler_status::not_enough_bytes);
+        ASSERT_EQ(r.needed_bytes, 1);
+    }
+
+    // The null bitmap, first column and the length prefix of the third column
+    {
+        const std::vector<tdsl::uint8_t> partial{row.begin(), row.begin() + 7};
+        const auto r = feed(e_tok::nbcrow, partial);
+        ASSERT_EQ(r.status, tdsl::token_handler_status::not_enough_bytes);
+        ASSERT_EQ(r.needed_bytes, 4);
+        ASSERT_TRUE(rc.rows.empty());
+    }
+
+    // Deliver the complete row from a different memory location, the
+    // null bitmap must be read from the new location
+    {
+        const std::vector<tdsl::uint8_t> moved{row};
+        const auto r = feed(e_tok::nbcrow, moved);
+        ASSERT_EQ(r.status, tdsl::token_handler_status::success);
+        ASSERT_EQ(consumed, row.size());
+    }
+
+    ASSERT_EQ(rc.rows.size(), 1);
+    EXPECT_EQ(rc.rows [0], (std::vector<tdsl::int32_t>{0x0a, -1, 0x0c}));
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+
+    struct stream_collector {
+        // Streamed data of the fields, per column
+        std::vector<std::vector<tdsl::uint8_t>> fields;
+        // Amount of completed fields
+        int completed = {0};
+        // Amount of chunks received
+        int chunks    = {0};
+
+        static void sink(void * uptr, const tdsl::tds_colmetadata_token &, tdsl::uint32_t cidx,
+                         tdsl::byte_view chunk, bool last) {
+            auto & self = *static_cast<stream_collector *>(uptr);
+            if (self.fields.size() <= cidx) {
+                self.fields.resize(cidx + 1);
+            }
+            self.fields [cidx].insert(self.fields [cidx].end(), chunk.begin(), chunk.end());
+            self.chunks++;
+            if (last) {
+                ASSERT_TRUE(chunk.size_bytes() == 0);
+                self.completed++;
+            }
+        }
+    };
+
+    std::vector<tdsl::uint8_t> operator+(std::vector<tdsl::uint8_t> a,
+                                         const std::vector<tdsl::uint8_t> & b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+    }
+
+    void put_u32(std::vector<tdsl::uint8_t> & v, tdsl::uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            v.push_back(static_cast<tdsl::uint8_t>(value >> (i * 8)));
+        }
+    }
+} // namespace
+
+TEST_F(tdsl_command_ctx_ut_fixture, stream_image_field) {
+    // COLMETADATA for three columns:
+    // a INT NOT NULL, b IMAGE NULL, c INT NULL
+    const std::vector<tdsl::uint8_t> colmetadata{
+        // COLMETADATA, column count
+        0x81, 0x03, 0x00,
+        // user type, flags, type (INT4TYPE), column name (a)
+        0x00, 0x00, 0x00, 0x00, 0x38, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (IMAGETYPE), max length
+        0x00, 0x00, 0x01, 0x00, 0x22, 0xFF, 0xFF, 0xFF, 0x7F,
+        // table name (t), column name (b)
+        0x01, 0x00, 0x74, 0x00, 0x01, 0x62, 0x00,
+        // user type, flags (nullable), type (INTNTYPE), length (4), column name (c)
+        0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 0x63, 0x00};
+
+    std::vector<tdsl::uint8_t> image(1000);
+    for (tdsl::size_t i = 0; i < image.size(); i++) {
+        image [i] = static_cast<tdsl::uint8_t>(i * 7);
+    }
+
+    // ROW: a, textptr (16 bytes) & timestamp (8 bytes), b, c
+    std::vector<tdsl::uint8_t> row{0xD1, 0x2A, 0x00, 0x00, 0x00, 0x10};
+    row.insert(row.end(), 16 + 8, 0xEE);
+    put_u32(row, static_cast<tdsl::uint32_t>(image.size()));
+    row.insert(row.end(), image.begin(), image.end());
+    row.insert(row.end(), {0x04, 0x2B, 0x00, 0x00, 0x00});
+
+    struct collector {
+        std::vector<std::tuple<tdsl::int32_t, bool, tdsl::size_t, tdsl::int32_t>> rows;
+        const stream_collector * sc;
+        int completed_before_row;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token &,
+                             const tdsl::tdsl_row & row) {
+            auto & self                = *static_cast<collector *>(uptr);
+            self.completed_before_row = self.sc->completed;
+            self.rows.emplace_back(row [0].as<tdsl::int32_t>(), row [1].is_null(),
+                                   row [1].size_bytes(), row [2].as<tdsl::int32_t>());
+        }
+    };
+
+    stream_collector sc;
+    collector rc{{}, &sc, 0};
+    command_ctx.set_stream_sink(&stream_collector::sink, &sc);
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b, c FROM FOO;"}, &collector::callback,
+                              &rc);
+
+    // The whole row at once, then 7 bytes at a time
+    feed_message(colmetadata + row);
+    const auto high_watermark = feed_message_in_pieces(row + row, 7);
+
+    ASSERT_EQ(rc.rows.size(), 3);
+    for (const auto & r : rc.rows) {
+        EXPECT_EQ(std::get<0>(r), 0x2A);
+        EXPECT_FALSE(std::get<1>(r));
+        EXPECT_EQ(std::get<2>(r), 0);
+        EXPECT_EQ(std::get<3>(r), 0x2B);
+    }
+    EXPECT_EQ(rc.completed_before_row, 3);
+    ASSERT_EQ(sc.completed, 3);
+    ASSERT_EQ(sc.fields.size(), 2);
+    EXPECT_EQ(sc.fields [1], image + image + image);
+    // The image is not accumulated in the buffer
+    EXPECT_LT(high_watermark, 64);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, stream_plp_field) {
+    negotiate_tds74();
+
+    // NBCROW: null bitmap (none), total length, chunks & terminator
+    std::vector<tdsl::uint8_t> row{0xD2, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    put_u32(row, 4);
+    row.insert(row.end(), {'a', 0x00, 'b', 0x00});
+    put_u32(row, 6);
+    row.insert(row.end(), {'c', 0x00, 'd', 0x00, 'e', 0x00});
+    put_u32(row, 0);
+
+    // NBCROW: null bitmap (a is NULL)
+    const std::vector<tdsl::uint8_t> null_row{0xD2, 0x01};
+
+    stream_collector sc;
+    bytes_collector rc;
+    command_ctx.set_stream_sink(&stream_collector::sink, &sc);
+    command_ctx.execute_query(tdsl::string_view{"SELECT a FROM FOO;"}, &bytes_collector::callback,
+                              &rc);
+
+    std::vector<tdsl::uint8_t> colmetadata{0x81};
+    colmetadata.insert(colmetadata.end(), colmetadata_nvarchar_max.begin(),
+                       colmetadata_nvarchar_max.end());
+    feed_message(colmetadata);
+
+    // Split the chunk lengths too
+    feed_message_in_pieces(row + null_row + row, 3);
+
+    ASSERT_EQ(rc.rows.size(), 3);
+    ASSERT_TRUE(rc.rows [0]);
+    EXPECT_TRUE(rc.rows [0]->empty());
+    EXPECT_FALSE(rc.rows [1]);
+    ASSERT_TRUE(rc.rows [2]);
+    EXPECT_TRUE(rc.rows [2]->empty());
+    ASSERT_EQ(sc.completed, 2);
+    ASSERT_EQ(sc.fields.size(), 1);
+    const std::vector<tdsl::uint8_t> text{'a', 0, 'b', 0, 'c', 0, 'd', 0, 'e', 0};
+    EXPECT_EQ(sc.fields [0], text + text);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, stream_plp_field_after_datetime2) {
+    negotiate_tds74();
+
+    // COLMETADATA for three columns:
+    // a INT NOT NULL, b DATETIME2(7) NULL, c VARBINARY(MAX) NULL
+    const std::vector<tdsl::uint8_t> colmetadata{
+        // COLMETADATA, column count
+        0x81, 0x03, 0x00,
+        // user type, flags, type (INT4TYPE), column name (a)
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x01, 0x61, 0x00,
+        // user type, flags (nullable), type (DATETIME2NTYPE), scale (7), column name (b)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x2A, 0x07, 0x01, 0x62, 0x00,
+        // user type, flags (nullable), type (BIGVARBINTYPE), max length (0xFFFF), name (c)
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xA5, 0xFF, 0xFF, 0x01, 0x63, 0x00};
+
+    // ROW: a, b (8 bytes), c (total length, one chunk & terminator)
+    const std::vector<tdsl::uint8_t> datetime2{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    std::vector<tdsl::uint8_t> row{0xD1, 0x2A, 0x00, 0x00, 0x00, 0x08};
+    row.insert(row.end(), datetime2.begin(), datetime2.end());
+    row.insert(row.end(), {0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    put_u32(row, 4);
+    row.insert(row.end(), {'w', 'x', 'y', 'z'});
+    put_u32(row, 0);
+
+    struct collector {
+        std::vector<std::pair<tdsl::int32_t, std::vector<tdsl::uint8_t>>> rows;
+
+        static void callback(void * uptr, const tdsl::tds_colmetadata_token &,
+                             const tdsl::tdsl_row & row) {
+            auto & self = *static_cast<collector *>(uptr);
+            self.rows.emplace_back(
+                row [0].as<tdsl::int32_t>(),
+                std::vector<tdsl::uint8_t>{row [1].data(), row [1].data() + row [1].size()});
+        }
+    } rc;
+
+    stream_collector sc;
+    command_ctx.set_stream_sink(&stream_collector::sink, &sc);
+    command_ctx.execute_query(tdsl::string_view{"SELECT a, b, c FROM FOO;"},
+                              &collector::callback, &rc);
+    feed_message(colmetadata);
+
+    // The fields before the streamed one are spilled while the row is incomplete
+    feed_message_in_pieces(row + row, 5);
+
+    ASSERT_EQ(rc.rows.size(), 2);
+    for (const auto & r : rc.rows) {
+        EXPECT_EQ(r.first, 0x2A);
+        EXPECT_EQ(r.second, datetime2);
+    }
+    ASSERT_EQ(sc.completed, 2);
+    ASSERT_EQ(sc.fields.size(), 3);
+    const std::vector<tdsl::uint8_t> data{'w', 'x', 'y', 'z'};
+    EXPECT_EQ(sc.fields [2], data + data);
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+
+    /**
+     * RETURNVALUE token (TDS 7.2+) carrying the statement @p handle
+     * of sp_prepexec, followed by a DONEPROC token
+     */
+    std::vector<tdsl::uint8_t> make_handle_returnvalue(tdsl::int32_t handle) {
+        std::vector<tdsl::uint8_t> msg{// RETURNVALUE, param ordinal
+                                       0xAC, 0x00, 0x00,
+                                       // param name (@h)
+                                       0x02, '@', 0x00, 'h', 0x00,
+                                       // status (output), user type, flags
+                                       0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                       // type (INTNTYPE), max length, length
+                                       0x26, 0x04, 0x04};
+        put_u32(msg, static_cast<tdsl::uint32_t>(handle));
+        // DONEPROC (final), row count (64-bit)
+        const std::vector<tdsl::uint8_t> doneproc{0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                                  0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        return msg + doneproc;
+    }
+
+    // ALL_HEADERS size (TDS 7.2+)
+    constexpr tdsl::size_t k_all_headers_size = 22;
+} // namespace
+
+TEST_F(tdsl_command_ctx_ut_fixture, prepexec_caches_handle) {
+    negotiate_tds74();
+
+    tdsl::detail::sql_parameter_int p0            = 5;
+    tdsl::detail::sql_parameter_binding params [] = {p0};
+
+    // The first execution prepares the statement
+    command_ctx.execute_rpc(tdsl::string_view{"SELECT * FROM TEST WHERE a=@p0"}, params,
+                            tdsl::detail::e_rpc_mode::prepexec);
+    const std::vector<tdsl::uint8_t> prepexec{// Procedure name length, sp_prepexec(13), flags
+                                              0xFF, 0xFF, 0x0D, 0x00, 0x00, 0x00,
+                                              // @handle: status (output), INTNTYPE(4), NULL
+                                              0x00, 0x01, 0x26, 0x04, 0x00,
+                                              // @params: name length, status, NVARCHAR
+                                              0x00, 0x00, 0xE7};
+    ASSERT_GT(tds_ctx.send_buffer.size(), k_all_headers_size + prepexec.size());
+    EXPECT_TRUE(std::equal(prepexec.begin(), prepexec.end(),
+                           tds_ctx.send_buffer.begin() + k_all_headers_size));
+    EXPECT_EQ(tds_ctx.prepared_statements.size(), 0);
+
+    // The server returns the handle, split over the packets
+    feed_message_in_pieces(make_handle_returnvalue(0x2A), 3);
+    EXPECT_EQ(tds_ctx.prepared_statements.size(), 1);
+
+    // The next execution uses the handle
+    tds_ctx.send_buffer.clear();
+    command_ctx.execute_rpc(tdsl::string_view{"SELECT * FROM TEST WHERE a=@p0"}, params,
+                            tdsl::detail::e_rpc_mode::prepexec);
+    const std::vector<tdsl::uint8_t> execute{// Procedure name length, sp_execute(12), flags
+                                             0xFF, 0xFF, 0x0C, 0x00, 0x00, 0x00,
+                                             // @handle: INTNTYPE(4), 0x2A
+                                             0x00, 0x00, 0x26, 0x04, 0x04, 0x2A, 0x00, 0x00, 0x00,
+                                             // @p0: INTNTYPE(4), 5
+                                             0x00, 0x00, 0x26, 0x04, 0x04, 0x05, 0x00, 0x00, 0x00};
+    ASSERT_EQ(tds_ctx.send_buffer.size(), k_all_headers_size + execute.size());
+    EXPECT_TRUE(std::equal(execute.begin(), execute.end(),
+                           tds_ctx.send_buffer.begin() + k_all_headers_size));
+
+    // A different parameter declaration is a different statement
+    tdsl::detail::sql_parameter_bigint p1          = 5;
+    tdsl::detail::sql_parameter_binding params2 [] = {p1};
+    tds_ctx.send_buffer.clear();
+    command_ctx.execute_rpc(tdsl::string_view{"SELECT * FROM TEST WHERE a=@p0"}, params2,
+                            tdsl::detail::e_rpc_mode::prepexec);
+    EXPECT_EQ(tds_ctx.send_buffer [k_all_headers_size + 2], 0x0D);
+
+    // The handles are released with the session
+    negotiate_tds74();
+    EXPECT_EQ(tds_ctx.prepared_statements.size(), 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, prepexec_unprepares_evicted_handle) {
+    negotiate_tds74();
+
+    constexpr tdsl::int32_t k_capacity = TDSL_PREPARED_STATEMENT_CACHE_CAPACITY;
+    char query []                      = "SELECT ?";
+    // Fill the cache, then prepare one more statement
+    for (tdsl::int32_t i = 0; i <= k_capacity; i++) {
+        query [7] = static_cast<char>('A' + i);
+        command_ctx.execute_rpc(tdsl::string_view{query}, {}, tdsl::detail::e_rpc_mode::prepexec);
+        feed_message(make_handle_returnvalue(100 + i));
+    }
+    EXPECT_EQ(tds_ctx.prepared_statements.size(), k_capacity);
+
+    // The least recently used handle (100) is unprepared in
+    // the same batch, before the next statement
+    tds_ctx.send_buffer.clear();
+    command_ctx.execute_rpc(tdsl::string_view{"SELECT 1"}, {},
+                            tdsl::detail::e_rpc_mode::executesql);
+    const std::vector<tdsl::uint8_t> unprepare{// Procedure name length, sp_unprepare(15), flags
+                                               0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00,
+                                               // @handle: INTNTYPE(4), 100
+                                               0x00, 0x00, 0x26, 0x04, 0x04, 0x64, 0x00, 0x00,
+                                               0x00,
+                                               // Batch flag
+                                               0xFF,
+                                               // Procedure name length, sp_executesql(10)
+                                               0xFF, 0xFF, 0x0A, 0x00};
+    ASSERT_GT(tds_ctx.send_buffer.size(), k_all_headers_size + unprepare.size());
+    EXPECT_TRUE(std::equal(unprepare.begin(), unprepare.end(),
+                           tds_ctx.send_buffer.begin() + k_all_headers_size));
+    EXPECT_FALSE(tds_ctx.prepared_statements.has_unprepare_pending());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, statement_matches_runtime_parameters) {
+    tdsl::detail::sql_parameter_int p0            = -7;
+    tdsl::detail::sql_parameter_bigint p1         = 5;
+    tdsl::detail::sql_parameter_binding params [] = {p0, p1};
+    command_ctx.execute_rpc(tdsl::string_view{"SELECT * FROM TEST WHERE a=@p0 AND b=@p1"},
+                            params);
+    const std::vector<tdsl::uint8_t> runtime_bytes = tds_ctx.send_buffer;
+
+    // The compile-time declarations & TYPE_INFOs must be identical
+    tds_ctx.send_buffer.clear();
+    tdsl::detail::statement<tdsl::int32_t, tdsl::int64_t> stmt{-7, 5};
+    const auto result = command_ctx.execute_rpc(
+        tdsl::string_view{"SELECT * FROM TEST WHERE a=@p0 AND b=@p1"}, stmt);
+    ASSERT_TRUE(result);
+    EXPECT_THAT(tds_ctx.send_buffer, testing::ElementsAreArray(runtime_bytes));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, statement_string_parameters) {
+    tdsl::detail::statement<tdsl::wstring_view, tdsl::byte_view> stmt{
+        u"ab", tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>("\x01\x02"), 2}};
+    const auto result = command_ctx.execute_rpc(tdsl::string_view{"SELECT @p0, @p1"}, stmt);
+    ASSERT_TRUE(result);
+
+    tdsl::wstring_view vardecl{u"@p0 NVARCHAR(4000),@p1 VARBINARY(8000)"};
+    std::vector<tdsl::uint8_t> expected_tail{// Declaration length
+                                             static_cast<tdsl::uint8_t>(vardecl.size_bytes()),
+                                             0x00};
+    expected_tail.insert(expected_tail.end(), vardecl.rebind_cast<const tdsl::uint8_t>().begin(),
+                         vardecl.rebind_cast<const tdsl::uint8_t>().end());
+    const std::vector<tdsl::uint8_t> values{
+        // @p0: NVARCHAR(8000 bytes), collation, length, u"ab"
+        0x00, 0x00, 0xE7, 0x40, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 'a', 0x00, 'b',
+        0x00,
+        // @p1: BIGVARBINARY(8000), length, 0x01 0x02
+        0x00, 0x00, 0xA5, 0x40, 0x1F, 0x02, 0x00, 0x01, 0x02};
+    expected_tail.insert(expected_tail.end(), values.begin(), values.end());
+
+    ASSERT_GT(tds_ctx.send_buffer.size(), expected_tail.size());
+    EXPECT_TRUE(std::equal(expected_tail.begin(), expected_tail.end(),
+                           tds_ctx.send_buffer.end() - expected_tail.size()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, statement_value_too_long) {
+    std::vector<char> long_str(8001, 'x');
+    tdsl::detail::statement<tdsl::string_view> stmt{
+        tdsl::string_view{long_str.data(), static_cast<tdsl::uint32_t>(long_str.size())}};
+    const auto result = command_ctx.execute_rpc(tdsl::string_view{"SELECT @p0"}, stmt);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_rpc_error_code::invalid_parameter_length);
+    EXPECT_TRUE(tds_ctx.send_buffer.empty());
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+    /**
+     * DONEPROC/DONEINPROC (TDS 7.2+) token with @p status and @p row_count
+     */
+    std::vector<tdsl::uint8_t> make_done(tdsl::uint8_t type, tdsl::uint16_t status,
+                                         tdsl::uint32_t row_count) {
+        std::vector<tdsl::uint8_t> msg{type, static_cast<tdsl::uint8_t>(status & 0xFF),
+                                       static_cast<tdsl::uint8_t>(status >> 8), 0x00, 0x00};
+        put_u32(msg, row_count);
+        put_u32(msg, 0);
+        return msg;
+    }
+
+    constexpr tdsl::uint8_t k_doneproc   = 0xFE;
+    constexpr tdsl::uint8_t k_doneinproc = 0xFF;
+} // namespace
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_batch) {
+    negotiate_tds74();
+
+    uut_t::query_result results [2];
+    command_ctx.begin_rpc_batch(results);
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT 1"}));
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT 2"}));
+    const auto full = command_ctx.add_rpc(tdsl::string_view{"SELECT 3"});
+    ASSERT_FALSE(full);
+    EXPECT_EQ(full.error(), tdsl::detail::e_rpc_error_code::batch_full);
+
+    // One ALL_HEADERS, then the calls separated by the batch flag
+    constexpr tdsl::size_t k_call_size = 46;
+    ASSERT_EQ(tds_ctx.send_buffer.size(), k_all_headers_size + 2 * k_call_size + 1);
+    const std::vector<tdsl::uint8_t> separator{// Batch flag
+                                               0xFF,
+                                               // Procedure name length, sp_executesql(10)
+                                               0xFF, 0xFF, 0x0A, 0x00};
+    EXPECT_TRUE(std::equal(separator.begin(), separator.end(),
+                           tds_ctx.send_buffer.begin() + k_all_headers_size + k_call_size));
+
+    command_ctx.execute_rpc_batch();
+
+    // The first call affects 5 rows, the second one fails
+    feed_message_in_pieces(make_done(k_doneinproc, 0x11, 5) + make_done(k_doneproc, 0x01, 0) +
+                               make_done(k_doneinproc, 0x03, 0) + make_done(k_doneproc, 0x00, 0),
+                           5);
+    EXPECT_TRUE(results [0]);
+    EXPECT_EQ(results [0].affected_rows, 5);
+    EXPECT_FALSE(results [1]);
+    EXPECT_EQ(results [1].affected_rows, 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_batch_prepares_one_statement) {
+    negotiate_tds74();
+
+    uut_t::query_result results [2];
+    command_ctx.begin_rpc_batch(results);
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT 1"}, {},
+                                    tdsl::detail::e_rpc_mode::prepexec));
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT 2"}, {},
+                                    tdsl::detail::e_rpc_mode::prepexec));
+    // sp_prepexec(13)
+    EXPECT_EQ(tds_ctx.send_buffer [k_all_headers_size + 2], 0x0D);
+    // The second one is executed directly, sp_executesql(10)
+    const auto second = std::search_n(tds_ctx.send_buffer.begin() + k_all_headers_size + 6,
+                                      tds_ctx.send_buffer.end(), 3, 0xFF);
+    ASSERT_NE(second, tds_ctx.send_buffer.end());
+    EXPECT_EQ(*(second + 3), 0x0A);
+
+    command_ctx.execute_rpc_batch();
+    feed_message(make_handle_returnvalue(7) + make_done(k_doneproc, 0x00, 0));
+    EXPECT_EQ(tds_ctx.prepared_statements.size(), 1);
+    EXPECT_TRUE(results [0]);
+    EXPECT_TRUE(results [1]);
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+    struct bulk_row_source {
+        static bool produce(void * uptr, tdsl::span<tdsl::detail::sql_bulk_column> columns) {
+            auto & self = *static_cast<bulk_row_source *>(uptr);
+            if (self.produced == self.rows) {
+                return false;
+            }
+            // The first row is (7, N'ab'), the rest are NULL
+            const bool first  = (self.produced++ == 0);
+            columns [0].value = first ? tdsl::byte_view{self.a, sizeof(self.a)}
+                                      : tdsl::byte_view{};
+            columns [1].value = first ? self.b.rebind_cast<const tdsl::uint8_t>()
+                                      : tdsl::byte_view{};
+            return true;
+        }
+
+        tdsl::uint32_t rows       = {2};
+        tdsl::uint32_t produced   = {0};
+        const tdsl::uint8_t a [4] = {0x07, 0x00, 0x00, 0x00};
+        tdsl::wstring_view b      = u"ab";
+    };
+} // namespace
+
+TEST_F(tdsl_command_ctx_ut_fixture, bulk_load) {
+    negotiate_tds74();
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {"a", tdsl::detail::e_tds_data_type::INT4TYPE, 0, {}},
+        {"b", tdsl::detail::e_tds_data_type::NVARCHARTYPE, 10, {}}};
+
+    // Small enough to send the message in pieces
+    tds_ctx.send_buffer_capacity = 16;
+    bulk_row_source src;
+    const auto result = command_ctx.execute_bulk_load(tdsl::string_view{"#t"}, columns,
+                                                      &bulk_row_source::produce, &src);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(src.produced, 2);
+    EXPECT_GT(tds_ctx.flush_count, 1);
+    EXPECT_LE(tds_ctx.send_buffer.size(), 16);
+    EXPECT_EQ(tds_ctx.ignored_message_count, 0);
+
+    const std::vector<tdsl::uint8_t> bulk_message{
+        // COLMETADATA, column count
+        0x81, 0x02, 0x00,
+        // a: user type, flags (nullable), INTNTYPE(4), name
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x01, 'a', 0x00,
+        // b: user type, flags (nullable), NVARCHARTYPE(20 bytes), collation, name
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xE7, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 'b', 0x00,
+        // ROW (7, N'ab')
+        0xD1, 0x04, 0x07, 0x00, 0x00, 0x00, 0x04, 0x00, 'a', 0x00, 'b', 0x00,
+        // ROW (NULL, NULL)
+        0xD1, 0x00, 0xFF, 0xFF,
+        // DONE
+        0xFD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    // The INSERT BULK statement, followed by the bulk load message
+    const auto sent = tds_ctx.flushed_buffer + tds_ctx.send_buffer;
+    tdsl::wstring_view insert_bulk{u"INSERT BULK #t (a INT,b NVARCHAR(10))"};
+    ASSERT_EQ(sent.size(), k_all_headers_size + insert_bulk.size_bytes() + bulk_message.size());
+    const auto insert_bulk_bytes = insert_bulk.rebind_cast<const tdsl::uint8_t>();
+    EXPECT_TRUE(std::equal(insert_bulk_bytes.begin(), insert_bulk_bytes.end(),
+                           sent.begin() + k_all_headers_size));
+    EXPECT_TRUE(std::equal(bulk_message.begin(), bulk_message.end(),
+                           sent.end() - bulk_message.size()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, bulk_load_invalid_value) {
+    tdsl::detail::sql_bulk_column columns [] = {
+        {"a", tdsl::detail::e_tds_data_type::INT4TYPE, 0, {}},
+        {"b", tdsl::detail::e_tds_data_type::NVARCHARTYPE, 1, {}}};
+
+    bulk_row_source src;
+    const auto result = command_ctx.execute_bulk_load(tdsl::string_view{"#t"}, columns,
+                                                      &bulk_row_source::produce, &src);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_bulk_load_error_code::invalid_value_length);
+    // The server is asked to discard the bulk load message
+    EXPECT_EQ(tds_ctx.ignored_message_count, 1);
+    // The message is ended right after the metadata: DONE (32-bit row count)
+    const std::vector<tdsl::uint8_t> done{0xFD, 0x00, 0x00, 0x00, 0x00,
+                                          0x00, 0x00, 0x00, 0x00};
+    ASSERT_GT(tds_ctx.send_buffer.size(), done.size());
+    EXPECT_TRUE(std::equal(done.begin(), done.end(), tds_ctx.send_buffer.end() - done.size()));
+    // (the name of the last column, u"b")
+    EXPECT_EQ(tds_ctx.send_buffer [tds_ctx.send_buffer.size() - done.size() - 2], 'b');
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, bulk_load_unsupported_column) {
+    tdsl::detail::sql_bulk_column columns [] = {
+        {"a", tdsl::detail::e_tds_data_type::DECIMALNTYPE, 0, {}}};
+
+    bulk_row_source src;
+    const auto result = command_ctx.execute_bulk_load(tdsl::string_view{"#t"}, columns,
+                                                      &bulk_row_source::produce, &src);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_bulk_load_error_code::unsupported_column_type);
+    EXPECT_TRUE(tds_ctx.send_buffer.empty());
+    EXPECT_EQ(src.produced, 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_tvp) {
+    negotiate_tds74();
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {{}, tdsl::detail::e_tds_data_type::INT4TYPE,     0,  {}},
+        {{}, tdsl::detail::e_tds_data_type::NVARCHARTYPE, 10, {}}
+    };
+
+    // Small enough to send the message in pieces
+    tds_ctx.send_buffer_capacity = 64;
+    bulk_row_source src;
+    tdsl::detail::sql_parameter_tvp tvp{"dbo.id_list", columns, &bulk_row_source::produce, &src};
+    tdsl::detail::sql_parameter_binding params [] = {tvp};
+    const auto result = command_ctx.execute_rpc(tdsl::string_view{"EXEC p @p0"}, params);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(src.produced, 2);
+    EXPECT_GT(tds_ctx.flush_count, 1);
+    EXPECT_FALSE(command_ctx.is_rpc_aborted());
+    EXPECT_EQ(tds_ctx.ignored_message_count, 0);
+
+    const auto sent = tds_ctx.flushed_buffer + tds_ctx.send_buffer;
+    tdsl::wstring_view decl{u"@p0 dbo.id_list READONLY"};
+    const auto decl_bytes = decl.rebind_cast<const tdsl::uint8_t>();
+    EXPECT_NE(std::search(sent.begin(), sent.end(), decl_bytes.begin(), decl_bytes.end()),
+              sent.end());
+
+    const std::vector<tdsl::uint8_t> tvp_value{
+        // name length, status flags, TVPTYPE, db name
+        0x00, 0x00, 0xF3, 0x00,
+        // schema (dbo), type name (id_list)
+        0x03, 'd', 0x00, 'b', 0x00, 'o', 0x00, 0x07, 'i', 0x00, 'd', 0x00, '_', 0x00, 'l', 0x00,
+        'i', 0x00, 's', 0x00, 't', 0x00,
+        // column count
+        0x02, 0x00,
+        // user type, flags (nullable), INTNTYPE(4), name
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x26, 0x04, 0x00,
+        // user type, flags (nullable), NVARCHARTYPE(20 bytes), collation, name
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xE7, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // TVP_END
+        0x00,
+        // TVP_ROW (7, N'ab')
+        0x01, 0x04, 0x07, 0x00, 0x00, 0x00, 0x04, 0x00, 'a', 0x00, 'b', 0x00,
+        // TVP_ROW (NULL, NULL)
+        0x01, 0x00, 0xFF, 0xFF,
+        // TVP_END
+        0x00};
+    ASSERT_GT(sent.size(), tvp_value.size());
+    EXPECT_TRUE(std::equal(tvp_value.begin(), tvp_value.end(), sent.end() - tvp_value.size()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_tvp_invalid_value) {
+    negotiate_tds74();
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {{}, tdsl::detail::e_tds_data_type::INT4TYPE,     0, {}},
+        {{}, tdsl::detail::e_tds_data_type::NVARCHARTYPE, 1, {}}
+    };
+
+    bulk_row_source src;
+    tdsl::detail::sql_parameter_tvp tvp{"id_list", columns, &bulk_row_source::produce, &src};
+    tdsl::detail::sql_parameter_binding params [] = {tvp};
+    const auto result = command_ctx.execute_rpc(tdsl::string_view{"EXEC p @p0"}, params);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_rpc_error_code::invalid_parameter_length);
+    // The server is asked to discard the RPC message
+    EXPECT_TRUE(command_ctx.is_rpc_aborted());
+    EXPECT_EQ(tds_ctx.ignored_message_count, 1);
+    // The rows are ended right after the metadata: the name of the
+    // last column (empty), TVP_END, TVP_END
+    const std::vector<tdsl::uint8_t> end{0x00, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_GT(tds_ctx.send_buffer.size(), end.size());
+    EXPECT_TRUE(std::equal(end.begin(), end.end(), tds_ctx.send_buffer.end() - end.size()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_batch_tvp_invalid_value) {
+    negotiate_tds74();
+
+    tdsl::detail::sql_bulk_column columns [] = {
+        {{}, tdsl::detail::e_tds_data_type::INT4TYPE,     0, {}},
+        {{}, tdsl::detail::e_tds_data_type::NVARCHARTYPE, 1, {}}
+    };
+
+    bulk_row_source src;
+    tdsl::detail::sql_parameter_tvp tvp{"id_list", columns, &bulk_row_source::produce, &src};
+    tdsl::detail::sql_parameter_binding params [] = {tvp};
+    uut_t::query_result results [2];
+    command_ctx.begin_rpc_batch(results);
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"SELECT 1"}));
+    ASSERT_TRUE(command_ctx.add_rpc(tdsl::string_view{"EXEC p @p0"}, params));
+    EXPECT_TRUE(command_ctx.is_rpc_aborted());
+
+    // None of the calls is run
+    const auto result = command_ctx.execute_rpc_batch();
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_rpc_error_code::invalid_parameter_length);
+    EXPECT_EQ(tds_ctx.ignored_message_count, 1);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_command_ctx_ut_fixture, rpc_tvp_unsupported) {
+    tdsl::detail::sql_bulk_column columns [] = {
+        {{}, tdsl::detail::e_tds_data_type::INT4TYPE, 0, {}}
+    };
+
+    bulk_row_source src;
+    tdsl::detail::sql_parameter_tvp tvp{"id_list", columns, &bulk_row_source::produce, &src};
+    tdsl::detail::sql_parameter_binding params [] = {tvp};
+    // TVPs require TDS 7.3
+    const auto result = command_ctx.execute_rpc(tdsl::string_view{"EXEC p @p0"}, params);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), tdsl::detail::e_rpc_error_code::unsupported_parameter_type);
+    EXPECT_TRUE(tds_ctx.send_buffer.empty());
+    EXPECT_EQ(src.produced, 0);
+}
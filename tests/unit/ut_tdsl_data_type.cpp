@@ -54,6 +54,11 @@ struct dtype_var_u32_len_fixture : public dtype_fixture,
 
 // --------------------------------------------------------------------------------
 
+struct dtype_var_scale_fixture : public dtype_fixture,
+                                 public testing::WithParamInterface<std::pair<dtype, bool>> {};
+
+// --------------------------------------------------------------------------------
+
 struct dtype_str_fixture : public dtype_fixture,
                            public testing::WithParamInterface<std::pair<dtype, const char *>> {};
 
@@ -138,6 +143,22 @@ TEST_P(dtype_var_u32_len_fixture, props) {
     EXPECT_FALSE(prop.flags.zero_represents_null);
 }
 
+TEST_P(dtype_var_scale_fixture, props) {
+    const auto & prop = tdsl::detail::get_data_type_props(std::get<0>(GetParam()));
+    EXPECT_EQ(0, prop.length.variable.length_size);
+    EXPECT_EQ(std::get<0>(GetParam()), prop.corresponding_varsize_type);
+    EXPECT_EQ(std::get<1>(GetParam()), prop.flags.has_scale);
+    ASSERT_EQ(stype::var_scale, prop.size_type);
+    EXPECT_TRUE(prop.is_variable_size());
+    EXPECT_TRUE(prop.flags.zero_represents_null);
+    EXPECT_FALSE(prop.flags.has_precision);
+    EXPECT_FALSE(prop.flags.has_collation);
+    EXPECT_FALSE(prop.flags.has_table_name);
+    EXPECT_FALSE(prop.flags.has_textptr);
+    EXPECT_FALSE(prop.flags.maxlen_represents_null);
+    EXPECT_EQ(std::get<1>(GetParam()) ? 2 : 1, prop.min_colmetadata_size());
+}
+
 // --------------------------------------------------------------------------------
 TEST_P(dtype_str_fixture, to_str) {
     const auto & str = tdsl::detail::data_type_to_str(std::get<0>(GetParam()));
@@ -192,6 +213,14 @@ INSTANTIATE_TEST_SUITE_P(cf, dtype_var_u32_len_fixture,
 
 // --------------------------------------------------------------------------------
 
+INSTANTIATE_TEST_SUITE_P(cf, dtype_var_scale_fixture,
+                         testing::Values(std::make_pair(dtype::DATENTYPE, false),
+                                         std::make_pair(dtype::TIMENTYPE, true),
+                                         std::make_pair(dtype::DATETIME2NTYPE, true),
+                                         std::make_pair(dtype::DATETIMEOFFSETNTYPE, true)));
+
+// --------------------------------------------------------------------------------
+
 INSTANTIATE_TEST_SUITE_P(
     tostr, dtype_str_fixture,
     testing::Values(std::make_pair(dtype::NULLTYPE, "NULLTYPE(0x1)"),
@@ -207,6 +236,10 @@ INSTANTIATE_TEST_SUITE_P(
                     std::make_pair(dtype::MONEY4TYPE, "MONEY4TYPE(0x7A)"),
                     std::make_pair(dtype::INT8TYPE, "INT8TYPE(0x7F)"),
                     std::make_pair(dtype::GUIDTYPE, "GUIDTYPE(0x24)"),
+                    std::make_pair(dtype::DATENTYPE, "DATENTYPE(0x28)"),
+                    std::make_pair(dtype::TIMENTYPE, "TIMENTYPE(0x29)"),
+                    std::make_pair(dtype::DATETIME2NTYPE, "DATETIME2NTYPE(0x2A)"),
+                    std::make_pair(dtype::DATETIMEOFFSETNTYPE, "DATETIMEOFFSETNTYPE(0x2B)"),
                     std::make_pair(dtype::INTNTYPE, "INTNTYPE(0x26)"),
                     std::make_pair(dtype::DECIMALTYPE, "DECIMALTYPE(0x37)"),
                     std::make_pair(dtype::NUMERICTYPE, "NUMERICTYPE(0x3F)"),
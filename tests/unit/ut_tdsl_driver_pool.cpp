@@ -0,0 +1,290 @@
+/**
+ * _________________________________________________
+ * Unit tests for tdsl_driver_pool
+ *
+ * @file   ut_tdsl_driver_pool.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * _________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_driver_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+    /**
+     * Stand-in for tdsl_driver, counting the calls made by the pool
+     */
+    struct fake_driver {
+        enum class e_driver_error_code
+        {
+            success,
+            connection_failed,
+            login_failed
+        };
+
+        struct connection_parameters {
+            // Connection attempts fail while this is set
+            std::atomic<bool> * fail;
+        };
+
+        using sql_command_row_callback = void (*)(void *, const tdsl::tds_colmetadata_token &,
+                                                  const tdsl::tdsl_row &);
+
+        struct query_result {
+            bool ok = {true};
+
+            explicit operator bool() const noexcept {
+                return ok;
+            }
+        };
+
+        e_driver_error_code connect(const connection_parameters & p) {
+            connects++;
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            if (p.fail && p.fail->load()) {
+                return e_driver_error_code::connection_failed;
+            }
+            connected = {true};
+            return e_driver_error_code::success;
+        }
+
+        void disconnect() {
+            disconnects++;
+            connected = {false};
+        }
+
+        void reset_connection(bool keep_transaction = false) {
+            (void) keep_transaction;
+            resets++;
+        }
+
+        query_result execute_query(tdsl::string_view, sql_command_row_callback, void * uptr) {
+            pings++;
+            if (connected && healthy) {
+                // The row is not inspected by the pool
+                ++*static_cast<tdsl::uint32_t *>(uptr);
+            }
+            return query_result{};
+        }
+
+        bool connected  = {false};
+        bool healthy    = {true};
+        int connects    = {0};
+        int disconnects = {0};
+        int pings       = {0};
+        int resets      = {0};
+    };
+
+    using uut_t = tdsl::detail::tdsl_driver_pool<fake_driver>;
+
+    struct driver_pool_fixture : public ::testing::Test {
+        uut_t::pool_options options() const {
+            uut_t::pool_options o{};
+            o.max_connections    = 4;
+            o.min_connections    = 2;
+            o.idle_timeout       = std::chrono::milliseconds{60000};
+            o.health_check_after = std::chrono::milliseconds{60000};
+            o.acquire_timeout    = std::chrono::milliseconds{50};
+            return o;
+        }
+
+        std::atomic<bool> fail{false};
+        fake_driver::connection_parameters params{&fail};
+    };
+
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, warm_up_connects_in_parallel) {
+    auto o            = options();
+    o.min_connections = 4;
+    uut_t uut{o, params};
+
+    const auto begin = std::chrono::steady_clock::now();
+    ASSERT_EQ(4, uut.warm_up());
+    // Each connect takes 50 ms; sequential warm-up would take 200 ms
+    ASSERT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds{150});
+    ASSERT_EQ(4, uut.idle_connections());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, acquire_reuses_connection) {
+    uut_t uut{options(), params};
+    fake_driver * first = {nullptr};
+    {
+        auto l = uut.acquire();
+        ASSERT_TRUE(l);
+        ASSERT_TRUE(l->connected);
+        first = &*l;
+    }
+    ASSERT_EQ(1, uut.idle_connections());
+    {
+        auto l = uut.acquire();
+        ASSERT_TRUE(l);
+        ASSERT_EQ(first, &*l);
+        ASSERT_EQ(1, l->connects);
+        // The session of the previous lease is reset
+        ASSERT_EQ(1, l->resets);
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, reset_on_reuse_disabled) {
+    auto o           = options();
+    o.reset_on_reuse = false;
+    uut_t uut{o, params};
+    { auto l = uut.acquire(); }
+    auto l = uut.acquire();
+    ASSERT_TRUE(l);
+    ASSERT_EQ(0, l->resets);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, acquire_timeout) {
+    auto o            = options();
+    o.max_connections = 1;
+    uut_t uut{o, params};
+
+    auto l1 = uut.acquire();
+    ASSERT_TRUE(l1);
+    auto l2 = uut.acquire(std::chrono::milliseconds{10});
+    ASSERT_FALSE(l2);
+    ASSERT_EQ(uut_t::e_pool_error_code::timeout, l2.error());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, acquire_waits_for_release) {
+    auto o            = options();
+    o.max_connections = 1;
+    uut_t uut{o, params};
+
+    auto l1 = uut.acquire();
+    ASSERT_TRUE(l1);
+    std::thread t{[&l1] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        l1.release();
+    }};
+    auto l2 = uut.acquire(std::chrono::milliseconds{1000});
+    t.join();
+    ASSERT_TRUE(l2);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, connection_failed) {
+    uut_t uut{options(), params};
+    fail   = true;
+    auto l = uut.acquire();
+    ASSERT_FALSE(l);
+    ASSERT_EQ(uut_t::e_pool_error_code::connection_failed, l.error());
+    ASSERT_EQ(0, uut.open_connections());
+
+    fail = false;
+    ASSERT_TRUE(uut.acquire());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, invalidated_lease_is_disconnected) {
+    uut_t uut{options(), params};
+    fake_driver * d = {nullptr};
+    {
+        auto l = uut.acquire();
+        ASSERT_TRUE(l);
+        d = &*l;
+        l.invalidate();
+    }
+    ASSERT_EQ(1, d->disconnects);
+    ASSERT_EQ(0, uut.open_connections());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, health_check_reconnects) {
+    auto o               = options();
+    o.health_check_after = std::chrono::milliseconds{0};
+    uut_t uut{o, params};
+    {
+        auto l = uut.acquire();
+        ASSERT_TRUE(l);
+        l->healthy = false;
+    }
+    auto l = uut.acquire();
+    ASSERT_TRUE(l);
+    ASSERT_EQ(1, l->pings);
+    ASSERT_EQ(1, l->disconnects);
+    ASSERT_EQ(2, l->connects);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, custom_health_check) {
+    auto o               = options();
+    o.health_check_after = std::chrono::milliseconds{0};
+    uut_t uut{o, params};
+    int checks = {0};
+    uut.set_health_check([&checks](fake_driver &) {
+        checks++;
+        return true;
+    });
+    { auto l = uut.acquire(); }
+    auto l = uut.acquire();
+    ASSERT_TRUE(l);
+    ASSERT_EQ(1, checks);
+    ASSERT_EQ(0, l->pings);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, idle_eviction_keeps_min_connections) {
+    auto o         = options();
+    o.idle_timeout = std::chrono::milliseconds{0};
+    uut_t uut{o, params};
+    {
+        auto l1 = uut.acquire();
+        auto l2 = uut.acquire();
+        auto l3 = uut.acquire();
+        ASSERT_TRUE(l1 && l2 && l3);
+        ASSERT_EQ(3, uut.open_connections());
+    }
+    // Returning the leases evicts the connections above min_connections
+    ASSERT_EQ(2, uut.open_connections());
+    ASSERT_EQ(0, uut.evict_idle());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(driver_pool_fixture, close_wakes_waiters) {
+    auto o            = options();
+    o.max_connections = 1;
+    uut_t uut{o, params};
+
+    auto l1 = uut.acquire();
+    ASSERT_TRUE(l1);
+    std::thread t{[&uut] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        uut.close();
+    }};
+    auto l2 = uut.acquire(std::chrono::milliseconds{1000});
+    t.join();
+    ASSERT_FALSE(l2);
+    ASSERT_EQ(uut_t::e_pool_error_code::pool_closed, l2.error());
+
+    // Leases returned after close are disconnected
+    fake_driver * d = &*l1;
+    l1.release();
+    ASSERT_EQ(1, d->disconnects);
+}
@@ -19,7 +19,9 @@
 
 #include <vector>
 #include <cstring>
+#include <cstdlib>
 #include <array>
+#include <algorithm>
 
 namespace {
 
@@ -49,6 +51,10 @@ namespace {
             return buffer.size();
         }
 
+        inline tdsl::byte_view do_get_written_bytes(tdsl::size_t offset) noexcept {
+            return tdsl::byte_view{buffer.data() + offset, buffer.size() - offset};
+        }
+
         inline void do_send(void) noexcept {}
 
         inline void do_receive_tds_pdu() {}
@@ -57,12 +63,25 @@ namespace {
 
         inline void set_tds_packet_size(tdsl::uint16_t) {}
 
-        void register_packet_data_callback(
-            tdsl::uint32_t (*)(void *, tdsl::detail::e_tds_message_type,
-                               tdsl::binary_reader<tdsl::endian::little> &),
-            void *) {}
+        using packet_data_cb_t = tdsl::uint32_t (*)(void *, tdsl::detail::e_tds_message_type,
+                                                    tdsl::binary_reader<tdsl::endian::little> &);
+
+        void register_packet_data_callback(packet_data_cb_t cb, void * uptr) {
+            packet_data_cb      = cb;
+            packet_data_cb_uptr = uptr;
+        }
+
+        /**
+         * Mimic receiving a message @p msg from the server
+         */
+        tdsl::uint32_t feed(tdsl::detail::e_tds_message_type mtype, tdsl::byte_view msg) {
+            tdsl::binary_reader<tdsl::endian::little> rdr{msg};
+            return packet_data_cb(packet_data_cb_uptr, mtype, rdr);
+        }
 
         std::vector<uint8_t> buffer;
+        packet_data_cb_t packet_data_cb = {nullptr};
+        void * packet_data_cb_uptr      = {nullptr};
     };
 } // namespace
 
@@ -130,6 +149,8 @@ TEST_F(tdsl_login_ctx_ut_fixture, test_jaxview) {
     params.client_pid             = 123;
     params.client_program_version = 7;
     params.packet_size            = 0;
+    // Captured from a TDS 7.1 client
+    params.tds_version            = tdsl::detail::e_tds_version::sql_server_2000_sp1;
 
     constexpr std::array<tdsl::uint8_t, 188> expected_packet_bytes{
         0xbc, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x71, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00,
@@ -170,6 +191,8 @@ TEST_F(tdsl_login_ctx_ut_fixture, test_mdac) {
     params.client_pid             = 1712;
     params.client_program_version = 0x07000000;
     params.packet_size            = 0;
+    // Captured from a TDS 7.1 client
+    params.tds_version            = tdsl::detail::e_tds_version::sql_server_2000_sp1;
     params.collation = static_cast<tdsl::uint32_t>(tdsl::detail::e_ms_lang_code_id::en_gb_english);
     params.client_id [0] = 0x00;
     params.client_id [1] = 0x0c;
@@ -204,4 +227,178 @@ TEST_F(tdsl_login_ctx_ut_fixture, test_mdac) {
     ASSERT_EQ(sizeof(expected_packet_bytes), tds_ctx.buffer.size());
     ASSERT_EQ(sizeof(expected_packet_bytes), tds_ctx.buffer.size());
     ASSERT_THAT(tds_ctx.buffer, testing::ElementsAreArray(expected_packet_bytes));
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_login_ctx_ut_fixture, login_packet_cache) {
+    uut_t::login_parameters params;
+    params.server_name = "localhost";
+    params.db_name     = "test";
+    params.user_name   = "sa";
+    params.password    = "test";
+
+    uut_t::login_packet_cache cache;
+    ASSERT_FALSE(cache.matches(params));
+
+    // Failed login must not leave a cached message behind
+    login.do_login(params, cache);
+    ASSERT_FALSE(cache.matches(params));
+
+    tds_ctx.buffer.clear();
+    // Mimic the LOGINACK token
+    tds_ctx.callbacks.loginack(tdsl::tds_login_ack_token{});
+    ASSERT_EQ(uut_t::e_login_status::success, login.do_login(params, cache));
+    ASSERT_TRUE(cache.matches(params));
+    const std::vector<tdsl::uint8_t> encoded{tds_ctx.buffer};
+    ASSERT_THAT(encoded, testing::ElementsAreArray(cache.bytes().data(), cache.bytes().size()));
+
+    // Same parameters, the message is copied from the cache
+    tds_ctx.buffer.clear();
+    login.do_login(params, cache);
+    ASSERT_EQ(encoded, tds_ctx.buffer);
+
+    // Different parameters, the message is encoded again
+    params.password = "tesu";
+    ASSERT_FALSE(cache.matches(params));
+    tds_ctx.buffer.clear();
+    login.do_login(params, cache);
+    ASSERT_TRUE(cache.matches(params));
+    ASSERT_EQ(encoded.size(), tds_ctx.buffer.size());
+    ASSERT_NE(encoded, tds_ctx.buffer);
+
+    // The credentials are compared, not only the fingerprint
+    params.user_name = "sb";
+    ASSERT_FALSE(cache.matches(params));
+    params.user_name = "sa";
+    params.db_name   = "tesu";
+    ASSERT_FALSE(cache.matches(params));
+    params.db_name = "test";
+    ASSERT_TRUE(cache.matches(params));
+}
+
+// --------------------------------------------------------------------------------
+
+namespace {
+
+    // Sizes of the live allocations, and whether every freed block was zeroed
+    std::vector<std::pair<void *, unsigned long>> live_allocations{};
+    bool freed_only_zeroed_blocks = {true};
+
+    void * recording_malloc(unsigned long n) {
+        void * p = std::malloc(n);
+        live_allocations.emplace_back(p, n);
+        return p;
+    }
+
+    void checking_free(void * p) {
+        for (auto it = live_allocations.begin(); it != live_allocations.end(); ++it) {
+            if (it->first == p) {
+                const auto * bytes = static_cast<const tdsl::uint8_t *>(p);
+                freed_only_zeroed_blocks &=
+                    std::all_of(bytes, bytes + it->second, [](tdsl::uint8_t b) {
+                        return b == 0;
+                    });
+                live_allocations.erase(it);
+                break;
+            }
+        }
+        std::free(p);
+    }
+} // namespace
+
+TEST_F(tdsl_login_ctx_ut_fixture, login_packet_cache_wipes_credentials) {
+    uut_t::login_parameters params;
+    params.server_name = "localhost";
+    params.db_name     = "test";
+    params.user_name   = "sa";
+    params.password    = "test";
+
+    const auto mf = tdsl::tdslite_malloc_free();
+    tdsl::tdslite_malloc_free(&recording_malloc, &checking_free);
+    {
+        uut_t::login_packet_cache cache;
+        cache.store(params, tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>("LOGIN7"), 6});
+        ASSERT_TRUE(cache.matches(params));
+        cache.clear();
+        ASSERT_TRUE(freed_only_zeroed_blocks);
+
+        cache.store(params, tdsl::byte_view{reinterpret_cast<const tdsl::uint8_t *>("LOGIN7"), 6});
+        ASSERT_TRUE(cache.matches(params));
+    }
+    // Freed by the destructor
+    tdsl::tdslite_malloc_free(mf.a, mf.f);
+    ASSERT_TRUE(live_allocations.empty());
+    ASSERT_TRUE(freed_only_zeroed_blocks);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_login_ctx_ut_fixture, test_tds74_layout) {
+    uut_t::login_parameters params;
+    params.server_name = "localhost";
+    params.user_name   = "sa";
+    params.password    = "test";
+    ASSERT_EQ(tdsl::detail::e_tds_version::sql_server_2012, params.tds_version);
+
+    login.do_login(params);
+
+    // Header + offset/size table is 0x5E bytes long in TDS 7.2+
+    constexpr tdsl::uint16_t k_offset_table_end = 0x5E;
+    ASSERT_LT(k_offset_table_end, tds_ctx.buffer.size());
+    const auto & b = tds_ctx.buffer;
+    const auto u16 = [&b](tdsl::size_t off) -> tdsl::uint16_t {
+        return static_cast<tdsl::uint16_t>(b [off] | (b [off + 1] << 8));
+    };
+    const auto u32 = [&b](tdsl::size_t off) -> tdsl::uint32_t {
+        return static_cast<tdsl::uint32_t>(b [off] | (b [off + 1] << 8) | (b [off + 2] << 16) |
+                                           (b [off + 3] << 24));
+    };
+
+    EXPECT_EQ(b.size(), u32(0));                // length
+    EXPECT_EQ(0x74000004_tdsu32, u32(4));       // TDS version (7.4)
+    EXPECT_EQ(k_offset_table_end, u16(36));     // ibHostName
+    EXPECT_EQ(0, u16(38));                      // cchHostName
+    EXPECT_EQ(k_offset_table_end, u16(40));     // ibUserName
+    EXPECT_EQ(2, u16(42));                      // cchUserName
+    // ibChangePassword & cchChangePassword
+    EXPECT_EQ(b.size(), u16(86));
+    EXPECT_EQ(0, u16(88));
+    // cbSSPILong
+    EXPECT_EQ(0_tdsu32, u32(90));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_login_ctx_ut_fixture, prelogin) {
+    login.prepare_prelogin();
+
+    constexpr std::array<tdsl::uint8_t, 39> expected_message_bytes{
+        0x00, 0x00, 0x1A, 0x00, 0x06, 0x01, 0x00, 0x20, 0x00, 0x01, 0x02, 0x00, 0x21,
+        0x00, 0x01, 0x03, 0x00, 0x22, 0x00, 0x04, 0x04, 0x00, 0x26, 0x00, 0x01, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_THAT(tds_ctx.buffer, testing::ElementsAreArray(expected_message_bytes));
+
+    // No response yet
+    ASSERT_EQ(uut_t::e_login_status::failure, login.prelogin_status());
+
+    // VERSION, ENCRYPTION (not supported), TERMINATOR
+    constexpr tdsl::uint8_t response [] = {0x00, 0x00, 0x0B, 0x00, 0x06, 0x01, 0x00, 0x11,
+                                           0x00, 0x01, 0xFF, 0x0F, 0x00, 0x07, 0xD0, 0x00,
+                                           0x00, 0x02};
+    tds_ctx.feed(tdsl::detail::e_tds_message_type::tabular_result, tdsl::byte_view{response});
+    ASSERT_EQ(uut_t::e_login_status::success, login.prelogin_status());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST_F(tdsl_login_ctx_ut_fixture, prelogin_encryption_required) {
+    login.prepare_prelogin();
+
+    // VERSION, ENCRYPTION (required), TERMINATOR
+    constexpr tdsl::uint8_t response [] = {0x00, 0x00, 0x0B, 0x00, 0x06, 0x01, 0x00, 0x11,
+                                           0x00, 0x01, 0xFF, 0x0F, 0x00, 0x07, 0xD0, 0x00,
+                                           0x00, 0x03};
+    tds_ctx.feed(tdsl::detail::e_tds_message_type::tabular_result, tdsl::byte_view{response});
+    ASSERT_EQ(uut_t::e_login_status::failure, login.prelogin_status());
+}
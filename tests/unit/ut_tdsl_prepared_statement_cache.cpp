@@ -0,0 +1,148 @@
+/**
+ * ____________________________________________________
+ * tdsl prepared statement cache unit tests
+ *
+ * @file   ut_tdsl_prepared_statement_cache.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_prepared_statement_cache.hpp>
+#include <tdslite/util/tdsl_string_view.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using cache_t    = tdsl::detail::prepared_statement_cache<2>;
+using stmt_key_t = tdsl::detail::statement_key;
+
+namespace {
+
+    /**
+     * Key writer for a statement without parameters
+     */
+    struct sql {
+        tdsl::string_view text;
+
+        template <typename Sink>
+        void operator()(Sink & sink) const noexcept {
+            sink.write(text);
+        }
+    };
+
+    stmt_key_t key_of(tdsl::string_view text) {
+        stmt_key_t key;
+        EXPECT_TRUE(key.assign(sql{text}));
+        return key;
+    }
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, find_inserted) {
+    cache_t cache;
+    tdsl::int32_t handle = {0};
+    EXPECT_FALSE(cache.find(sql{"s1"}, handle));
+    cache.insert(key_of("s1"), 10);
+    cache.insert(key_of("s2"), 20);
+    ASSERT_TRUE(cache.find(sql{"s1"}, handle));
+    EXPECT_EQ(handle, 10);
+    ASSERT_TRUE(cache.find(sql{"s2"}, handle));
+    EXPECT_EQ(handle, 20);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.has_unprepare_pending());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, evicts_least_recently_used) {
+    cache_t cache;
+    tdsl::int32_t handle = {0};
+    cache.insert(key_of("s1"), 10);
+    cache.insert(key_of("s2"), 20);
+    // 1 is used more recently than 2
+    ASSERT_TRUE(cache.find(sql{"s1"}, handle));
+    cache.insert(key_of("s3"), 30);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.find(sql{"s2"}, handle));
+    EXPECT_TRUE(cache.find(sql{"s1"}, handle));
+    EXPECT_TRUE(cache.find(sql{"s3"}, handle));
+    // The evicted handle must be released
+    ASSERT_TRUE(cache.has_unprepare_pending());
+    EXPECT_EQ(cache.take_unprepare_pending(), 20);
+    EXPECT_FALSE(cache.has_unprepare_pending());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, reinsert_replaces_handle) {
+    cache_t cache;
+    tdsl::int32_t handle = {0};
+    cache.insert(key_of("s1"), 10);
+    cache.insert(key_of("s1"), 11);
+    EXPECT_EQ(cache.size(), 1);
+    ASSERT_TRUE(cache.find(sql{"s1"}, handle));
+    EXPECT_EQ(handle, 11);
+    EXPECT_FALSE(cache.has_unprepare_pending());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, clear) {
+    cache_t cache;
+    tdsl::int32_t handle = {0};
+    cache.insert(key_of("s1"), 10);
+    cache.insert(key_of("s2"), 20);
+    cache.insert(key_of("s3"), 30);
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(sql{"s3"}, handle));
+    EXPECT_FALSE(cache.has_unprepare_pending());
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, disabled) {
+    tdsl::detail::prepared_statement_cache<0> cache;
+    tdsl::int32_t handle = {0};
+    cache.insert(key_of("s1"), 10);
+    EXPECT_FALSE(cache.find(sql{"s1"}, handle));
+    ASSERT_TRUE(cache.has_unprepare_pending());
+    EXPECT_EQ(cache.take_unprepare_pending(), 10);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, fingerprint) {
+    auto fingerprint = [](tdsl::string_view sv) {
+        tdsl::detail::fnv1a64_hasher h{};
+        h.mix_string(sv);
+        return h.value;
+    };
+    EXPECT_EQ(fingerprint("SELECT 1"), fingerprint("SELECT 1"));
+    EXPECT_NE(fingerprint("SELECT 1"), fingerprint("SELECT 2"));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(prepared_statement_cache, key_compares_text) {
+    const stmt_key_t key = key_of("SELECT 1");
+    EXPECT_TRUE(key.matches(sql{"SELECT 1"}, stmt_key_t::fingerprint_of(sql{"SELECT 1"})));
+    // Same fingerprint (i.e. a collision), different text
+    const auto fp = stmt_key_t::fingerprint_of(sql{"SELECT 1"});
+    EXPECT_FALSE(key.matches(sql{"SELECT 2"}, fp));
+    EXPECT_FALSE(key.matches(sql{"SELECT 1 "}, fp));
+    EXPECT_FALSE(key.matches(sql{"SELECT "}, fp));
+    EXPECT_FALSE(key.matches(sql{"SELECT 2"}, stmt_key_t::fingerprint_of(sql{"SELECT 2"})));
+
+    // The key is a copy, not a reference to the text
+    char text [] = "SELECT 3";
+    const stmt_key_t copied = key_of(tdsl::string_view{text});
+    text [7]           = '4';
+    EXPECT_TRUE(copied.matches(sql{"SELECT 3"}, stmt_key_t::fingerprint_of(sql{"SELECT 3"})));
+    EXPECT_TRUE(copied == key_of("SELECT 3"));
+    EXPECT_FALSE(copied == key_of("SELECT 4"));
+}
@@ -0,0 +1,186 @@
+/**
+ * ____________________________________________________
+ * tdsl row decode plan unit tests
+ *
+ * @file   ut_tdsl_row_decode_plan.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_row_decode_plan.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using dtype = tdsl::detail::e_tds_data_type;
+using step  = tdsl::detail::tds_column_decode_step;
+using plan  = tdsl::detail::tds_row_decode_plan;
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, fixed_size_step) {
+    const auto s = step::make(dtype::INT8TYPE);
+    EXPECT_EQ(s.length_prefix_size, 0);
+    EXPECT_EQ(s.fixed_size, 8);
+    EXPECT_FALSE(s.flags.has_textptr);
+    EXPECT_FALSE(s.flags.has_null_length);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, var_u8_step) {
+    const auto s = step::make(dtype::INTNTYPE);
+    EXPECT_EQ(s.length_prefix_size, 1);
+    EXPECT_TRUE(s.flags.has_null_length);
+    EXPECT_EQ(s.null_length, 0);
+
+    // Valid lengths for INTNTYPE
+    for (tdsl::uint32_t len = 0; len < 64; len++) {
+        EXPECT_EQ(s.is_valid_length(len),
+                  tdsl::detail::is_valid_variable_length_for_type(dtype::INTNTYPE, len))
+            << len;
+    }
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, var_u16_step) {
+    const auto s = step::make(dtype::NVARCHARTYPE);
+    EXPECT_EQ(s.length_prefix_size, 2);
+    EXPECT_TRUE(s.flags.has_null_length);
+    EXPECT_EQ(s.null_length, 0xFFFF);
+    // No length restrictions
+    EXPECT_EQ(s.valid_length_mask, 0);
+    EXPECT_TRUE(s.is_valid_length(4000));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, var_u32_step) {
+    const auto s = step::make(dtype::NTEXTTYPE);
+    EXPECT_EQ(s.length_prefix_size, 4);
+    EXPECT_TRUE(s.flags.has_textptr);
+    EXPECT_TRUE(s.flags.has_null_length);
+    EXPECT_EQ(s.null_length, 0xFFFFFFFF);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, build) {
+    tdsl::tds_column_info columns [3] = {};
+    columns [0].type                  = dtype::INT4TYPE;
+    columns [1].type                  = dtype::GUIDTYPE;
+    columns [2].type                  = dtype::BIGVARCHRTYPE;
+
+    plan p;
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}));
+    ASSERT_EQ(p.size(), 3);
+    EXPECT_EQ(p [0].fixed_size, 4);
+    EXPECT_TRUE(p [1].is_valid_length(16));
+    EXPECT_FALSE(p [1].is_valid_length(15));
+    EXPECT_EQ(p [2].length_prefix_size, 2);
+
+    plan moved{TDSL_MOVE(p)};
+    EXPECT_FALSE(p);
+    EXPECT_TRUE(moved);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, fixed_width) {
+    tdsl::tds_column_info columns [4] = {};
+    columns [0].type                  = dtype::INT4TYPE;
+    columns [1].type                  = dtype::FLT8TYPE;
+    columns [2].type                  = dtype::BITTYPE;
+    columns [3].type                  = dtype::DATETIMETYPE;
+
+    plan p;
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}));
+    ASSERT_TRUE(p.is_fixed_width);
+    EXPECT_EQ(p.fixed_row_size, 21);
+    EXPECT_EQ(p [0].fixed_offset, 0);
+    EXPECT_EQ(p [1].fixed_offset, 4);
+    EXPECT_EQ(p [2].fixed_offset, 12);
+    EXPECT_EQ(p [3].fixed_offset, 13);
+
+    // A single variable size column makes the row size variable
+    columns [2].type = dtype::BITNTYPE;
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}));
+    EXPECT_FALSE(p.is_fixed_width);
+    EXPECT_EQ(p.fixed_row_size, 0);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, var_scale_step) {
+    const auto s = step::make(dtype::DATETIME2NTYPE);
+    EXPECT_EQ(s.length_prefix_size, 1);
+    EXPECT_TRUE(s.flags.has_null_length);
+    EXPECT_EQ(s.null_length, 0);
+    EXPECT_TRUE(s.is_valid_length(6));
+    EXPECT_TRUE(s.is_valid_length(8));
+    EXPECT_FALSE(s.is_valid_length(9));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, plp) {
+    tdsl::tds_column_info columns [2] = {};
+    columns [0].type                  = dtype::NVARCHARTYPE;
+    columns [0].typeprops.u16l.length = 8000;
+    columns [1].type                  = dtype::BIGVARBINTYPE;
+    columns [1].typeprops.u16l.length = 0xFFFF;
+
+    plan p;
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}));
+    ASSERT_TRUE(p.has_plp);
+    EXPECT_FALSE(p [0].flags.is_plp);
+    EXPECT_TRUE(p [1].flags.is_plp);
+    EXPECT_EQ(p [1].length_prefix_size, 8);
+
+    // The buffer is grown on demand only
+    ASSERT_TRUE(p.reserve_plp_buffer(16));
+    const auto * buffer = p.plp_buffer;
+    ASSERT_TRUE(p.reserve_plp_buffer(8));
+    EXPECT_EQ(buffer, p.plp_buffer);
+    EXPECT_EQ(p.plp_buffer_size, 16);
+
+    plan moved{TDSL_MOVE(p)};
+    EXPECT_EQ(p.plp_buffer, nullptr);
+    EXPECT_EQ(moved.plp_buffer, buffer);
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(row_decode_plan, streamed) {
+    tdsl::tds_column_info columns [4] = {};
+    columns [0].type                  = dtype::INT4TYPE;
+    columns [1].type                  = dtype::IMAGETYPE;
+    columns [1].typeprops.u32l.length = 0x7FFFFFFF;
+    columns [2].type                  = dtype::NVARCHARTYPE;
+    columns [2].typeprops.u16l.length = 0xFFFF;
+    columns [3].type                  = dtype::BIGVARCHRTYPE;
+    columns [3].typeprops.u16l.length = 100;
+
+    plan p;
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}));
+    EXPECT_FALSE(p [1].flags.is_streamed);
+    EXPECT_FALSE(p [2].flags.is_streamed);
+    EXPECT_EQ(p.spill_buffer, nullptr);
+
+    ASSERT_TRUE(p.build(tdsl::span<tdsl::tds_column_info>{columns}, /*stream_large_fields=*/true));
+    EXPECT_FALSE(p [0].flags.is_streamed);
+    EXPECT_TRUE(p [1].flags.is_streamed);
+    EXPECT_TRUE(p [2].flags.is_streamed);
+    EXPECT_FALSE(p [3].flags.is_streamed);
+    // null bitmap (1) + INT (4) + VARCHAR(100)
+    ASSERT_NE(p.spill_buffer, nullptr);
+    EXPECT_EQ(p.spill_buffer_size, 105);
+
+    plan moved{TDSL_MOVE(p)};
+    EXPECT_EQ(p.spill_buffer, nullptr);
+    EXPECT_EQ(moved.spill_buffer_size, 105);
+}
@@ -0,0 +1,93 @@
+/**
+ * ____________________________________________________
+ * tdsl compile-time typed statement unit tests
+ *
+ * @file   ut_tdsl_statement.cpp
+ * @author mkg <me@mustafagilor.com>
+ * @date   16.10.2026
+ *
+ * SPDX-License-Identifier:    MIT
+ * ____________________________________________________
+ */
+
+#include <tdslite/detail/tdsl_statement.hpp>
+#include <tdslite/util/tdsl_byte_swap.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace {
+    template <typename... Params>
+    std::vector<tdsl::uint8_t> declaration_of() {
+        const auto decl = tdsl::detail::statement<Params...>::declaration();
+        return std::vector<tdsl::uint8_t>(decl.begin(), decl.end());
+    }
+
+    std::vector<tdsl::uint8_t> u16_bytes(tdsl::wstring_view sv) {
+        const auto bytes = sv.rebind_cast<const tdsl::uint8_t>();
+        return std::vector<tdsl::uint8_t>(bytes.begin(), bytes.end());
+    }
+
+    // Collects the written bytes
+    struct byte_collector {
+        template <typename T>
+        void write(T v) {
+            const auto p = reinterpret_cast<const tdsl::uint8_t *>(&v);
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+
+        template <typename T>
+        void write_le(T v) {
+            write(tdsl::native_to_le(v));
+        }
+
+        void write(tdsl::byte_view v) {
+            bytes.insert(bytes.end(), v.begin(), v.end());
+        }
+
+        std::vector<tdsl::uint8_t> bytes;
+    };
+} // namespace
+
+// --------------------------------------------------------------------------------
+
+TEST(statement, declaration) {
+    EXPECT_THAT((declaration_of<tdsl::int32_t, tdsl::wstring_view>()),
+                testing::ElementsAreArray(u16_bytes(u"@p0 INT,@p1 NVARCHAR(4000)")));
+    EXPECT_THAT(
+        (declaration_of<bool, tdsl::uint8_t, tdsl::int16_t, tdsl::int64_t, float,
+                        tdsl::string_view, tdsl::byte_view>()),
+        testing::ElementsAreArray(u16_bytes(u"@p0 BIT,@p1 TINYINT,@p2 SMALLINT,@p3 BIGINT,"
+                                            u"@p4 REAL,@p5 VARCHAR(8000),@p6 VARBINARY(8000)")));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(statement, declaration_multi_digit_index) {
+    using i32 = tdsl::int32_t;
+    const auto decl =
+        declaration_of<i32, i32, i32, i32, i32, i32, i32, i32, i32, i32, i32, bool>();
+    const auto tail = u16_bytes(u",@p10 INT,@p11 BIT");
+    ASSERT_GT(decl.size(), tail.size());
+    EXPECT_TRUE(std::equal(tail.begin(), tail.end(), decl.end() - tail.size()));
+}
+
+// --------------------------------------------------------------------------------
+
+TEST(statement, write_values) {
+    tdsl::detail::statement<bool, tdsl::int16_t, float, tdsl::string_view> stmt{
+        true, tdsl::int16_t{-2}, 1.0f, "hi"};
+    ASSERT_TRUE(stmt.is_valid());
+    byte_collector bc;
+    stmt.write_values(bc);
+    EXPECT_THAT(bc.bytes, testing::ElementsAre(
+                              // BITNTYPE(1), true
+                              0x00, 0x00, 0x68, 0x01, 0x01, 0x01,
+                              // INTNTYPE(2), -2
+                              0x00, 0x00, 0x26, 0x02, 0x02, 0xFE, 0xFF,
+                              // FLTNTYPE(4), 1.0
+                              0x00, 0x00, 0x6D, 0x04, 0x04, 0x00, 0x00, 0x80, 0x3F,
+                              // BIGVARCHRTYPE(8000), collation, length, "hi"
+                              0x00, 0x00, 0xA7, 0x40, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,
+                              0x02, 0x00, 'h', 'i'));
+}